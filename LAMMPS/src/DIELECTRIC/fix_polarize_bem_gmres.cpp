@@ -51,7 +51,9 @@
 #include "pair_lj_cut_coul_debye_dielectric.h"
 #include "pair_lj_cut_coul_long_dielectric.h"
 #include "pair_lj_cut_coul_msm_dielectric.h"
+#include "pair_lj_cut_coul_ps_dielectric.h"
 #include "pppm_dielectric.h"
+#include "ppps_dielectric.h"
 #include "random_park.h"
 #include "update.h"
 
@@ -258,6 +260,8 @@ void FixPolarizeBEMGMRES::setup(int /*vflag*/)
     efield_pair = (dynamic_cast<PairLJCutCoulDebyeDielectric *>(force->pair))->efield;
   else if (strcmp(force->pair_style, "lj/cut/coul/debye/dielectric/omp") == 0)
     efield_pair = (dynamic_cast<PairLJCutCoulDebyeDielectric *>(force->pair))->efield;
+  else if (strcmp(force->pair_style, "lj/cut/coul/ps/dielectric") == 0)
+    efield_pair = (dynamic_cast<PairLJCutCoulPsDielectric *>(force->pair))->efield;
   else if (strcmp(force->pair_style, "coul/long/dielectric") == 0)
     efield_pair = (dynamic_cast<PairCoulLongDielectric *>(force->pair))->efield;
   else if (strcmp(force->pair_style, "coul/cut/dielectric") == 0)
@@ -271,6 +275,8 @@ void FixPolarizeBEMGMRES::setup(int /*vflag*/)
     kspaceflag = 1;
     if (strcmp(force->kspace_style, "pppm/dielectric") == 0)
       efield_kspace = (dynamic_cast<PPPMDielectric *>(force->kspace))->efield;
+    else if (strcmp(force->kspace_style, "ppps/dielectric") == 0)
+      efield_kspace = (dynamic_cast<PPPSDielectric *>(force->kspace))->efield;
     else if (strcmp(force->kspace_style, "msm/dielectric") == 0)
       efield_kspace = (dynamic_cast<MSMDielectric *>(force->kspace))->efield;
     else
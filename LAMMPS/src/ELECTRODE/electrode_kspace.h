@@ -27,6 +27,14 @@ class ElectrodeKSpace {
   virtual void compute_vector_corr(double *, int, int, bool) = 0;
   virtual void compute_matrix(bigint *, double **, bool) = 0;
   virtual void compute_matrix_corr(bigint *, double **) = 0;
+
+  // real-space Coulomb kernel complementing the k-space part and the limit of
+  //   1/r minus that kernel at r = 0, i.e. erfc(g r)/r and 2g/sqrt(pi) for Ewald
+  virtual double real_space_kernel(double) = 0;
+  virtual double self_interaction() = 0;
+
+  // true if real_space_kernel() is erfc(g_ewald r)/r, which callers inline
+  virtual bool ewald_kernel() { return true; }
 };
 }    // namespace LAMMPS_NS
 
@@ -58,6 +58,7 @@ void ElectrodeMatrix::setup(const std::unordered_map<tagint, int> &tag_ids, clas
 
   electrode_kspace = dynamic_cast<ElectrodeKSpace *>(force->kspace);
   if (electrode_kspace == nullptr) error->all(FLERR, "KSpace does not implement ElectrodeKSpace");
+  ewald_kernel = electrode_kspace->ewald_kernel();
   g_ewald = force->kspace->g_ewald;
 
   tag_to_iele = tag_ids;
@@ -165,8 +166,10 @@ void ElectrodeMatrix::pair_contribution(double **array)
 
         r = sqrt(rsq);
         rinv = 1.0 / r;
-        aij = rinv;
-        aij *= ElectrodeMath::safe_erfc(g_ewald * r);
+        if (ewald_kernel)
+          aij = ElectrodeMath::safe_erfc(g_ewald * r) * rinv;
+        else
+          aij = electrode_kspace->real_space_kernel(r);
         aij -= ElectrodeMath::safe_erfc(etaij * r) * rinv;
         // newton on or off?
         if (!newton_pair && j >= nlocal) aij *= 0.5;
@@ -185,7 +188,7 @@ void ElectrodeMatrix::self_contribution(double **array)
   int nlocal = atom->nlocal;
   int *mask = atom->mask;
 
-  const double selfint = 2.0 / MY_PIS * g_ewald;
+  const double selfint = electrode_kspace->self_interaction();
   const double preta = MY_SQRT2 / MY_PIS;
 
   for (int i = 0; i < nlocal; i++)
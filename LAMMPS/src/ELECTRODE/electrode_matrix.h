@@ -39,6 +39,7 @@ class ElectrodeMatrix : protected Pointers {
   bigint ngroup;
   double **cutsq;
   double g_ewald, eta;
+  bool ewald_kernel;
   bool tfflag;
   bool etaflag;
   int eta_index;
@@ -81,6 +81,7 @@ void ElectrodeVector::setup(class Pair *fix_pair, class NeighList *fix_neighlist
 
   electrode_kspace = dynamic_cast<ElectrodeKSpace *>(force->kspace);
   if (electrode_kspace == nullptr) error->all(FLERR, "KSpace does not implement ElectrodeKSpace");
+  ewald_kernel = electrode_kspace->ewald_kernel();
   g_ewald = force->kspace->g_ewald;
 }
 
@@ -179,8 +180,8 @@ void ElectrodeVector::pair_contribution(double *vector)
       }
       double const r = sqrt(rsq);
       double const rinv = 1.0 / r;
-      double aij = rinv;
-      aij *= ElectrodeMath::safe_erfc(g_ewald * r);
+      double aij = ewald_kernel ? ElectrodeMath::safe_erfc(g_ewald * r) * rinv
+                                : electrode_kspace->real_space_kernel(r);
       aij -= ElectrodeMath::safe_erfc(etaij * r) * rinv;
       if (i_in_sensor) { vector[i] += aij * q[j]; }
       if (j_in_sensor && (!invert_source || !i_in_sensor)) { vector[j] += aij * q[i]; }
@@ -197,7 +198,7 @@ void ElectrodeVector::self_contribution(double *vector)
   int *ilist = list->ilist;
   double *q = atom->q;
 
-  const double selfint = 2.0 / MY_PIS * g_ewald;
+  const double selfint = electrode_kspace->self_interaction();
   const double preta = MY_SQRT2 / MY_PIS;
 
   for (int ii = 0; ii < inum; ii++) {
@@ -21,6 +21,7 @@
 #include "boundary_correction.h"
 #include "comm.h"
 #include "domain.h"
+#include "electrode_math.h"
 #include "error.h"
 #include "force.h"
 #include "math_const.h"
@@ -1132,6 +1133,20 @@ void EwaldElectrode::compute_matrix_corr(bigint *imat, double **matrix)
   boundcorr->matrix_corr(imat, matrix);
 }
 
+/* ----------------------------------------------------------------------
+   real-space kernel and self-interaction of the Ewald splitting
+------------------------------------------------------------------------- */
+
+double EwaldElectrode::real_space_kernel(double r)
+{
+  return ElectrodeMath::safe_erfc(g_ewald * r) / r;
+}
+
+double EwaldElectrode::self_interaction()
+{
+  return 2.0 / MY_PIS * g_ewald;
+}
+
 /* ---------------------------------------------------------------------- */
 
 void EwaldElectrode::update_eikr(bool enforce_update)
@@ -43,6 +43,8 @@ class EwaldElectrode : public Ewald, public ElectrodeKSpace {
   void compute_vector_corr(double *, int, int, bool) override;
   void compute_matrix(bigint *, double **, bool) override;
   void compute_matrix_corr(bigint *, double **) override;
+  double real_space_kernel(double) override;
+  double self_interaction() override;
 
  protected:
   class BoundaryCorrection *boundcorr;
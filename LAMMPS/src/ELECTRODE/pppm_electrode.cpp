@@ -24,6 +24,7 @@
 #include "citeme.h"
 #include "comm.h"
 #include "domain.h"
+#include "electrode_math.h"
 #include "error.h"
 #include "fft3d_wrap.h"
 #include "force.h"
@@ -1855,6 +1856,20 @@ void PPPMElectrode::compute_matrix_corr(bigint *imat, double **matrix)
   boundcorr->matrix_corr(imat, matrix);
 }
 
+/* ----------------------------------------------------------------------
+   real-space kernel and self-interaction of the Ewald splitting
+------------------------------------------------------------------------- */
+
+double PPPMElectrode::real_space_kernel(double r)
+{
+  return ElectrodeMath::safe_erfc(g_ewald * r) / r;
+}
+
+double PPPMElectrode::self_interaction()
+{
+  return 2.0 / MY_PIS * g_ewald;
+}
+
 /* ----------------------------------------------------------------------
    compute b-vector EW3DC correction of constant potential approach
  -------------------------------------------------------------------------
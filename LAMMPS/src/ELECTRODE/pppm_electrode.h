@@ -42,6 +42,8 @@ class PPPMElectrode : public PPPM, public ElectrodeKSpace {
   void compute_vector_corr(double *, int, int, bool) override;
   void compute_matrix(bigint *, double **, bool) override;
   void compute_matrix_corr(bigint *, double **) override;
+  double real_space_kernel(double) override;
+  double self_interaction() override;
 
   void compute_group_group(int, int, int) override;
 
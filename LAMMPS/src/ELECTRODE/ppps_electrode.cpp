@@ -0,0 +1,673 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+/* ----------------------------------------------------------------------
+   PPPS version of PPPMElectrode, the electrode matrix and vector use the
+   PSWF spreading and the PSWF real-space kernel of the pair style
+------------------------------------------------------------------------- */
+
+#include "ppps_electrode.h"
+
+#include "atom.h"
+#include "boundary_correction.h"
+#include "comm.h"
+#include "domain.h"
+#include "error.h"
+#include "fft3d_wrap.h"
+#include "grid3d.h"
+#include "memory.h"
+#include "slab_dipole.h"
+#include "update.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+using namespace LAMMPS_NS;
+
+static constexpr int OFFSET = 16384;
+static constexpr FFT_SCALAR ZEROF = 0.0;
+
+/* ---------------------------------------------------------------------- */
+
+PPPSElectrode::PPPSElectrode(LAMMPS *lmp) :
+    PPPS(lmp), electrolyte_density_brick(nullptr), electrolyte_density_fft(nullptr),
+    potential_brick(nullptr), boundcorr(nullptr)
+{
+  group_group_enable = 0;
+  compute_step = -1;
+  last_source_grpbit = 1 << 0;    // initialize to "all"
+  last_invert_source = false;
+}
+
+/* ----------------------------------------------------------------------
+   free electrode memory, ~PPPS() frees the rest
+------------------------------------------------------------------------- */
+
+PPPSElectrode::~PPPSElectrode()
+{
+  if (copymode) return;
+
+  free_electrode();
+}
+
+/* ----------------------------------------------------------------------
+   called once before run
+------------------------------------------------------------------------- */
+
+void PPPSElectrode::init()
+{
+  if (me == 0) utils::logmesg(lmp, "PPPS/electrode initialization ...\n");
+
+  // error check
+
+  if (slabflag == 3)
+    error->all(FLERR, "Cannot (yet) use PPPS/electrode with 'kspace_modify slab ew2d'");
+  if (wireflag) error->all(FLERR, "Cannot (yet) use PPPS/electrode with 'kspace_modify wire'");
+  if (domain->triclinic) error->all(FLERR, "Cannot (yet) use PPPS/electrode with triclinic box");
+  if (domain->dimension == 2) error->all(FLERR, "Cannot use PPPS/electrode with 2d simulation");
+
+  PPPS::init();
+
+  compute_step = -1;
+}
+
+/* ----------------------------------------------------------------------
+   compute the PPPS long-range force, energy, virial
+   electrode charges change every step, so qsum and qsqsum are always updated
+------------------------------------------------------------------------- */
+
+void PPPSElectrode::compute(int eflag, int vflag)
+{
+  qsum_qsq();
+  natoms_original = atom->natoms;
+
+  start_compute();
+
+  PPPS::compute(eflag, vflag);
+}
+
+/* ----------------------------------------------------------------------
+   setup on first use and map particles to the grid once per step
+------------------------------------------------------------------------- */
+
+void PPPSElectrode::start_compute()
+{
+  if (compute_step < update->ntimestep) {
+    if (compute_step == -1) setup();
+    boxlo = domain->boxlo;
+    // extend size of per-atom arrays if necessary
+    if (atom->nmax > nmax) {
+      memory->destroy(part2grid);
+      nmax = atom->nmax;
+      memory->create(part2grid, nmax, 3, "ppps/electrode:part2grid");
+    }
+    // find grid points for all my particles
+    particle_map();
+    compute_step = update->ntimestep;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   potential of the source charges at the sensor atoms
+   the source density is convolved with the same greensfn as in poisson()
+------------------------------------------------------------------------- */
+
+void PPPSElectrode::compute_vector(double *vec, int sensor_grpbit, int source_grpbit,
+                                   bool invert_source)
+{
+  start_compute();
+
+  // temporarily switch pointers so we can use brick2fft() for
+  // the electrolyte density
+
+  FFT_SCALAR ***density_brick_real = density_brick;
+  FFT_SCALAR *density_fft_real = density_fft;
+  make_rho_in_brick(source_grpbit, electrolyte_density_brick, invert_source);
+  density_brick = electrolyte_density_brick;
+  density_fft = electrolyte_density_fft;
+  gc->reverse_comm(Grid3d::KSPACE, this, REVERSE_RHO, 1, sizeof(FFT_SCALAR), gc_buf1, gc_buf2,
+                   MPI_FFT_SCALAR);
+  brick2fft();
+  density_brick = density_brick_real;
+  density_fft = density_fft_real;
+
+  // transform electrolyte charge density (r -> k)
+
+  fft_density(electrolyte_density_fft, work1);
+
+  // k->r FFT of Green's * electrolyte density = potential_brick
+
+  for (int i = 0, n = 0; i < nfft; i++) {
+    work2[n] = work1[n] * greensfn[i];
+    n++;
+    work2[n] = work1[n] * greensfn[i];
+    n++;
+  }
+  fft2->compute(work2, work2, FFT3d::BACKWARD);
+  for (int k = nzlo_in, n = 0; k <= nzhi_in; k++)
+    for (int j = nylo_in; j <= nyhi_in; j++)
+      for (int i = nxlo_in; i <= nxhi_in; i++) {
+        potential_brick[k][j][i] = work2[n];
+        n += fft2_stride;
+      }
+
+  // FORWARD_AD communicates u_brick, which only exists for ad or per-atom energies
+
+  FFT_SCALAR ***u_brick_real = u_brick;
+  u_brick = potential_brick;
+  gc->forward_comm(Grid3d::KSPACE, this, FORWARD_AD, 1, sizeof(FFT_SCALAR), gc_buf1, gc_buf2,
+                   MPI_FFT_SCALAR);
+  u_brick = u_brick_real;
+
+  project_psi(vec, sensor_grpbit);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void PPPSElectrode::project_psi(double *vec, int sensor_grpbit)
+{
+  // project potential_brick with weight matrix
+  double **x = atom->x;
+  int *mask = atom->mask;
+  const bigint ngridtotal = (bigint) nx_pppm * ny_pppm * nz_pppm;
+  const double scaleinv = 1.0 / ngridtotal;
+
+  for (int i = 0; i < atom->nlocal; i++) {
+    if (!(mask[i] & sensor_grpbit)) continue;
+    double v = 0.;
+    // (nx,ny,nz) = global coords of grid pt to "lower left" of charge
+    // (dx,dy,dz) = distance to "lower left" grid pt
+    // (mx,my,mz) = global coords of moving stencil pt
+    int nix = part2grid[i][0];
+    int niy = part2grid[i][1];
+    int niz = part2grid[i][2];
+    FFT_SCALAR dix = nix + shiftone - (x[i][0] - boxlo[0]) * delxinv;
+    FFT_SCALAR diy = niy + shiftone - (x[i][1] - boxlo[1]) * delyinv;
+    FFT_SCALAR diz = niz + shiftone - (x[i][2] - boxlo[2]) * delzinv;
+    compute_rho1d(dix, diy, diz);
+    for (int ni = nlower; ni <= nupper; ni++) {
+      double iz0 = rho1d[2][ni];
+      int miz = ni + niz;
+      for (int mi = nlower; mi <= nupper; mi++) {
+        double iy0 = iz0 * rho1d[1][mi];
+        int miy = mi + niy;
+        for (int li = nlower; li <= nupper; li++) {
+          int mix = li + nix;
+          double ix0 = iy0 * rho1d[0][li];
+          v += ix0 * potential_brick[miz][miy][mix];
+        }
+      }
+    }
+    vec[i] += v * scaleinv;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   k-space part of the electrode matrix, W^T G W with G the Green's
+   function on the mesh in real space
+------------------------------------------------------------------------- */
+
+void PPPSElectrode::compute_matrix(bigint *imat, double **matrix, bool timer_flag)
+{
+  start_compute();    // make sure greensfn and part2grid are set up
+
+  // fft green's function k -> r (double)
+  double *greens_real;
+  memory->create(greens_real, nz_pppm * ny_pppm * nx_pppm, "ppps/electrode:greens_real");
+  memset(greens_real, 0,
+         (std::size_t) nz_pppm * (std::size_t) ny_pppm * (std::size_t) nx_pppm * sizeof(double));
+  for (int i = 0, n = 0; i < nfft; i++) {
+    work2[n++] = greensfn[i];
+    work2[n++] = ZEROF;
+  }
+  fft2->compute(work2, work2, FFT3d::BACKWARD);
+  for (int k = nzlo_in, n = 0; k <= nzhi_in; k++)
+    for (int j = nylo_in; j <= nyhi_in; j++)
+      for (int i = nxlo_in; i <= nxhi_in; i++) {
+        greens_real[ny_pppm * nx_pppm * k + nx_pppm * j + i] = work2[n];
+        n += fft2_stride;
+      }
+  MPI_Allreduce(MPI_IN_PLACE, greens_real, nz_pppm * ny_pppm * nx_pppm, MPI_DOUBLE, MPI_SUM, world);
+  int const nlocal = atom->nlocal;
+  int nmat = std::count_if(&imat[0], &imat[nlocal], [](int x) {
+    return x >= 0;
+  });
+  MPI_Allreduce(MPI_IN_PLACE, &nmat, 1, MPI_INT, MPI_SUM, world);
+
+  // gather x_ele
+  double **x_ele;
+  memory->create(x_ele, nmat, 3, "ppps/electrode:x_ele");
+  memset(&(x_ele[0][0]), 0, nmat * 3 * sizeof(double));
+  double **x = atom->x;
+  for (int i = 0; i < nlocal; i++) {
+    int ipos = imat[i];
+    if (ipos < 0) continue;
+    for (int dim = 0; dim < 3; dim++) x_ele[ipos][dim] = x[i][dim];
+  }
+  MPI_Allreduce(MPI_IN_PLACE, &(x_ele[0][0]), nmat * 3, MPI_DOUBLE, MPI_SUM, world);
+
+  if (conp_one_step)
+    one_step_multiplication(imat, greens_real, x_ele, matrix, nmat, timer_flag);
+  else
+    two_step_multiplication(imat, greens_real, x_ele, matrix, nmat, timer_flag);
+  memory->destroy(greens_real);
+  memory->destroy(x_ele);
+}
+
+/* ----------------------------------------------------------------------*/
+
+void PPPSElectrode::one_step_multiplication(bigint *imat, double *greens_real, double **x_ele,
+                                            double **matrix, int const nmat, bool timer_flag)
+{
+  // map green's function in real space from mesh to particle positions
+  // with matrix multiplication 'W^T G W' in one step. Uses less memory than
+  // two_step_multiplication
+  int const nlocal = atom->nlocal;
+  double **x = atom->x;
+  MPI_Barrier(world);
+  double step1_time = MPI_Wtime();
+
+  // precalculate rho_1d for local electrode
+  std::vector<int> j_list;
+  for (int j = 0; j < nlocal; j++) {
+    int jpos = imat[j];
+    if (jpos < 0) continue;
+    j_list.push_back(j);
+  }
+  int const nj_local = j_list.size();
+
+  FFT_SCALAR ***rho1d_j;
+  memory->create(rho1d_j, nj_local, 3, order, "ppps/electrode:rho1d_j");
+
+  for (int jlist_pos = 0; jlist_pos < nj_local; jlist_pos++) {
+    int j = j_list[jlist_pos];
+    int njx = part2grid[j][0];
+    int njy = part2grid[j][1];
+    int njz = part2grid[j][2];
+    FFT_SCALAR const djx = njx + shiftone - (x[j][0] - boxlo[0]) * delxinv;
+    FFT_SCALAR const djy = njy + shiftone - (x[j][1] - boxlo[1]) * delyinv;
+    FFT_SCALAR const djz = njz + shiftone - (x[j][2] - boxlo[2]) * delzinv;
+    compute_rho1d(djx, djy, djz);
+    for (int dim = 0; dim < 3; dim++) {
+      for (int oi = 0; oi < order; oi++) { rho1d_j[jlist_pos][dim][oi] = rho1d[dim][oi + nlower]; }
+    }
+  }
+
+  // nested loops over weights of electrode atoms i and j
+  // (nx,ny,nz) = global coords of grid pt to "lower left" of charge
+  // (dx,dy,dz) = distance to "lower left" grid pt
+  // (mx,my,mz) = global coords of moving stencil pt
+  int const order2 = order * order;
+  int const order6 = order2 * order2 * order2;
+  double *amesh;
+  memory->create(amesh, order6, "ppps/electrode:amesh");
+  for (int ipos = 0; ipos < nmat; ipos++) {
+    double *_noalias xi_ele = x_ele[ipos];
+    // new calculation for nx, ny, nz because part2grid available for nlocal,
+    // only
+    int nix = static_cast<int>((xi_ele[0] - boxlo[0]) * delxinv + shift) - OFFSET;
+    int niy = static_cast<int>((xi_ele[1] - boxlo[1]) * delyinv + shift) - OFFSET;
+    int niz = static_cast<int>((xi_ele[2] - boxlo[2]) * delzinv + shift) - OFFSET;
+    FFT_SCALAR const dix = nix + shiftone - (xi_ele[0] - boxlo[0]) * delxinv;
+    FFT_SCALAR const diy = niy + shiftone - (xi_ele[1] - boxlo[1]) * delyinv;
+    FFT_SCALAR const diz = niz + shiftone - (xi_ele[2] - boxlo[2]) * delzinv;
+    compute_rho1d(dix, diy, diz);
+    int njx = -1;
+    int njy = -1;
+    int njz = -1;    // force initial build_amesh
+    for (int jlist_pos = 0; jlist_pos < nj_local; jlist_pos++) {
+      int j = j_list[jlist_pos];
+      int ind_amesh = 0;
+      int jpos = imat[j];
+      if ((ipos < jpos) == !((ipos - jpos) % 2)) continue;
+      double aij = 0.;
+      if (njx != part2grid[j][0] || njy != part2grid[j][1] || njz != part2grid[j][2]) {
+        njx = part2grid[j][0];
+        njy = part2grid[j][1];
+        njz = part2grid[j][2];
+        build_amesh(njx - nix, njy - niy, njz - niz, amesh, greens_real);
+      }
+      for (int ni = nlower; ni <= nupper; ni++) {    // i's rho1d[dim] indexed from nlower to nupper
+        FFT_SCALAR const iz0 = rho1d[2][ni];
+        for (int nj = 0; nj < order; nj++) {    // j's rho1d_j[][dim] indexed from 0 to order-1
+          FFT_SCALAR const jz0 = rho1d_j[jlist_pos][2][nj];
+          for (int mi = nlower; mi <= nupper; mi++) {
+            FFT_SCALAR const iy0 = iz0 * rho1d[1][mi];
+            for (int mj = 0; mj < order; mj++) {
+              FFT_SCALAR const jy0 = jz0 * rho1d_j[jlist_pos][1][mj];
+              for (int li = nlower; li <= nupper; li++) {
+                FFT_SCALAR const ix0 = iy0 * rho1d[0][li];
+                double aij_xscan = 0.;
+                for (int lj = 0; lj < order; lj++) {
+                  aij_xscan += (double) amesh[ind_amesh] * rho1d_j[jlist_pos][0][lj];
+                  ind_amesh++;
+                }
+                aij += (double) ix0 * jy0 * aij_xscan;
+              }
+            }
+          }
+        }
+      }
+      matrix[ipos][jpos] += aij / volume;
+      if (ipos != jpos) matrix[jpos][ipos] += aij / volume;
+    }
+  }
+  memory->destroy(amesh);
+  memory->destroy(rho1d_j);
+  MPI_Barrier(world);
+  if (timer_flag && (comm->me == 0))
+    utils::logmesg(lmp, "Single step time: {:.4g} s\n", MPI_Wtime() - step1_time);
+}
+
+/* ----------------------------------------------------------------------*/
+
+void PPPSElectrode::build_amesh(const int dx,    // = njx - nix
+                                const int dy,    // = njy - niy
+                                const int dz,    // = njz - niz
+                                double *amesh, double *const greens_real)
+{
+  auto fmod = [](int x, int n) {    // fast unsigned mod
+    int r = abs(x);
+    while (r >= n) r -= n;
+    return r;
+  };
+  int ind_amesh = 0;
+
+  for (int iz = 0; iz < order; iz++)
+    for (int jz = 0; jz < order; jz++) {
+      int const mz = fmod(dz + jz - iz, nz_pppm) * nx_pppm * ny_pppm;
+      for (int iy = 0; iy < order; iy++)
+        for (int jy = 0; jy < order; jy++) {
+          int const my = fmod(dy + jy - iy, ny_pppm) * nx_pppm;
+          for (int ix = 0; ix < order; ix++)
+            for (int jx = 0; jx < order; jx++) {
+              int const mx = fmod(dx + jx - ix, nx_pppm);
+              amesh[ind_amesh] = greens_real[mz + my + mx];
+              ind_amesh++;
+            }
+        }
+    }
+}
+
+/* ----------------------------------------------------------------------*/
+
+void PPPSElectrode::two_step_multiplication(bigint *imat, double *greens_real, double **x_ele,
+                                            double **matrix, int const nmat, bool timer_flag)
+{
+  // map green's function in real space from mesh to particle positions
+  // with matrix multiplication 'W^T G W' in two steps. gw is result of
+  // first multiplication.
+  int const nlocal = atom->nlocal;
+  MPI_Barrier(world);
+  double step1_time = MPI_Wtime();
+  int nx_ele = nxhi_out - nxlo_out + 1;
+  int ny_ele = nyhi_out - nylo_out + 1;
+  int nz_ele = nzhi_out - nzlo_out + 1;
+  int nxyz = nx_ele * ny_ele * nz_ele;
+
+  double **gw;
+  memory->create(gw, nmat, nxyz, "ppps/electrode:gw");
+  memset(&(gw[0][0]), 0, (std::size_t) nmat * (std::size_t) nxyz * sizeof(double));
+
+  auto fmod = [](int x, int n) {    // fast unsigned mod
+    int r = abs(x);
+    while (r >= n) r -= n;
+    return r;
+  };
+
+  // loops over weights of electrode atoms and weights of complete grid
+  // (nx,ny,nz) = global coords of grid pt to "lower left" of charge
+  // (dx,dy,dz) = distance to "lower left" grid pt
+  // (mx,my,mz) = global coords of moving stencil pt
+  for (int ipos = 0; ipos < nmat; ipos++) {
+    double *_noalias xi_ele = x_ele[ipos];
+    // new calculation for nx, ny, nz because part2grid available for
+    // nlocal, only
+    int nix = static_cast<int>((xi_ele[0] - boxlo[0]) * delxinv + shift) - OFFSET;
+    int niy = static_cast<int>((xi_ele[1] - boxlo[1]) * delyinv + shift) - OFFSET;
+    int niz = static_cast<int>((xi_ele[2] - boxlo[2]) * delzinv + shift) - OFFSET;
+    FFT_SCALAR dx = nix + shiftone - (xi_ele[0] - boxlo[0]) * delxinv;
+    FFT_SCALAR dy = niy + shiftone - (xi_ele[1] - boxlo[1]) * delyinv;
+    FFT_SCALAR dz = niz + shiftone - (xi_ele[2] - boxlo[2]) * delzinv;
+    compute_rho1d(dx, dy, dz);
+    // same loop order as in PPPMElectrode::two_step_multiplication(),
+    // which was found fastest upon benchmarking
+    for (int mjz = nzlo_out; mjz <= nzhi_out; mjz++) {
+      for (int ni = nlower; ni <= nupper; ni++) {
+        double const iz0 = rho1d[2][ni];
+        int const mz = fmod(mjz - ni - niz, nz_pppm);
+        for (int mjy = nylo_out; mjy <= nyhi_out; mjy++) {
+          for (int mi = nlower; mi <= nupper; mi++) {
+            double const iy0 = iz0 * rho1d[1][mi];
+            int const my = fmod(mjy - mi - niy, ny_pppm);
+            for (int mjx = nxlo_out; mjx <= nxhi_out; mjx++) {
+              for (int li = nlower; li <= nupper; li++) {
+                double const ix0 = iy0 * rho1d[0][li];
+                int const mx = fmod(mjx - li - nix, nx_pppm);
+                gw[ipos][nx_ele * ny_ele * (mjz - nzlo_out) + nx_ele * (mjy - nylo_out) +
+                         (mjx - nxlo_out)] +=
+                    ix0 * greens_real[mz * nx_pppm * ny_pppm + my * nx_pppm + mx];
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+  MPI_Barrier(world);
+  if (timer_flag && (comm->me == 0))
+    utils::logmesg(lmp, "step 1 time: {:.4g} s\n", MPI_Wtime() - step1_time);
+
+  // nested loop over electrode atoms i and j and stencil of i
+  double step2_time = MPI_Wtime();
+  double **x = atom->x;
+  for (int i = 0; i < nlocal; i++) {
+    int ipos = imat[i];
+    if (ipos < 0) continue;
+    int nix = part2grid[i][0];
+    int niy = part2grid[i][1];
+    int niz = part2grid[i][2];
+    FFT_SCALAR dix = nix + shiftone - (x[i][0] - boxlo[0]) * delxinv;
+    FFT_SCALAR diy = niy + shiftone - (x[i][1] - boxlo[1]) * delyinv;
+    FFT_SCALAR diz = niz + shiftone - (x[i][2] - boxlo[2]) * delzinv;
+    compute_rho1d(dix, diy, diz);
+    for (int jpos = 0; jpos < nmat; jpos++) {
+      double aij = 0.;
+      for (int ni = nlower; ni <= nupper; ni++) {
+        double iz0 = rho1d[2][ni];
+        int miz = ni + niz;
+        for (int mi = nlower; mi <= nupper; mi++) {
+          double iy0 = iz0 * rho1d[1][mi];
+          int miy = mi + niy;
+          for (int li = nlower; li <= nupper; li++) {
+            int mix = li + nix;
+            double ix0 = iy0 * rho1d[0][li];
+            int miz0 = miz - nzlo_out;
+            int miy0 = miy - nylo_out;
+            int mix0 = mix - nxlo_out;
+            aij += ix0 * gw[jpos][nx_ele * ny_ele * miz0 + nx_ele * miy0 + mix0];
+          }
+        }
+      }
+      matrix[ipos][jpos] += aij / volume;
+    }
+  }
+  MPI_Barrier(world);
+  memory->destroy(gw);
+  if (timer_flag && (comm->me == 0))
+    utils::logmesg(lmp, "step 2 time: {:.4g} s\n", MPI_Wtime() - step2_time);
+}
+
+/* ----------------------------------------------------------------------
+   allocate memory that depends on # of K-vectors and order
+------------------------------------------------------------------------- */
+
+void PPPSElectrode::allocate()
+{
+  PPPS::allocate();
+
+  if (slabflag == 1) {
+    // EW3Dc dipole correction
+    boundcorr = new SlabDipole(lmp);
+  } else {
+    // dummy BoundaryCorrection for ffield
+    boundcorr = new BoundaryCorrection(lmp);
+  }
+
+  memory->create3d_offset(electrolyte_density_brick, nzlo_out, nzhi_out, nylo_out, nyhi_out,
+                          nxlo_out, nxhi_out, "ppps/electrode:electrolyte_density_brick");
+  memory->create(electrolyte_density_fft, nfft_both, "ppps/electrode:electrolyte_density_fft");
+  memory->create3d_offset(potential_brick, nzlo_out, nzhi_out, nylo_out, nyhi_out, nxlo_out,
+                          nxhi_out, "ppps/electrode:potential_brick");
+}
+
+/* ----------------------------------------------------------------------
+   deallocate memory that depends on # of K-vectors and order
+------------------------------------------------------------------------- */
+
+void PPPSElectrode::deallocate()
+{
+  free_electrode();
+  PPPS::deallocate();
+}
+
+/* ---------------------------------------------------------------------- */
+
+void PPPSElectrode::free_electrode()
+{
+  delete boundcorr;
+  boundcorr = nullptr;
+  memory->destroy3d_offset(electrolyte_density_brick, nzlo_out, nylo_out, nxlo_out);
+  memory->destroy(electrolyte_density_fft);
+  memory->destroy3d_offset(potential_brick, nzlo_out, nylo_out, nxlo_out);
+}
+
+/* ----------------------------------------------------------------------
+   slab-geometry correction term via the electrode boundary correction
+------------------------------------------------------------------------- */
+
+void PPPSElectrode::slabcorr()
+{
+  boundcorr->compute_corr(qsum, eflag_atom, eflag_global, energy, eatom);
+}
+
+/* ----------------------------------------------------------------------
+   density of the source charges only
+------------------------------------------------------------------------- */
+
+void PPPSElectrode::make_rho_in_brick(int source_grpbit, FFT_SCALAR ***scratch_brick,
+                                      bool invert_source)
+{
+  int l, m, n, nx, ny, nz, mx, my, mz;
+  FFT_SCALAR dx, dy, dz, x0, y0, z0;
+
+  last_source_grpbit = source_grpbit;
+  last_invert_source = invert_source;
+
+  // clear 3d density array
+  memset(&(scratch_brick[nzlo_out][nylo_out][nxlo_out]), 0, ngrid * sizeof(FFT_SCALAR));
+
+  // loop over my charges, add their contribution to nearby grid points
+  // (nx,ny,nz) = global coords of grid pt to "lower left" of charge
+  // (dx,dy,dz) = distance to "lower left" grid pt
+  // (mx,my,mz) = global coords of moving stencil pt
+
+  double *q = atom->q;
+  double **x = atom->x;
+  int *mask = atom->mask;
+  int nlocal = atom->nlocal;
+
+  for (int i = 0; i < nlocal; i++) {
+    bool const i_in_source = !!(mask[i] & source_grpbit) != invert_source;
+    if (!i_in_source) continue;
+    nx = part2grid[i][0];
+    ny = part2grid[i][1];
+    nz = part2grid[i][2];
+    dx = nx + shiftone - (x[i][0] - boxlo[0]) * delxinv;
+    dy = ny + shiftone - (x[i][1] - boxlo[1]) * delyinv;
+    dz = nz + shiftone - (x[i][2] - boxlo[2]) * delzinv;
+
+    compute_rho1d(dx, dy, dz);
+
+    z0 = delvolinv * q[i];
+    for (n = nlower; n <= nupper; n++) {
+      mz = n + nz;
+      y0 = z0 * rho1d[2][n];
+      for (m = nlower; m <= nupper; m++) {
+        my = m + ny;
+        x0 = y0 * rho1d[1][m];
+        for (l = nlower; l <= nupper; l++) {
+          mx = l + nx;
+          scratch_brick[mz][my][mx] += x0 * rho1d[0][l];
+        }
+      }
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   group-group interactions
+------------------------------------------------------------------------- */
+
+void PPPSElectrode::compute_group_group(int /*groupbit_A*/, int /*groupbit_B*/, int /*AA_flag*/)
+{
+  error->all(FLERR, "group group interaction not implemented in ppps/electrode yet");
+}
+
+/* ---------------------------------------------------------------------- */
+
+void PPPSElectrode::compute_matrix_corr(bigint *imat, double **matrix)
+{
+  boundcorr->matrix_corr(imat, matrix);
+}
+
+/* ----------------------------------------------------------------------
+   compute b-vector EW3DC correction of constant potential approach
+------------------------------------------------------------------------- */
+
+void PPPSElectrode::compute_vector_corr(double *vec, int sensor_grpbit, int source_grpbit,
+                                        bool invert_source)
+{
+  boundcorr->vector_corr(vec, sensor_grpbit, source_grpbit, invert_source);
+}
+
+/* ----------------------------------------------------------------------
+   PSWF real-space kernel of the pair style, zero beyond the cutoff, and
+   its self-interaction, the slope of the energy kernel at 0
+------------------------------------------------------------------------- */
+
+double PPPSElectrode::real_space_kernel(double r)
+{
+  if (r >= cutoff) return 0.0;
+  return PSWFPoly::piecewise(energy_poly_coeff, num_of_energy_poly, num_of_poly_pieces,
+                             r / cutoff) / r;
+}
+
+double PPPSElectrode::self_interaction()
+{
+  return self_coeff / cutoff;
+}
+
+/* ----------------------------------------------------------------------
+   memory usage of local arrays
+------------------------------------------------------------------------- */
+
+double PPPSElectrode::memory_usage()
+{
+  double bytes = PPPS::memory_usage();
+  bytes += (double) 2 * ngrid * sizeof(FFT_SCALAR);
+  bytes += (double) nfft_both * sizeof(FFT_SCALAR);
+  return bytes;
+}
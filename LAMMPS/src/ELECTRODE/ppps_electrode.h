@@ -0,0 +1,72 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef KSPACE_CLASS
+// clang-format off
+KSpaceStyle(ppps/electrode, PPPSElectrode);
+// clang-format on
+#else
+
+#ifndef LMP_PPPS_ELECTRODE_H
+#define LMP_PPPS_ELECTRODE_H
+
+#include "electrode_kspace.h"
+#include "ppps.h"
+
+namespace LAMMPS_NS {
+
+class PPPSElectrode : public PPPS, public ElectrodeKSpace {
+ public:
+  PPPSElectrode(class LAMMPS *);
+  ~PPPSElectrode() override;
+  void init() override;
+  void compute(int, int) override;
+  double memory_usage() override;
+
+  void compute_vector(double *, int, int, bool) override;
+  void compute_vector_corr(double *, int, int, bool) override;
+  void compute_matrix(bigint *, double **, bool) override;
+  void compute_matrix_corr(bigint *, double **) override;
+  double real_space_kernel(double) override;
+  double self_interaction() override;
+  bool ewald_kernel() override { return false; }
+
+  void compute_group_group(int, int, int) override;
+
+ protected:
+  FFT_SCALAR ***electrolyte_density_brick;
+  FFT_SCALAR *electrolyte_density_fft;
+  FFT_SCALAR ***potential_brick;    // potential of the source charges, see compute_vector()
+  class BoundaryCorrection *boundcorr;
+
+  void allocate() override;
+  void deallocate() override;
+  void slabcorr() override;
+
+ private:
+  int compute_step;
+  int last_source_grpbit;
+  bool last_invert_source;
+  void free_electrode();
+  void start_compute();
+  void make_rho_in_brick(int, FFT_SCALAR ***, bool);
+  void project_psi(double *, int);
+  void one_step_multiplication(bigint *, double *, double **, double **, int const, bool);
+  void two_step_multiplication(bigint *, double *, double **, double **, int const, bool);
+  void build_amesh(int, int, int, double *, double *);
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
+#endif
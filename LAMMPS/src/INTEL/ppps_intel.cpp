@@ -0,0 +1,682 @@
+// clang-format off
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+/* ----------------------------------------------------------------------
+   vectorized spreading and interpolation for PPPS,
+   following the loop structure of pppm/intel
+------------------------------------------------------------------------- */
+
+#include "ppps_intel.h"
+
+#include "atom.h"
+#include "comm.h"
+#include "domain.h"
+#include "error.h"
+#include "force.h"
+#include "math_const.h"
+#include "memory.h"
+#include "modify.h"
+#include "suffix.h"
+#include "update.h"
+
+#include <cmath>
+#include <cstring>
+
+#include "omp_compat.h"
+
+using namespace LAMMPS_NS;
+using namespace MathConst;
+
+static constexpr int OFFSET = 16384;
+
+/* ---------------------------------------------------------------------- */
+
+PPPSIntel::PPPSIntel(LAMMPS *lmp) : PPPS(lmp)
+{
+  suffix_flag |= Suffix::INTEL;
+
+  fix = nullptr;
+  perthread_density = nullptr;
+  order_auto_max = INTEL_P3M_MAXORDER;
+}
+
+PPPSIntel::~PPPSIntel()
+{
+  memory->destroy(perthread_density);
+}
+
+/* ----------------------------------------------------------------------
+   called once before run
+------------------------------------------------------------------------- */
+
+void PPPSIntel::init()
+{
+  // the padded stencil loops need at most INTEL_P3M_ALIGNED_MAXORDER points
+
+  if (order > INTEL_P3M_MAXORDER)
+    error->all(FLERR,"PPPS order {} greater than {} supported by INTEL",
+               order,INTEL_P3M_MAXORDER);
+
+  // the vectorized spreading and interpolation loops do not use the tile ordering
+  //   or the spreading weight cache
+
+  if (sort_block || rho_cache_max) {
+    if (comm->me == 0)
+      error->warning(FLERR,"Kspace_modify sort and spread/cache are ignored by kspace style ppps/intel");
+    sort_block = rho_cache_max = 0;
+  }
+
+  PPPS::init();
+
+  fix = static_cast<FixIntel *>(modify->get_fix_by_id("package_intel"));
+  if (!fix) error->all(FLERR, "The 'package intel' command is required for /intel styles");
+
+  if (utils::strmatch(update->integrate_style,"^verlet/split"))
+    error->all(FLERR,"Intel styles for kspace are not compatible with run_style verlet/split");
+}
+
+/* ----------------------------------------------------------------------
+   find center grid pt for each of my particles
+   check that full stencil for the particle will fit in my 3d brick
+   store central grid pt indices in part2grid array
+------------------------------------------------------------------------- */
+
+void PPPSIntel::particle_map()
+{
+  double **x = atom->x;
+  int nlocal = atom->nlocal;
+  int nthr = comm->nthreads;
+
+  int flag = 0;
+
+  if (!std::isfinite(boxlo[0]) || !std::isfinite(boxlo[1]) || !std::isfinite(boxlo[2]))
+    error->one(FLERR,"Non-numeric box dimensions - simulation unstable");
+
+  #if defined(_OPENMP)
+  #pragma omp parallel LMP_DEFAULT_NONE shared(nlocal, nthr, x) reduction(+:flag)
+  #endif
+  {
+    const double lo0 = boxlo[0];
+    const double lo1 = boxlo[1];
+    const double lo2 = boxlo[2];
+
+    int ifrom, ito, tid;
+    IP_PRE_omp_range_id(ifrom, ito, tid, nlocal, nthr);
+
+    #if defined(LMP_SIMD_COMPILER)
+#if defined(USE_OMP_SIMD)
+    #pragma omp simd reduction(+:flag)
+#else
+    #pragma simd reduction(+:flag)
+#endif
+    #endif
+    for (int i = ifrom; i < ito; i++) {
+
+      // (nx,ny,nz) = global coords of grid pt to "lower left" of charge
+      // current particle coord can be outside global and local box
+      // add/subtract OFFSET to avoid int(-0.75) = 0 when want it to be -1
+
+      int nx = static_cast<int> ((x[i][0]-lo0)*delxinv+shift) - OFFSET;
+      int ny = static_cast<int> ((x[i][1]-lo1)*delyinv+shift) - OFFSET;
+      int nz = static_cast<int> ((x[i][2]-lo2)*delzinv+shift) - OFFSET;
+
+      part2grid[i][0] = nx;
+      part2grid[i][1] = ny;
+      part2grid[i][2] = nz;
+
+      // check that entire stencil around nx,ny,nz will fit in my 3d brick
+
+      if (nx+nlower < nxlo_out || nx+nupper > nxhi_out ||
+          ny+nlower < nylo_out || ny+nupper > nyhi_out ||
+          nz+nlower < nzlo_out || nz+nupper > nzhi_out)
+        flag = 1;
+    }
+  }
+
+  if (flag) error->one(FLERR,"Out of range atoms - cannot compute PPPS");
+}
+
+/* ----------------------------------------------------------------------
+   dispatch on the precision mode of the package intel command
+------------------------------------------------------------------------- */
+
+void PPPSIntel::make_rho()
+{
+  if (fix->precision() == FixIntel::PREC_MODE_MIXED)
+    make_rho<float,double>();
+  else if (fix->precision() == FixIntel::PREC_MODE_DOUBLE)
+    make_rho<double,double>();
+  else
+    make_rho<float,float>();
+}
+
+void PPPSIntel::fieldforce_ik()
+{
+  if (fix->precision() == FixIntel::PREC_MODE_MIXED)
+    fieldforce_ik<float,double>();
+  else if (fix->precision() == FixIntel::PREC_MODE_DOUBLE)
+    fieldforce_ik<double,double>();
+  else
+    fieldforce_ik<float,float>();
+}
+
+void PPPSIntel::fieldforce_ad()
+{
+  if (fix->precision() == FixIntel::PREC_MODE_MIXED)
+    fieldforce_ad<float,double>();
+  else if (fix->precision() == FixIntel::PREC_MODE_DOUBLE)
+    fieldforce_ad<double,double>();
+  else
+    fieldforce_ad<float,float>();
+}
+
+/* ----------------------------------------------------------------------
+   weights of the order stencil points in each direction
+   the polynomials are evaluated in FFT_SCALAR precision and then
+     stored as flt_t, entries order..INTEL_P3M_ALIGNED_MAXORDER-1 of w
+     are left untouched and must be zero
+   with spread/table yes the weights are interpolated from the table
+------------------------------------------------------------------------- */
+
+template<class flt_t>
+void PPPSIntel::stencil_weights(flt_t (*w)[INTEL_P3M_ALIGNED_MAXORDER],
+                                FFT_SCALAR *const *coeff,
+                                FFT_SCALAR *const *lookup, int nterms,
+                                FFT_SCALAR dx, FFT_SCALAR dy, FFT_SCALAR dz)
+{
+  if (rho_table_flag) {
+    const FFT_SCALAR d[3] = {dx, dy, dz};
+    for (int a = 0; a < 3; a++) {
+      const FFT_SCALAR t = (d[a] + 1.0) * rho_scale;
+      const int it = static_cast<int>(t);
+      const FFT_SCALAR frac = t - it;
+      const FFT_SCALAR * _noalias const lo = lookup[it];
+      const FFT_SCALAR * _noalias const hi = lookup[it + 1];
+      #if defined(LMP_SIMD_COMPILER)
+#if defined(USE_OMP_SIMD)
+      #pragma omp simd
+#else
+      #pragma simd
+#endif
+      #endif
+      for (int k = 0; k < order; k++) w[a][k] = lo[k] + frac * (hi[k] - lo[k]);
+    }
+  } else {
+
+    // with piecewise polynomials each direction uses the rows of its own piece
+
+    FFT_SCALAR *const *cx = coeff, *const *cy = coeff, *const *cz = coeff;
+    FFT_SCALAR tx = dx, ty = dy, tz = dz;
+    if (rho_pieces > 1) {
+      cx += PSWFPoly::piece(rho_pieces,dx,tx)*poly_order;
+      cy += PSWFPoly::piece(rho_pieces,dy,ty)*poly_order;
+      cz += PSWFPoly::piece(rho_pieces,dz,tz)*poly_order;
+    }
+    #if defined(LMP_SIMD_COMPILER)
+#if defined(USE_OMP_SIMD)
+    #pragma omp simd
+#else
+    #pragma simd
+#endif
+    #endif
+    for (int k = nlower; k <= nupper; k++) {
+      FFT_SCALAR r1 = cx[nterms-1][k];
+      FFT_SCALAR r2 = cy[nterms-1][k];
+      FFT_SCALAR r3 = cz[nterms-1][k];
+      for (int l = nterms-2; l >= 0; l--) {
+        r1 = cx[l][k] + r1*tx;
+        r2 = cy[l][k] + r2*ty;
+        r3 = cz[l][k] + r3*tz;
+      }
+      w[0][k-nlower] = r1;
+      w[1][k-nlower] = r2;
+      w[2][k-nlower] = r3;
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   create discretized "density" on section of global grid due to my particles
+   density(x,y,z) = charge "density" at grid points of my 3d brick
+   (nxlo:nxhi,nylo:nyhi,nzlo:nzhi) is extent of my brick (including ghosts)
+   in global grid
+------------------------------------------------------------------------- */
+
+template<class flt_t, class acc_t>
+void PPPSIntel::make_rho()
+{
+  FFT_SCALAR * _noalias global_density =
+    &(density_brick[nzlo_out][nylo_out][nxlo_out]);
+
+  // loop over my charges, add their contribution to nearby grid points
+  // (nx,ny,nz) = global coords of grid pt to "lower left" of charge
+  // (dx,dy,dz) = distance to "lower left" grid pt
+  // (mx,my,mz) = global coords of moving stencil pt
+  // the innermost loop runs over the padded stencil width, the brick
+  //   allocation leaves room for the extra zero-weight writes
+
+  double **x = atom->x;
+  double *q = atom->q;
+  int nlocal = atom->nlocal;
+  int nthr = comm->nthreads;
+
+  #if defined(_OPENMP)
+  #pragma omp parallel LMP_DEFAULT_NONE shared(nthr, nlocal, global_density, x, q)
+  #endif
+  {
+    const int nix = nxhi_out - nxlo_out + 1;
+    const int niy = nyhi_out - nylo_out + 1;
+
+    const double lo0 = boxlo[0];
+    const double lo1 = boxlo[1];
+    const double lo2 = boxlo[2];
+
+    int ifrom, ito, tid;
+    IP_PRE_omp_range_id(ifrom, ito, tid, nlocal, nthr);
+    FFT_SCALAR * _noalias my_density = tid == 0 ?
+      global_density : perthread_density[tid - 1];
+
+    // clear 3d density array
+
+    memset(my_density, 0, ngrid * sizeof(FFT_SCALAR));
+
+    _alignvar(flt_t rho[3][INTEL_P3M_ALIGNED_MAXORDER], 64) = {{0}};
+
+    for (int i = ifrom; i < ito; i++) {
+
+      int nx = part2grid[i][0];
+      int ny = part2grid[i][1];
+      int nz = part2grid[i][2];
+
+      int nysum = nlower + ny - nylo_out;
+      int nxsum = nlower + nx - nxlo_out;
+      int nzsum = (nlower + nz - nzlo_out)*nix*niy + nysum*nix + nxsum;
+
+      FFT_SCALAR dx = nx+shiftone - (x[i][0]-lo0)*delxinv;
+      FFT_SCALAR dy = ny+shiftone - (x[i][1]-lo1)*delyinv;
+      FFT_SCALAR dz = nz+shiftone - (x[i][2]-lo2)*delzinv;
+
+      stencil_weights<flt_t>(rho,rho_coeff,rho_lookup,poly_order,dx,dy,dz);
+
+      const flt_t z0 = delvolinv * q[i];
+
+      #if defined(LMP_SIMD_COMPILER)
+      #pragma loop_count min(2), max(INTEL_P3M_ALIGNED_MAXORDER), avg(7)
+      #endif
+      for (int n = 0; n < order; n++) {
+        int mz = n*nix*niy + nzsum;
+        flt_t y0 = z0*rho[2][n];
+        #if defined(LMP_SIMD_COMPILER)
+        #pragma loop_count min(2), max(INTEL_P3M_ALIGNED_MAXORDER), avg(7)
+        #endif
+        for (int m = 0; m < order; m++) {
+          int mzy = m*nix + mz;
+          flt_t x0 = y0*rho[1][m];
+          #if defined(LMP_SIMD_COMPILER)
+#if defined(USE_OMP_SIMD)
+          #pragma omp simd
+#else
+          #pragma simd
+#endif
+          #endif
+          for (int l = 0; l < INTEL_P3M_ALIGNED_MAXORDER; l++) {
+            int mzyx = l + mzy;
+            my_density[mzyx] += x0*rho[0][l];
+          }
+        }
+      }
+    }
+  }
+
+  // reduce all the perthread_densities into global_density
+
+  if (nthr > 1) {
+    #if defined(_OPENMP)
+    #pragma omp parallel LMP_DEFAULT_NONE shared(nthr, global_density)
+    #endif
+    {
+      int ifrom, ito, tid;
+      IP_PRE_omp_range_id(ifrom, ito, tid, ngrid, nthr);
+
+      #if defined(LMP_SIMD_COMPILER)
+#if defined(USE_OMP_SIMD)
+      #pragma omp simd
+#else
+      #pragma simd
+#endif
+      #endif
+      for (int i = ifrom; i < ito; i++) {
+        for (int j = 1; j < nthr; j++) {
+          global_density[i] += perthread_density[j-1][i];
+        }
+      }
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   interpolate from grid to get electric field & force on my particles for ik
+------------------------------------------------------------------------- */
+
+template<class flt_t, class acc_t>
+void PPPSIntel::fieldforce_ik()
+{
+  // loop over my charges, interpolate electric field from nearby grid points
+  // (nx,ny,nz) = global coords of grid pt to "lower left" of charge
+  // (dx,dy,dz) = distance to "lower left" grid pt
+  // (mx,my,mz) = global coords of moving stencil pt
+  // ek = 3 components of E-field on particle
+
+  double **x = atom->x;
+  double *q = atom->q;
+  double **f = atom->f;
+  int nlocal = atom->nlocal;
+  int nthr = comm->nthreads;
+
+  #if defined(_OPENMP)
+  #pragma omp parallel LMP_DEFAULT_NONE shared(nlocal, nthr, x, q, f)
+  #endif
+  {
+    const double lo0 = boxlo[0];
+    const double lo1 = boxlo[1];
+    const double lo2 = boxlo[2];
+    const double qqrd2es = qqrd2e * scale;
+
+    int ifrom, ito, tid;
+    IP_PRE_omp_range_id(ifrom, ito, tid, nlocal, nthr);
+
+    _alignvar(flt_t rho[3][INTEL_P3M_ALIGNED_MAXORDER], 64) = {{0}};
+
+    for (int i = ifrom; i < ito; i++) {
+      int nx = part2grid[i][0];
+      int ny = part2grid[i][1];
+      int nz = part2grid[i][2];
+
+      int nxsum = nx + nlower;
+      int nysum = ny + nlower;
+      int nzsum = nz + nlower;
+
+      FFT_SCALAR dx = nx+shiftone - (x[i][0]-lo0)*delxinv;
+      FFT_SCALAR dy = ny+shiftone - (x[i][1]-lo1)*delyinv;
+      FFT_SCALAR dz = nz+shiftone - (x[i][2]-lo2)*delzinv;
+
+      stencil_weights<flt_t>(rho,rho_coeff,rho_lookup,poly_order,dx,dy,dz);
+
+      _alignvar(acc_t ekx_arr[INTEL_P3M_ALIGNED_MAXORDER], 64) = {0};
+      _alignvar(acc_t eky_arr[INTEL_P3M_ALIGNED_MAXORDER], 64) = {0};
+      _alignvar(acc_t ekz_arr[INTEL_P3M_ALIGNED_MAXORDER], 64) = {0};
+
+      #if defined(LMP_SIMD_COMPILER)
+      #pragma loop_count min(2), max(INTEL_P3M_ALIGNED_MAXORDER), avg(7)
+      #endif
+      for (int n = 0; n < order; n++) {
+        int mz = n+nzsum;
+        flt_t z0 = rho[2][n];
+        #if defined(LMP_SIMD_COMPILER)
+        #pragma loop_count min(2), max(INTEL_P3M_ALIGNED_MAXORDER), avg(7)
+        #endif
+        for (int m = 0; m < order; m++) {
+          int my = m+nysum;
+          flt_t y0 = z0*rho[1][m];
+          const FFT_SCALAR * _noalias const vx = &vdx_brick[mz][my][nxsum];
+          const FFT_SCALAR * _noalias const vy = &vdy_brick[mz][my][nxsum];
+          const FFT_SCALAR * _noalias const vz = &vdz_brick[mz][my][nxsum];
+          #if defined(LMP_SIMD_COMPILER)
+#if defined(USE_OMP_SIMD)
+          #pragma omp simd
+#else
+          #pragma simd
+#endif
+          #endif
+          for (int l = 0; l < INTEL_P3M_ALIGNED_MAXORDER; l++) {
+            flt_t x0 = y0*rho[0][l];
+            ekx_arr[l] -= x0*vx[l];
+            eky_arr[l] -= x0*vy[l];
+            ekz_arr[l] -= x0*vz[l];
+          }
+        }
+      }
+
+      acc_t ekx, eky, ekz;
+      ekx = eky = ekz = 0.0;
+
+      for (int l = 0; l < order; l++) {
+        ekx += ekx_arr[l];
+        eky += eky_arr[l];
+        ekz += ekz_arr[l];
+      }
+
+      // convert E-field to force
+
+      const double qfactor = qqrd2es * q[i];
+      f[i][0] += qfactor*ekx;
+      f[i][1] += qfactor*eky;
+      if (slabflag != 2) f[i][2] += qfactor*ekz;
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   interpolate from grid to get electric field & force on my particles for ad
+------------------------------------------------------------------------- */
+
+template<class flt_t, class acc_t>
+void PPPSIntel::fieldforce_ad()
+{
+  // loop over my charges, interpolate electric field from nearby grid points
+  // (nx,ny,nz) = global coords of grid pt to "lower left" of charge
+  // (dx,dy,dz) = distance to "lower left" grid pt
+  // (mx,my,mz) = global coords of moving stencil pt
+  // ek = 3 components of E-field on particle
+
+  double **x = atom->x;
+  double *q = atom->q;
+  double **f = atom->f;
+  int nlocal = atom->nlocal;
+  int nthr = comm->nthreads;
+
+  #if defined(_OPENMP)
+  #pragma omp parallel LMP_DEFAULT_NONE shared(nlocal, nthr, x, q, f)
+  #endif
+  {
+    const double lo0 = boxlo[0];
+    const double lo1 = boxlo[1];
+    const double lo2 = boxlo[2];
+    const double qqrd2es = qqrd2e * scale;
+
+    const double *prd = domain->prd;
+    const double hx_inv = nx_pppm/prd[0];
+    const double hy_inv = ny_pppm/prd[1];
+    const double hz_inv = nz_pppm/prd[2];
+
+    int ifrom, ito, tid;
+    IP_PRE_omp_range_id(ifrom, ito, tid, nlocal, nthr);
+
+    _alignvar(flt_t rho[3][INTEL_P3M_ALIGNED_MAXORDER], 64) = {{0}};
+    _alignvar(flt_t drho[3][INTEL_P3M_ALIGNED_MAXORDER], 64) = {{0}};
+
+    for (int i = ifrom; i < ito; i++) {
+      int nx = part2grid[i][0];
+      int ny = part2grid[i][1];
+      int nz = part2grid[i][2];
+
+      int nxsum = nx + nlower;
+      int nysum = ny + nlower;
+      int nzsum = nz + nlower;
+
+      FFT_SCALAR dx = nx+shiftone - (x[i][0]-lo0)*delxinv;
+      FFT_SCALAR dy = ny+shiftone - (x[i][1]-lo1)*delyinv;
+      FFT_SCALAR dz = nz+shiftone - (x[i][2]-lo2)*delzinv;
+
+      stencil_weights<flt_t>(rho,rho_coeff,rho_lookup,poly_order,dx,dy,dz);
+      stencil_weights<flt_t>(drho,drho_coeff,drho_lookup,poly_order-1,dx,dy,dz);
+
+      _alignvar(acc_t ekx_arr[INTEL_P3M_ALIGNED_MAXORDER], 64) = {0};
+      _alignvar(acc_t eky_arr[INTEL_P3M_ALIGNED_MAXORDER], 64) = {0};
+      _alignvar(acc_t ekz_arr[INTEL_P3M_ALIGNED_MAXORDER], 64) = {0};
+
+      #if defined(LMP_SIMD_COMPILER)
+      #pragma loop_count min(2), max(INTEL_P3M_ALIGNED_MAXORDER), avg(7)
+      #endif
+      for (int n = 0; n < order; n++) {
+        int mz = n + nzsum;
+        #if defined(LMP_SIMD_COMPILER)
+        #pragma loop_count min(2), max(INTEL_P3M_ALIGNED_MAXORDER), avg(7)
+        #endif
+        for (int m = 0; m < order; m++) {
+          int my = m + nysum;
+          flt_t ekx_p = rho[1][m] * rho[2][n];
+          flt_t eky_p = drho[1][m] * rho[2][n];
+          flt_t ekz_p = rho[1][m] * drho[2][n];
+          const FFT_SCALAR * _noalias const u = &u_brick[mz][my][nxsum];
+          #if defined(LMP_SIMD_COMPILER)
+#if defined(USE_OMP_SIMD)
+          #pragma omp simd
+#else
+          #pragma simd
+#endif
+          #endif
+          for (int l = 0; l < INTEL_P3M_ALIGNED_MAXORDER; l++) {
+            ekx_arr[l] += drho[0][l] * ekx_p * u[l];
+            eky_arr[l] +=  rho[0][l] * eky_p * u[l];
+            ekz_arr[l] +=  rho[0][l] * ekz_p * u[l];
+          }
+        }
+      }
+
+      acc_t ekx, eky, ekz;
+      ekx = eky = ekz = 0.0;
+
+      for (int l = 0; l < order; l++) {
+        ekx += ekx_arr[l];
+        eky += eky_arr[l];
+        ekz += ekz_arr[l];
+      }
+      ekx *= hx_inv;
+      eky *= hy_inv;
+      ekz *= hz_inv;
+
+      // convert E-field to force and subtract self forces
+
+      const double twoqsq = 2.0 * q[i] * q[i];
+
+      const double s1 = x[i][0] * hx_inv;
+      const double s2 = x[i][1] * hy_inv;
+      const double s3 = x[i][2] * hz_inv;
+      double sf = sf_coeff[0] * sin(MY_2PI * s1);
+      sf += sf_coeff[1] * sin(2.0 * MY_2PI * s1);
+      sf *= twoqsq;
+      f[i][0] += qqrd2es * (ekx * q[i] - sf);
+
+      sf = sf_coeff[2] * sin(MY_2PI * s2);
+      sf += sf_coeff[3] * sin(2.0 * MY_2PI * s2);
+      sf *= twoqsq;
+      f[i][1] += qqrd2es * (eky * q[i] - sf);
+
+      sf = sf_coeff[4] * sin(MY_2PI * s3);
+      sf += sf_coeff[5] * sin(2.0 * MY_2PI * s3);
+      sf *= twoqsq;
+      if (slabflag != 2) f[i][2] += qqrd2es * (ekz * q[i] - sf);
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   memory usage of local arrays
+------------------------------------------------------------------------- */
+
+double PPPSIntel::memory_usage()
+{
+  double bytes = PPPS::memory_usage();
+  if (comm->nthreads > 1)
+    bytes += (double)(comm->nthreads - 1) * (ngrid + INTEL_P3M_ALIGNED_MAXORDER) *
+      sizeof(FFT_SCALAR);
+  return bytes;
+}
+
+/* ----------------------------------------------------------------------
+   Allocate density_brick with extra padding for vector writes
+   per-thread densities depend on ngrid and are reallocated with it
+------------------------------------------------------------------------- */
+
+void PPPSIntel::allocate()
+{
+  PPPS::allocate();
+  memory->destroy3d_offset(density_brick,nzlo_out,nylo_out,nxlo_out);
+  create3d_offset(density_brick,nzlo_out,nzhi_out,nylo_out,nyhi_out,
+                  nxlo_out,nxhi_out,"pppm:density_brick");
+
+  if (differentiation_flag == 1) {
+    memory->destroy3d_offset(u_brick,nzlo_out,nylo_out,nxlo_out);
+    create3d_offset(u_brick,nzlo_out,nzhi_out,nylo_out,nyhi_out,
+                    nxlo_out,nxhi_out,"pppm:u_brick");
+  } else {
+    memory->destroy3d_offset(vdx_brick,nzlo_out,nylo_out,nxlo_out);
+    memory->destroy3d_offset(vdy_brick,nzlo_out,nylo_out,nxlo_out);
+    memory->destroy3d_offset(vdz_brick,nzlo_out,nylo_out,nxlo_out);
+    create3d_offset(vdx_brick,nzlo_out,nzhi_out,nylo_out,nyhi_out,
+                    nxlo_out,nxhi_out,"pppm:vdx_brick");
+    create3d_offset(vdy_brick,nzlo_out,nzhi_out,nylo_out,nyhi_out,
+                    nxlo_out,nxhi_out,"pppm:vdy_brick");
+    create3d_offset(vdz_brick,nzlo_out,nzhi_out,nylo_out,nyhi_out,
+                    nxlo_out,nxhi_out,"pppm:vdz_brick");
+  }
+
+  memory->destroy(perthread_density);
+  if (comm->nthreads > 1)
+    memory->create(perthread_density, comm->nthreads-1,
+                   ngrid + INTEL_P3M_ALIGNED_MAXORDER,
+                   "pppsintel:perthread_density");
+}
+
+/* ----------------------------------------------------------------------
+   Create 3D-offset allocation with extra padding for vector writes
+   the padding is zeroed so that padded reads past the last row are finite
+------------------------------------------------------------------------- */
+
+FFT_SCALAR *** PPPSIntel::create3d_offset(FFT_SCALAR ***&array, int n1lo,
+                                          int n1hi, int n2lo, int n2hi,
+                                          int n3lo, int n3hi,
+                                          const char *name)
+{
+  int n1 = n1hi - n1lo + 1;
+  int n2 = n2hi - n2lo + 1;
+  int n3 = n3hi - n3lo + 1;
+
+  bigint ndata = ((bigint) n1) * n2 * n3;
+  bigint nbytes = ((bigint) sizeof(FFT_SCALAR)) * (ndata + INTEL_P3M_ALIGNED_MAXORDER);
+  auto data = (FFT_SCALAR *) memory->smalloc(nbytes,name);
+  memset(data + ndata, 0, INTEL_P3M_ALIGNED_MAXORDER * sizeof(FFT_SCALAR));
+  nbytes = ((bigint) sizeof(FFT_SCALAR *)) * n1*n2;
+  auto plane = (FFT_SCALAR **) memory->smalloc(nbytes,name);
+  nbytes = ((bigint) sizeof(FFT_SCALAR **)) * n1;
+  array = (FFT_SCALAR ***) memory->smalloc(nbytes,name);
+
+  bigint m;
+  bigint n = 0;
+  for (int i = 0; i < n1; i++) {
+    m = ((bigint) i) * n2;
+    array[i] = &plane[m];
+    for (int j = 0; j < n2; j++) {
+      plane[m+j] = &data[n];
+      n += n3;
+    }
+  }
+
+  m = ((bigint) n1) * n2;
+  for (bigint i = 0; i < m; i++) array[0][i] -= n3lo;
+  for (int i = 0; i < n1; i++) array[i] -= n2lo;
+  array -= n1lo;
+  return array;
+}
@@ -0,0 +1,61 @@
+// clang-format off
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef KSPACE_CLASS
+// clang-format off
+KSpaceStyle(ppps/intel,PPPSIntel);
+// clang-format on
+#else
+
+#ifndef LMP_PPPS_INTEL_H
+#define LMP_PPPS_INTEL_H
+
+#include "fix_intel.h"
+#include "ppps.h"
+
+namespace LAMMPS_NS {
+
+class PPPSIntel : public PPPS {
+ public:
+  PPPSIntel(class LAMMPS *);
+  ~PPPSIntel() override;
+  void init() override;
+  double memory_usage() override;
+
+ protected:
+  FixIntel *fix;
+
+  FFT_SCALAR **perthread_density;
+
+  void allocate() override;
+
+  void particle_map() override;
+  void make_rho() override;
+  void fieldforce_ik() override;
+  void fieldforce_ad() override;
+
+  template <class flt_t, class acc_t> void make_rho();
+  template <class flt_t, class acc_t> void fieldforce_ik();
+  template <class flt_t, class acc_t> void fieldforce_ad();
+  template <class flt_t>
+  void stencil_weights(flt_t (*)[INTEL_P3M_ALIGNED_MAXORDER], FFT_SCALAR *const *,
+                       FFT_SCALAR *const *, int, FFT_SCALAR, FFT_SCALAR, FFT_SCALAR);
+
+  FFT_SCALAR ***create3d_offset(FFT_SCALAR ***&, int, int, int, int, int, int, const char *name);
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
+#endif
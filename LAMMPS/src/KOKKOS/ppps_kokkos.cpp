@@ -0,0 +1,1806 @@
+// clang-format off
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+/* ----------------------------------------------------------------------
+   Kokkos version of PPPS, adapted from PPPMKokkos
+------------------------------------------------------------------------- */
+
+#include "ppps_kokkos.h"
+
+#include "atom_kokkos.h"
+#include "atom_masks.h"
+#include "comm.h"
+#include "domain.h"
+#include "error.h"
+#include "fft3d_kokkos.h"
+#include "force.h"
+#include "grid3d_kokkos.h"
+#include "kokkos.h"
+#include "math_const.h"
+#include "memory_kokkos.h"
+#include "neighbor.h"
+#include "remap_kokkos.h"
+#include "timer.h"
+#include "update.h"
+
+#include <cmath>
+
+using namespace LAMMPS_NS;
+using namespace MathConst;
+
+static constexpr int OFFSET = 16384;
+static constexpr double SMALL = 0.00001;
+static constexpr FFT_SCALAR ZEROF = 0.0;
+
+/* ---------------------------------------------------------------------- */
+
+template<class DeviceType>
+PPPSKokkos<DeviceType>::PPPSKokkos(LAMMPS *lmp) : PPPS(lmp)
+{
+  atomKK = (AtomKokkos *) atom;
+  execution_space = ExecutionSpaceFromDevice<DeviceType>::space;
+  datamask_read = X_MASK | F_MASK | TYPE_MASK | Q_MASK;
+  datamask_modify = F_MASK;
+
+  group_group_enable = 0;
+  triclinic_support = 0;
+
+  // the FFT3dKokkos wrapper only does complex-to-complex FFTs
+
+  r2c_flag = 0;
+
+  k_flag = DAT::tdual_int_scalar("PPPS:flag");
+
+  // same name but different than base class
+
+  gc = nullptr;
+  fft1 = nullptr;
+  fft2 = nullptr;
+  remap = nullptr;
+
+#if defined (LMP_KOKKOS_GPU)
+  #if defined(FFT_KOKKOS_KISS)
+    if (comm->me == 0)
+      error->warning(FLERR,"Using default KISS FFT with Kokkos GPU backends may give suboptimal performance");
+  #endif
+#endif
+}
+
+/* ----------------------------------------------------------------------
+   free all memory
+------------------------------------------------------------------------- */
+
+template<class DeviceType>
+PPPSKokkos<DeviceType>::~PPPSKokkos()
+{
+  if (copymode) return;
+
+  deallocate();
+  if (peratom_allocate_flag) deallocate_peratom();
+
+  memoryKK->destroy_kokkos(k_eatom,eatom);
+  memoryKK->destroy_kokkos(k_vatom,vatom);
+}
+
+/* ----------------------------------------------------------------------
+   called once before run
+------------------------------------------------------------------------- */
+
+template<class DeviceType>
+void PPPSKokkos<DeviceType>::init()
+{
+  // error check
+
+  if (differentiation_flag == 1)
+    error->all(FLERR,"Cannot (yet) use PPPS Kokkos with 'kspace_modify diff ad'");
+  if (domain->triclinic)
+    error->all(FLERR,"Cannot (yet) use PPPS Kokkos with triclinic box");
+  if (r2c_flag)
+    error->all(FLERR,"Cannot (yet) use PPPS Kokkos with 'kspace_modify fft/r2c yes'");
+  if (tip4pflag)
+    error->all(FLERR,"Cannot (yet) use PPPS Kokkos TIP4P");
+
+  // host-side spreading options have no Kokkos kernels,
+  //   the spreading weights of make_rho() are always reused by fieldforce()
+
+  if (rho_table_flag || sort_block || rho_cache_max || !vg_store_flag) {
+    if (me == 0)
+      error->warning(FLERR,"Kspace_modify spread/table, sort, spread/cache and "
+                     "virial/store are ignored by PPPS Kokkos");
+    rho_table_flag = 0;
+    sort_block = 0;
+    rho_cache_max = 0;
+    vg_store_flag = 1;
+  }
+
+  // the device stencil evaluates global spreading polynomials,
+  //   piecewise real space kernels of the pair style are supported
+
+  if (rho_pieces > 1) {
+    if (me == 0)
+      error->warning(FLERR,"Kspace_modify pieces applies to the real space kernels only "
+                     "with PPPS Kokkos");
+    rho_pieces = 1;
+  }
+
+  PPPS::init();
+}
+
+/* ----------------------------------------------------------------------
+   adjust PPPS coeffs, called initially and whenever volume has changed
+   the Green's function is computed on the host and copied to the device
+------------------------------------------------------------------------- */
+
+template<class DeviceType>
+void PPPSKokkos<DeviceType>::setup()
+{
+  // perform some checks to avoid illegal boundaries with read_data
+
+  if (slabflag == 0 && domain->nonperiodic > 0)
+    error->all(FLERR,"Cannot use non-periodic boundaries with PPPM");
+  if (slabflag) {
+    if (domain->xperiodic != 1 || domain->yperiodic != 1 ||
+        domain->boundary[2][0] != 1 || domain->boundary[2][1] != 1)
+      error->all(FLERR,"Incorrect boundaries with slab PPPM");
+  }
+
+  // volume-dependent factors
+  // adjust z dimension for 2d slab PPPM
+  // z dimension for 3d PPPM is zprd since slab_volfactor = 1.0
+
+  double *prd = domain->prd;
+
+  double xprd = prd[0];
+  double yprd = prd[1];
+  double zprd = prd[2];
+  zprd_slab = zprd*slab_volfactor;
+  volume = xprd * yprd * zprd_slab;
+
+  delxinv = nx_pppm/xprd;
+  delyinv = ny_pppm/yprd;
+  delzinv = nz_pppm/zprd_slab;
+
+  delvolinv = delxinv*delyinv*delzinv;
+
+  unitkx = (MY_2PI/xprd);
+  unitky = (MY_2PI/yprd);
+  unitkz = (MY_2PI/zprd_slab);
+
+  // d_fkx,d_fky,d_fkz for my FFT grid pts
+
+  copymode = 1;
+  Kokkos::parallel_for(Kokkos::RangePolicy<DeviceType, TagPPPS_setup1>(nxlo_fft,nxhi_fft+1),*this);
+  copymode = 0;
+
+  copymode = 1;
+  Kokkos::parallel_for(Kokkos::RangePolicy<DeviceType, TagPPPS_setup2>(nylo_fft,nyhi_fft+1),*this);
+  copymode = 0;
+
+  copymode = 1;
+  Kokkos::parallel_for(Kokkos::RangePolicy<DeviceType, TagPPPS_setup3>(nzlo_fft,nzhi_fft+1),*this);
+  copymode = 0;
+
+  // merge three outer loops into one for better threading
+
+  numz_fft = nzhi_fft-nzlo_fft + 1;
+  numy_fft = nyhi_fft-nylo_fft + 1;
+  numx_fft = nxhi_fft-nxlo_fft + 1;
+  const int inum_fft = numz_fft*numy_fft*numx_fft;
+
+  copymode = 1;
+  Kokkos::parallel_for(Kokkos::RangePolicy<DeviceType, TagPPPS_setup4>(0,inum_fft),*this);
+  copymode = 0;
+
+  // spreading coefficients may have changed with init() or reset_grid()
+
+  copy_rho_coeff();
+
+  // Green's function, rebuilt or rescaled on the host
+
+  setup_gf(prd);
+
+  k_greensfn.template modify<LMPHostType>();
+  k_greensfn.template sync<DeviceType>();
+  k_greensfn2.template modify<LMPHostType>();
+  k_greensfn2.template sync<DeviceType>();
+}
+
+template<class DeviceType>
+KOKKOS_INLINE_FUNCTION
+void PPPSKokkos<DeviceType>::operator()(TagPPPS_setup1, const int &i) const
+{
+  double per = i - nx_pppm*(2*i/nx_pppm);
+  d_fkx[i-nxlo_fft] = unitkx*per;
+}
+
+template<class DeviceType>
+KOKKOS_INLINE_FUNCTION
+void PPPSKokkos<DeviceType>::operator()(TagPPPS_setup2, const int &i) const
+{
+  double per = i - ny_pppm*(2*i/ny_pppm);
+  d_fky[i-nylo_fft] = unitky*per;
+}
+
+template<class DeviceType>
+KOKKOS_INLINE_FUNCTION
+void PPPSKokkos<DeviceType>::operator()(TagPPPS_setup3, const int &i) const
+{
+  double per = i - nz_pppm*(2*i/nz_pppm);
+  d_fkz[i-nzlo_fft] = unitkz*per;
+}
+
+template<class DeviceType>
+KOKKOS_INLINE_FUNCTION
+void PPPSKokkos<DeviceType>::operator()(TagPPPS_setup4, const int &n) const
+{
+  const int k = n/(numy_fft*numx_fft);
+  const int j = (n - k*numy_fft*numx_fft) / numx_fft;
+  const int i = n - k*numy_fft*numx_fft - j*numx_fft;
+  const double sqk = d_fkx[i]*d_fkx[i] + d_fky[j]*d_fky[j] + d_fkz[k]*d_fkz[k];
+  if (sqk == 0.0) {
+    for (int d = 0; d < 6; d++) d_vg(n,d) = d_vg2(n,d) = 0.0;
+  } else {
+    d_vg2(n,0) = d_fkx[i]*d_fkx[i];
+    d_vg2(n,1) = d_fky[j]*d_fky[j];
+    d_vg2(n,2) = d_fkz[k]*d_fkz[k];
+    d_vg2(n,3) = d_fkx[i]*d_fky[j];
+    d_vg2(n,4) = d_fkx[i]*d_fkz[k];
+    d_vg2(n,5) = d_fky[j]*d_fkz[k];
+    const double vterm = -2.0 / sqk;
+    d_vg(n,0) = 1.0 + vterm*d_vg2(n,0);
+    d_vg(n,1) = 1.0 + vterm*d_vg2(n,1);
+    d_vg(n,2) = 1.0 + vterm*d_vg2(n,2);
+    d_vg(n,3) = vterm*d_vg2(n,3);
+    d_vg(n,4) = vterm*d_vg2(n,4);
+    d_vg(n,5) = vterm*d_vg2(n,5);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   reset local grid arrays and communication stencils
+   called by fix balance b/c it changed sizes of processor sub-domains
+------------------------------------------------------------------------- */
+
+template<class DeviceType>
+void PPPSKokkos<DeviceType>::reset_grid()
+{
+  // free all arrays previously allocated
+
+  deallocate();
+  if (peratom_allocate_flag) deallocate_peratom();
+
+  // reset portion of global grid that each proc owns
+
+  set_grid_local();
+
+  // reallocate K-space dependent memory
+  // check if grid communication is now overlapping if not allowed
+  // don't invoke allocate peratom(), will be allocated when needed
+
+  allocate();
+
+  if (!overlap_allowed && !gc->ghost_adjacent())
+    error->all(FLERR,"PPPM grid stencil extends beyond nearest neighbor processor");
+
+  // pre-compute Green's function denomiator expansion
+  // pre-compute 1d charge distribution coefficients
+
+  compute_gf_denom();
+  compute_rho_coeff();
+  gf_cache_flag = 1;
+  gf_ref_flag = 0;
+
+  // pre-compute volume-dependent coeffs for portion of grid I now own
+
+  setup();
+}
+
+/* ----------------------------------------------------------------------
+   compute the PPPS long-range force, energy, virial
+------------------------------------------------------------------------- */
+
+template<class DeviceType>
+void PPPSKokkos<DeviceType>::compute(int eflag, int vflag)
+{
+  int i;
+
+  // set energy/virial flags
+  // invoke allocate_peratom() if needed for first time
+
+  ev_init(eflag,vflag,0);
+
+  // reallocate per-atom arrays if necessary
+
+  if (eflag_atom) {
+    memoryKK->destroy_kokkos(k_eatom,eatom);
+    memoryKK->create_kokkos(k_eatom,eatom,maxeatom,"pair:eatom");
+    d_eatom = k_eatom.view<DeviceType>();
+  }
+  if (vflag_atom) {
+    memoryKK->destroy_kokkos(k_vatom,vatom);
+    memoryKK->create_kokkos(k_vatom,vatom,maxvatom,"pair:vatom");
+    d_vatom = k_vatom.view<DeviceType>();
+  }
+
+  if (evflag_atom && !peratom_allocate_flag)
+    allocate_peratom();
+
+  x = atomKK->k_x.view<DeviceType>();
+  f = atomKK->k_f.view<DeviceType>();
+  q = atomKK->k_q.view<DeviceType>();
+
+  // if atom count has changed, update qsum and qsqsum
+
+  if (atom->natoms != natoms_original) {
+    qsum_qsq();
+    natoms_original = atom->natoms;
+  }
+
+  // return if there are no charges
+
+  if (qsqsum == 0.0) return;
+
+  // time the phases with the normal Timer level, see PPPS::compute()
+
+  phase_flag = timer->has_normal();
+  if (update->ntimestep == update->firststep) {
+    for (i = 0; i < NPHASE; i++) phase_time[i] = 0.0;
+    phase_flag = 0;
+  }
+  if (phase_flag) phase_last = platform::walltime();
+
+  boxlo[0] = domain->boxlo[0];
+  boxlo[1] = domain->boxlo[1];
+  boxlo[2] = domain->boxlo[2];
+
+  // extend size of per-atom arrays if necessary
+
+  if (atom->nmax > nmax) {
+    nmax = atomKK->nmax;
+    d_part2grid = typename AT::t_int_1d_3("ppps:part2grid",nmax);
+    d_rho1d = typename FFT_AT::t_FFT_SCALAR_2d_3("ppps:rho1d",nmax,order/2+order/2+1);
+  }
+
+  // find grid points for all my particles
+  // map my particle charge onto my local 3d density grid
+
+  particle_map();
+  phase_stamp_kk(PHASE_MAP);
+  make_rho();
+  phase_stamp_kk(PHASE_RHO);
+
+  // all procs communicate density values from their ghost cells
+  //   to fully sum contribution in their 3d bricks
+  // remap from 3d decomposition to FFT decomposition
+
+  gc->reverse_comm(Grid3d::KSPACE,this,REVERSE_RHO,1,sizeof(FFT_SCALAR),
+                   k_gc_buf1,k_gc_buf2,MPI_FFT_SCALAR);
+  phase_stamp_kk(PHASE_REVCOMM);
+  brick2fft();
+  phase_stamp_kk(PHASE_REMAP);
+
+  // compute potential gradient on my FFT grid and
+  //   portion of e_long on this proc's FFT grid
+  // return gradients (electric fields) in 3d brick decomposition
+  // also performs per-atom calculations via poisson_peratom()
+
+  poisson();
+  phase_stamp_kk(PHASE_IFFT);
+
+  // all procs communicate E-field values
+  // to fill ghost cells surrounding their 3d bricks
+
+  gc->forward_comm(Grid3d::KSPACE,this,FORWARD_IK,3,sizeof(FFT_SCALAR),
+                   k_gc_buf1,k_gc_buf2,MPI_FFT_SCALAR);
+
+  // extra per-atom energy/virial communication
+
+  if (evflag_atom)
+    gc->forward_comm(Grid3d::KSPACE,this,FORWARD_IK_PERATOM,7,sizeof(FFT_SCALAR),
+                     k_gc_buf1,k_gc_buf2,MPI_FFT_SCALAR);
+  phase_stamp_kk(PHASE_FWDCOMM);
+
+  // calculate the force on my particles
+
+  fieldforce();
+
+  // extra per-atom energy/virial communication
+
+  if (evflag_atom) fieldforce_peratom();
+  phase_stamp_kk(PHASE_FIELD);
+
+  // sum global energy across procs and add in volume-dependent term
+
+  qscale = qqrd2e * scale;
+  self_scale = 0.5 * self_coeff/cutoff;
+
+  if (eflag_global) {
+    double energy_all;
+    MPI_Allreduce(&energy,&energy_all,1,MPI_DOUBLE,MPI_SUM,world);
+    energy = energy_all;
+
+    energy *= 0.5*volume;
+    energy -= self_scale * qsqsum;
+    energy *= qscale;
+  }
+
+  // sum global virial across procs
+
+  if (vflag_global) {
+    double virial_all[6];
+    MPI_Allreduce(virial,virial_all,6,MPI_DOUBLE,MPI_SUM,world);
+    for (i = 0; i < 6; i++) virial[i] = 0.5*qscale*volume*virial_all[i];
+  }
+
+  // per-atom energy/virial
+  // energy includes the PSWF self-energy correction
+
+  if (evflag_atom) {
+    int nlocal = atomKK->nlocal;
+
+    if (eflag_atom) {
+      copymode = 1;
+      Kokkos::parallel_for(Kokkos::RangePolicy<DeviceType, TagPPPS_self1>(0,nlocal),*this);
+      copymode = 0;
+    }
+
+    if (vflag_atom) {
+      copymode = 1;
+      Kokkos::parallel_for(Kokkos::RangePolicy<DeviceType, TagPPPS_self2>(0,nlocal),*this);
+      copymode = 0;
+    }
+  }
+
+  // 2d slab correction
+
+  if (slabflag == 1) slabcorr();
+
+  if (eflag_atom) {
+    k_eatom.template modify<DeviceType>();
+    k_eatom.template sync<LMPHostType>();
+  }
+
+  if (vflag_atom) {
+    k_vatom.template modify<DeviceType>();
+    k_vatom.template sync<LMPHostType>();
+  }
+}
+
+template<class DeviceType>
+KOKKOS_INLINE_FUNCTION
+void PPPSKokkos<DeviceType>::operator()(TagPPPS_self1, const int &i) const
+{
+  d_eatom[i] *= 0.5;
+  d_eatom[i] -= self_scale*q[i]*q[i];
+  d_eatom[i] *= qscale;
+}
+
+template<class DeviceType>
+KOKKOS_INLINE_FUNCTION
+void PPPSKokkos<DeviceType>::operator()(TagPPPS_self2, const int &i) const
+{
+  for (int j = 0; j < 6; j++) d_vatom(i,j) *= 0.5*qscale;
+}
+
+/* ----------------------------------------------------------------------
+   allocate memory that depends on # of K-vectors and order
+------------------------------------------------------------------------- */
+
+template<class DeviceType>
+void PPPSKokkos<DeviceType>::allocate()
+{
+  // PPPS::init() leaves the base class pointer at its deleted test grid
+
+  PPPS::gc = nullptr;
+
+  // create ghost grid object for rho and electric field communication
+  // returns local owned and ghost grid bounds
+  // setup communication patterns and buffers
+
+  gc = new Grid3dKokkos<DeviceType>(lmp,world,nx_pppm,ny_pppm,nz_pppm);
+  gc->set_distance(0.5*neighbor->skin + qdist);
+  gc->set_stencil_atom(-nlower,nupper);
+  gc->set_shift_atom(shiftatom_lo,shiftatom_hi);
+  gc->set_zfactor(slab_volfactor);
+
+  gc->setup_grid(nxlo_in,nxhi_in,nylo_in,nyhi_in,nzlo_in,nzhi_in,
+                 nxlo_out,nxhi_out,nylo_out,nyhi_out,nzlo_out,nzhi_out);
+
+  gc->setup_comm(ngc_buf1,ngc_buf2);
+
+  npergrid = 3;
+
+  k_gc_buf1 = FFT_DAT::tdual_FFT_SCALAR_1d("ppps:gc_buf1",npergrid*ngc_buf1);
+  k_gc_buf2 = FFT_DAT::tdual_FFT_SCALAR_1d("ppps:gc_buf2",npergrid*ngc_buf2);
+
+  // tally local grid sizes
+  // ngrid = count of owned+ghost grid cells on this proc
+  // nfft_brick = FFT points in 3d brick-decomposition on this proc
+  //              same as count of owned grid cells
+  // nfft = FFT points in x-pencil FFT decomposition on this proc
+  // nfft_both = greater of nfft and nfft_brick
+
+  ngrid = (nxhi_out-nxlo_out+1) * (nyhi_out-nylo_out+1) *
+    (nzhi_out-nzlo_out+1);
+
+  nfft_brick = (nxhi_in-nxlo_in+1) * (nyhi_in-nylo_in+1) *
+    (nzhi_in-nzlo_in+1);
+
+  nfft = (nxhi_fft-nxlo_fft+1) * (nyhi_fft-nylo_fft+1) *
+    (nzhi_fft-nzlo_fft+1);
+
+  nfft_both = MAX(nfft,nfft_brick);
+
+  // allocate distributed grid data
+
+  d_density_brick = typename FFT_AT::t_FFT_SCALAR_3d("ppps:density_brick",nzhi_out-nzlo_out+1,nyhi_out-nylo_out+1,nxhi_out-nxlo_out+1);
+
+  memoryKK->create_kokkos(k_density_fft,density_fft,nfft_both,"ppps:d_density_fft");
+  d_density_fft = k_density_fft.view<DeviceType>();
+
+  // greensfn and greensfn2 are the host views, filled by PPPS::compute_gf() and rescale_gf()
+
+  memoryKK->create_kokkos(k_greensfn,greensfn,nfft_both,"ppps:greensfn");
+  d_greensfn = k_greensfn.view<DeviceType>();
+  memoryKK->create_kokkos(k_greensfn2,greensfn2,nfft_both,"ppps:greensfn2");
+  d_greensfn2 = k_greensfn2.view<DeviceType>();
+  memoryKK->create_kokkos(k_work1,work1,2*nfft_both,"ppps:work1");
+  memoryKK->create_kokkos(k_work2,work2,2*nfft_both,"ppps:work2");
+  d_work1 = k_work1.view<DeviceType>();
+  d_work2 = k_work2.view<DeviceType>();
+  d_vg = typename AT::t_virial_array("ppps:vg",nfft_both);
+  d_vg2 = typename AT::t_virial_array("ppps:vg2",nfft_both);
+
+  d_fkx = typename AT::t_float_1d("ppps:d_fkx",nxhi_fft-nxlo_fft+1);
+  d_fky = typename AT::t_float_1d("ppps:d_fky",nyhi_fft-nylo_fft+1);
+  d_fkz = typename AT::t_float_1d("ppps:d_fkz",nzhi_fft-nzlo_fft+1);
+
+  d_vdx_brick = typename FFT_AT::t_FFT_SCALAR_3d("ppps:d_vdx_brick",nzhi_out-nzlo_out+1,nyhi_out-nylo_out+1,nxhi_out-nxlo_out+1);
+  d_vdy_brick = typename FFT_AT::t_FFT_SCALAR_3d("ppps:d_vdy_brick",nzhi_out-nzlo_out+1,nyhi_out-nylo_out+1,nxhi_out-nxlo_out+1);
+  d_vdz_brick = typename FFT_AT::t_FFT_SCALAR_3d("ppps:d_vdz_brick",nzhi_out-nzlo_out+1,nyhi_out-nylo_out+1,nxhi_out-nxlo_out+1);
+
+  // summation coeffs
+  // host gf_b and rho_coeff are filled by PPPS::compute_gf_denom() and compute_rho_coeff()
+
+  order_allocated = order;
+  memory->create(gf_b,order,"ppps:gf_b");
+  memory->create2d_offset(rho_coeff,poly_order,(1-order)/2,order/2,"ppps:rho_coeff");
+  memory->create2d_offset(drho_coeff,poly_order,(1-order)/2,order/2,"ppps:drho_coeff");
+  d_rho1d = typename FFT_AT::t_FFT_SCALAR_2d_3("ppps:rho1d",nmax,order/2+order/2+1);
+  k_rho_coeff = FFT_DAT::tdual_FFT_SCALAR_2d("ppps:rho_coeff",poly_order,order/2-(1-order)/2+1);
+  d_rho_coeff = k_rho_coeff.view<DeviceType>();
+
+  // create 2 FFTs and a Remap
+  // 1st FFT keeps data in FFT decomposition
+  // 2nd FFT returns data in 3d brick decomposition
+  // remap takes data from 3d brick to FFT decomposition
+
+  int collective_flag = force->kspace->collective_flag;
+  int gpu_aware_flag = lmp->kokkos->gpu_aware_flag;
+  int tmp;
+
+  fft1 = new FFT3dKokkos<DeviceType>(lmp,world,nx_pppm,ny_pppm,nz_pppm,
+                         nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
+                         nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
+                         0,0,&tmp,collective_flag,gpu_aware_flag);
+
+  fft2 = new FFT3dKokkos<DeviceType>(lmp,world,nx_pppm,ny_pppm,nz_pppm,
+                         nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
+                         nxlo_in,nxhi_in,nylo_in,nyhi_in,nzlo_in,nzhi_in,
+                         0,0,&tmp,collective_flag,gpu_aware_flag);
+  remap = new RemapKokkos<DeviceType>(lmp,world,
+                          nxlo_in,nxhi_in,nylo_in,nyhi_in,nzlo_in,nzhi_in,
+                          nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
+                          1,0,0,FFT_PRECISION,collective_flag,gpu_aware_flag);
+}
+
+/* ----------------------------------------------------------------------
+   deallocate memory that depends on # of K-vectors and order
+   base class pointers are reset, so ~PPPS() finds nothing left to free
+------------------------------------------------------------------------- */
+
+template<class DeviceType>
+void PPPSKokkos<DeviceType>::deallocate()
+{
+  delete gc;
+  gc = nullptr;
+
+  memoryKK->destroy_kokkos(k_density_fft,density_fft);
+  memoryKK->destroy_kokkos(k_greensfn,greensfn);
+  memoryKK->destroy_kokkos(k_greensfn2,greensfn2);
+  memoryKK->destroy_kokkos(k_work1,work1);
+  memoryKK->destroy_kokkos(k_work2,work2);
+
+  memory->destroy(gf_b);
+  for (int d = 0; d < 3; d++) {
+    memory->destroy(gf_denom1d[d]);
+    memory->destroy(gf_w1d[d]);
+    memory->destroy(gf_alt1d[d]);
+  }
+  memory->destroy2d_offset(rho_coeff,(1-order_allocated)/2);
+  memory->destroy2d_offset(drho_coeff,(1-order_allocated)/2);
+
+  delete fft1;
+  fft1 = nullptr;
+  delete fft2;
+  fft2 = nullptr;
+  delete remap;
+  remap = nullptr;
+}
+
+/* ----------------------------------------------------------------------
+   allocate per-atom memory that depends on # of K-vectors and order
+------------------------------------------------------------------------- */
+
+template<class DeviceType>
+void PPPSKokkos<DeviceType>::allocate_peratom()
+{
+  peratom_allocate_flag = 1;
+
+  d_u_brick = typename FFT_AT::t_FFT_SCALAR_3d("ppps:u_brick",nzhi_out-nzlo_out+1,nyhi_out-nylo_out+1,nxhi_out-nxlo_out+1);
+
+  d_v0_brick = typename FFT_AT::t_FFT_SCALAR_3d("ppps:d_v0_brick",nzhi_out-nzlo_out+1,nyhi_out-nylo_out+1,nxhi_out-nxlo_out+1);
+  d_v1_brick = typename FFT_AT::t_FFT_SCALAR_3d("ppps:d_v1_brick",nzhi_out-nzlo_out+1,nyhi_out-nylo_out+1,nxhi_out-nxlo_out+1);
+  d_v2_brick = typename FFT_AT::t_FFT_SCALAR_3d("ppps:d_v2_brick",nzhi_out-nzlo_out+1,nyhi_out-nylo_out+1,nxhi_out-nxlo_out+1);
+  d_v3_brick = typename FFT_AT::t_FFT_SCALAR_3d("ppps:d_v3_brick",nzhi_out-nzlo_out+1,nyhi_out-nylo_out+1,nxhi_out-nxlo_out+1);
+  d_v4_brick = typename FFT_AT::t_FFT_SCALAR_3d("ppps:d_v4_brick",nzhi_out-nzlo_out+1,nyhi_out-nylo_out+1,nxhi_out-nxlo_out+1);
+  d_v5_brick = typename FFT_AT::t_FFT_SCALAR_3d("ppps:d_v5_brick",nzhi_out-nzlo_out+1,nyhi_out-nylo_out+1,nxhi_out-nxlo_out+1);
+
+  // use same GC ghost grid object for peratom grid communication
+  // but need to reallocate a larger gc_buf1 and gc_buf2
+
+  npergrid = 7;
+
+  k_gc_buf1 = FFT_DAT::tdual_FFT_SCALAR_1d("ppps:gc_buf1",npergrid*ngc_buf1);
+  k_gc_buf2 = FFT_DAT::tdual_FFT_SCALAR_1d("ppps:gc_buf2",npergrid*ngc_buf2);
+}
+
+/* ----------------------------------------------------------------------
+   deallocate per-atom memory that depends on # of K-vectors and order
+------------------------------------------------------------------------- */
+
+template<class DeviceType>
+void PPPSKokkos<DeviceType>::deallocate_peratom()
+{
+  peratom_allocate_flag = 0;
+
+  d_u_brick = typename FFT_AT::t_FFT_SCALAR_3d();
+  d_v0_brick = d_v1_brick = d_v2_brick = typename FFT_AT::t_FFT_SCALAR_3d();
+  d_v3_brick = d_v4_brick = d_v5_brick = typename FFT_AT::t_FFT_SCALAR_3d();
+  d_vpa_brick = typename FFT_AT::t_FFT_SCALAR_3d();
+}
+
+/* ----------------------------------------------------------------------
+   set params which determine which owned and ghost cells this proc owns
+   also keep a copy of boxlo for the device kernels
+------------------------------------------------------------------------- */
+
+template<class DeviceType>
+void PPPSKokkos<DeviceType>::set_grid_local()
+{
+  PPPS::set_grid_local();
+
+  boxlo[0] = domain->boxlo[0];
+  boxlo[1] = domain->boxlo[1];
+  boxlo[2] = domain->boxlo[2];
+}
+
+/* ----------------------------------------------------------------------
+   copy the PSWF spreading coefficients of compute_rho_coeff() to the device
+   k_rho_coeff(l,k) = coefficient of dx^l for stencil point k+(1-order)/2
+------------------------------------------------------------------------- */
+
+template<class DeviceType>
+void PPPSKokkos<DeviceType>::copy_rho_coeff()
+{
+  const int klo = (1-order)/2;
+  for (int l = 0; l < poly_order; l++)
+    for (int k = klo; k <= order/2; k++)
+      k_rho_coeff.h_view(l,k-klo) = rho_coeff[l][k];
+
+  k_rho_coeff.template modify<LMPHostType>();
+  k_rho_coeff.template sync<DeviceType>();
+}
+
+/* ----------------------------------------------------------------------
+   find center grid pt for each of my particles
+   check that full stencil for the particle will fit in my 3d brick
+   store central grid pt indices in part2grid array
+------------------------------------------------------------------------- */
+
+template<class DeviceType>
+void PPPSKokkos<DeviceType>::particle_map()
+{
+  int nlocal = atomKK->nlocal;
+
+  k_flag.h_view() = 0;
+  k_flag.template modify<LMPHostType>();
+  k_flag.template sync<DeviceType>();
+
+  if (!std::isfinite(boxlo[0]) || !std::isfinite(boxlo[1]) || !std::isfinite(boxlo[2]))
+    error->one(FLERR,"Non-numeric box dimensions - simulation unstable");
+
+  copymode = 1;
+  Kokkos::parallel_for(Kokkos::RangePolicy<DeviceType, TagPPPS_particle_map>(0,nlocal),*this);
+  copymode = 0;
+
+  k_flag.template modify<DeviceType>();
+  k_flag.template sync<LMPHostType>();
+  if (k_flag.h_view()) error->one(FLERR,"Out of range atoms - cannot compute PPPM");
+}
+
+template<class DeviceType>
+KOKKOS_INLINE_FUNCTION
+void PPPSKokkos<DeviceType>::operator()(TagPPPS_particle_map, const int &i) const
+{
+  // (nx,ny,nz) = global coords of grid pt to "lower left" of charge
+  // current particle coord can be outside global and local box
+  // add/subtract OFFSET to avoid int(-0.75) = 0 when want it to be -1
+
+  const int nx = static_cast<int> ((x(i,0)-boxlo[0])*delxinv+shift) - OFFSET;
+  const int ny = static_cast<int> ((x(i,1)-boxlo[1])*delyinv+shift) - OFFSET;
+  const int nz = static_cast<int> ((x(i,2)-boxlo[2])*delzinv+shift) - OFFSET;
+
+  d_part2grid(i,0) = nx;
+  d_part2grid(i,1) = ny;
+  d_part2grid(i,2) = nz;
+
+  // check that entire stencil around nx,ny,nz will fit in my 3d brick
+
+  if (nx+nlower < nxlo_out || nx+nupper > nxhi_out ||
+      ny+nlower < nylo_out || ny+nupper > nyhi_out ||
+      nz+nlower < nzlo_out || nz+nupper > nzhi_out)
+    k_flag.view<DeviceType>()() = 1;
+}
+
+/* ----------------------------------------------------------------------
+   create discretized "density" on section of global grid due to my particles
+   density(x,y,z) = charge "density" at grid points of my 3d brick
+   (nxlo:nxhi,nylo:nyhi,nzlo:nzhi) is extent of my brick (including ghosts)
+   in global grid
+   the spreading weights are kept in d_rho1d for fieldforce_ik()
+------------------------------------------------------------------------- */
+
+template<class DeviceType>
+void PPPSKokkos<DeviceType>::make_rho()
+{
+  // clear 3d density array
+
+  numz_out = nzhi_out-nzlo_out + 1;
+  numy_out = nyhi_out-nylo_out + 1;
+  numx_out = nxhi_out-nxlo_out + 1;
+  const int inum_out = numz_out*numy_out*numx_out;
+
+  copymode = 1;
+  Kokkos::parallel_for(Kokkos::RangePolicy<DeviceType, TagPPPS_make_rho_zero>(0,inum_out),*this);
+  copymode = 0;
+
+  // loop over my charges, add their contribution to nearby grid points
+  // (nx,ny,nz) = global coords of grid pt to "lower left" of charge
+  // (dx,dy,dz) = distance to "lower left" grid pt
+  // (mx,my,mz) = global indices of moving stencil pt
+
+  nlocal = atomKK->nlocal;
+
+#ifdef LMP_KOKKOS_GPU
+  copymode = 1;
+  Kokkos::parallel_for(Kokkos::RangePolicy<DeviceType, TagPPPS_make_rho_atomic>(0,nlocal),*this);
+  copymode = 0;
+#else
+  ix = nxhi_out-nxlo_out + 1;
+  iy = nyhi_out-nylo_out + 1;
+
+  copymode = 1;
+  Kokkos::TeamPolicy<DeviceType, TagPPPS_make_rho> config(lmp->kokkos->nthreads,1);
+  Kokkos::parallel_for(config,*this);
+  copymode = 0;
+#endif
+}
+
+template<class DeviceType>
+KOKKOS_INLINE_FUNCTION
+void PPPSKokkos<DeviceType>::operator()(TagPPPS_make_rho_zero, const int &ii) const
+{
+  int iz = ii/(numy_out*numx_out);
+  int iy = (ii - iz*numy_out*numx_out) / numx_out;
+  int ix = ii - iz*numy_out*numx_out - iy*numx_out;
+  d_density_brick(iz,iy,ix) = 0.0;
+}
+
+template<class DeviceType>
+KOKKOS_INLINE_FUNCTION
+void PPPSKokkos<DeviceType>::operator()(TagPPPS_make_rho_atomic, const int &i) const
+{
+  // The density_brick array is atomic for Half/Thread neighbor style
+  Kokkos::View<FFT_SCALAR***,Kokkos::LayoutRight,typename KKDevice<DeviceType>::value,Kokkos::MemoryTraits<Kokkos::Atomic|Kokkos::Unmanaged> > a_density_brick = d_density_brick;
+
+  int nx = d_part2grid(i,0);
+  int ny = d_part2grid(i,1);
+  int nz = d_part2grid(i,2);
+  const FFT_SCALAR dx = nx+shiftone - (x(i,0)-boxlo[0])*delxinv;
+  const FFT_SCALAR dy = ny+shiftone - (x(i,1)-boxlo[1])*delyinv;
+  const FFT_SCALAR dz = nz+shiftone - (x(i,2)-boxlo[2])*delzinv;
+
+  nz -= nzlo_out;
+  ny -= nylo_out;
+  nx -= nxlo_out;
+
+  compute_rho1d(i,dx,dy,dz);
+
+  const FFT_SCALAR z0 = delvolinv * q[i];
+  for (int n = nlower; n <= nupper; n++) {
+    const int mz = n+nz;
+    const FFT_SCALAR y0 = z0*d_rho1d(i,n+order/2,2);
+    for (int m = nlower; m <= nupper; m++) {
+      const int my = m+ny;
+      const FFT_SCALAR x0 = y0*d_rho1d(i,m+order/2,1);
+      for (int l = nlower; l <= nupper; l++) {
+        const int mx = l+nx;
+        a_density_brick(mz,my,mx) += x0*d_rho1d(i,l+order/2,0);
+      }
+    }
+  }
+}
+
+template<class DeviceType>
+KOKKOS_INLINE_FUNCTION
+void PPPSKokkos<DeviceType>::operator() (TagPPPS_make_rho, typename Kokkos::TeamPolicy<DeviceType, TagPPPS_make_rho>::member_type dev) const {
+  // adapted from OPENMP/pppm.cpp:
+
+  // determine range of grid points handled by this thread
+  int tid = dev.league_rank();
+  // each thread works on a fixed chunk of grid points
+  const int nthreads = dev.league_size();
+  const int idelta = 1 + ngrid/nthreads;
+  int ifrom = tid*idelta;
+  int ito = ((ifrom + idelta) > ngrid) ? ngrid : ifrom + idelta;
+
+  // loop over my charges, add their contribution to nearby grid points
+  // (nx,ny,nz) = global coords of grid pt to "lower left" of charge
+  // (dx,dy,dz) = distance to "lower left" grid pt
+
+  // loop over all local atoms for all threads
+  for (int i = 0; i < nlocal; i++) {
+
+    int nx = d_part2grid(i,0);
+    int ny = d_part2grid(i,1);
+    int nz = d_part2grid(i,2);
+
+    // pre-screen whether this atom will ever come within
+    // reach of the data segement this thread is updating.
+    if ( ((nz+nlower-nzlo_out)*ix*iy >= ito)
+         || ((nz+nupper-nzlo_out+1)*ix*iy < ifrom) ) continue;
+
+    const FFT_SCALAR dx = nx+shiftone - (x(i,0)-boxlo[0])*delxinv;
+    const FFT_SCALAR dy = ny+shiftone - (x(i,1)-boxlo[1])*delyinv;
+    const FFT_SCALAR dz = nz+shiftone - (x(i,2)-boxlo[2])*delzinv;
+
+    nz -= nzlo_out;
+    ny -= nylo_out;
+    nx -= nxlo_out;
+
+    // several threads may reach the same atom, all store the same weights
+
+    compute_rho1d(i,dx,dy,dz);
+
+    const FFT_SCALAR z0 = delvolinv * q[i];
+    for (int n = nlower; n <= nupper; n++) {
+      const int mz = n+nz;
+      const int in = mz*ix*iy;
+      const FFT_SCALAR y0 = z0*d_rho1d(i,n+order/2,2);
+      for (int m = nlower; m <= nupper; m++) {
+        const int my = m+ny;
+        const int im = in+my*ix;
+        const FFT_SCALAR x0 = y0*d_rho1d(i,m+order/2,1);
+        for (int l = nlower; l <= nupper; l++) {
+          const int mx = l+nx;
+          const int il = im+mx;
+          // make sure each thread only updates
+          // their elements of the density grid
+          if (il >= ito) break;
+          if (il < ifrom) continue;
+          d_density_brick(mz,my,mx) += x0*d_rho1d(i,l+order/2,0);
+        }
+      }
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   remap density from 3d brick decomposition to FFT decomposition
+------------------------------------------------------------------------- */
+
+template<class DeviceType>
+void PPPSKokkos<DeviceType>::brick2fft()
+{
+  // copy grabs inner portion of density from 3d brick
+  // remap could be done as pre-stage of FFT,
+  //   but this works optimally on only double values, not complex values
+
+  numz_inout = (nzhi_in-nzlo_out)-(nzlo_in-nzlo_out) + 1;
+  numy_inout = (nyhi_in-nylo_out)-(nylo_in-nylo_out) + 1;
+  numx_inout = (nxhi_in-nxlo_out)-(nxlo_in-nxlo_out) + 1;
+  const int inum_inout = numz_inout*numy_inout*numx_inout;
+
+  copymode = 1;
+  Kokkos::parallel_for(Kokkos::RangePolicy<DeviceType, TagPPPS_brick2fft>(0,inum_inout),*this);
+  copymode = 0;
+
+  remap->perform(d_density_fft,d_density_fft,d_work1);
+}
+
+template<class DeviceType>
+KOKKOS_INLINE_FUNCTION
+void PPPSKokkos<DeviceType>::operator()(TagPPPS_brick2fft, const int &ii) const
+{
+  const int n = ii;
+  int k = ii/(numy_inout*numx_inout);
+  int j = (ii - k*numy_inout*numx_inout) / numx_inout;
+  int i = ii - k*numy_inout*numx_inout - j*numx_inout;
+  k += nzlo_in-nzlo_out;
+  j += nylo_in-nylo_out;
+  i += nxlo_in-nxlo_out;
+  d_density_fft[n] = d_density_brick(k,j,i);
+}
+
+/* ----------------------------------------------------------------------
+   FFT-based Poisson solver for ik
+------------------------------------------------------------------------- */
+
+template<class DeviceType>
+void PPPSKokkos<DeviceType>::poisson_ik()
+{
+  // transform charge density (r -> k)
+
+  copymode = 1;
+  Kokkos::parallel_for(Kokkos::RangePolicy<DeviceType, TagPPPS_poisson_ik1>(0,nfft),*this);
+  copymode = 0;
+
+  fft1->compute(d_work1,d_work1,FFT3dKokkos<DeviceType>::FORWARD);
+  phase_stamp_kk(PHASE_FFT);
+
+  // global energy and virial contribution
+
+  bigint ngridtotal = (bigint) nx_pppm * ny_pppm * nz_pppm;
+  scaleinv = 1.0/ngridtotal;
+  s2 = scaleinv*scaleinv;
+
+  if (eflag_global || vflag_global) {
+    EV_FLOAT ev;
+    if (vflag_global) {
+      copymode = 1;
+      Kokkos::parallel_reduce(Kokkos::RangePolicy<DeviceType, TagPPPS_poisson_ik2>(0,nfft),*this,ev);
+      copymode = 0;
+      for (int j = 0; j < 6; j++) virial[j] += ev.v[j];
+      energy += ev.ecoul;
+    } else {
+      copymode = 1;
+      Kokkos::parallel_reduce(Kokkos::RangePolicy<DeviceType, TagPPPS_poisson_ik3>(0,nfft),*this,ev);
+      copymode = 0;
+      energy += ev.ecoul;
+    }
+  }
+
+  // scale by 1/total-grid-pts to get rho(k)
+  // multiply by Green's function to get V(k)
+
+  copymode = 1;
+  Kokkos::parallel_for(Kokkos::RangePolicy<DeviceType, TagPPPS_poisson_ik4>(0,nfft),*this);
+  copymode = 0;
+  phase_stamp_kk(PHASE_GREEN);
+
+  // extra FFTs for per-atom energy/virial
+
+  if (evflag_atom) poisson_peratom();
+
+  // compute gradients of V(r) in each of 3 dims by transforming ik*V(k)
+  // FFT leaves data in 3d brick decomposition
+  // copy it into inner portion of vdx,vdy,vdz arrays
+
+  // merge three outer loops into one for better threading
+
+  numz_fft = nzhi_fft-nzlo_fft + 1;
+  numy_fft = nyhi_fft-nylo_fft + 1;
+  numx_fft = nxhi_fft-nxlo_fft + 1;
+  const int inum_fft = numz_fft*numy_fft*numx_fft;
+
+  numz_inout = (nzhi_in-nzlo_out)-(nzlo_in-nzlo_out) + 1;
+  numy_inout = (nyhi_in-nylo_out)-(nylo_in-nylo_out) + 1;
+  numx_inout = (nxhi_in-nxlo_out)-(nxlo_in-nxlo_out) + 1;
+  const int inum_inout = numz_inout*numy_inout*numx_inout;
+
+  // x direction gradient
+
+  copymode = 1;
+  Kokkos::parallel_for(Kokkos::RangePolicy<DeviceType, TagPPPS_poisson_ik5>(0,inum_fft),*this);
+  copymode = 0;
+
+  fft2->compute(d_work2,d_work2,FFT3dKokkos<DeviceType>::BACKWARD);
+
+  copymode = 1;
+  Kokkos::parallel_for(Kokkos::RangePolicy<DeviceType, TagPPPS_poisson_ik6>(0,inum_inout),*this);
+  copymode = 0;
+
+  // y direction gradient
+
+  copymode = 1;
+  Kokkos::parallel_for(Kokkos::RangePolicy<DeviceType, TagPPPS_poisson_ik7>(0,inum_fft),*this);
+  copymode = 0;
+
+  fft2->compute(d_work2,d_work2,FFT3dKokkos<DeviceType>::BACKWARD);
+
+  copymode = 1;
+  Kokkos::parallel_for(Kokkos::RangePolicy<DeviceType, TagPPPS_poisson_ik8>(0,inum_inout),*this);
+  copymode = 0;
+
+  // z direction gradient
+
+  copymode = 1;
+  Kokkos::parallel_for(Kokkos::RangePolicy<DeviceType, TagPPPS_poisson_ik9>(0,inum_fft),*this);
+  copymode = 0;
+
+  fft2->compute(d_work2,d_work2,FFT3dKokkos<DeviceType>::BACKWARD);
+
+  copymode = 1;
+  Kokkos::parallel_for(Kokkos::RangePolicy<DeviceType, TagPPPS_poisson_ik10>(0,inum_inout),*this);
+  copymode = 0;
+}
+
+template<class DeviceType>
+KOKKOS_INLINE_FUNCTION
+void PPPSKokkos<DeviceType>::operator()(TagPPPS_poisson_ik1, const int &i) const
+{
+  d_work1[2*i] = d_density_fft[i];
+  d_work1[2*i+1] = ZEROF;
+}
+
+template<class DeviceType>
+KOKKOS_INLINE_FUNCTION
+void PPPSKokkos<DeviceType>::operator()(TagPPPS_poisson_ik2, const int &i, EV_FLOAT& ev) const
+{
+  const double rho2 = s2 * (d_work1[2*i]*d_work1[2*i] + d_work1[2*i+1]*d_work1[2*i+1]);
+  const double eng = d_greensfn[i] * rho2;
+  const double eng_virial = d_greensfn2[i] * rho2;
+  for (int j = 0; j < 6; j++) ev.v[j] += eng*d_vg(i,j) + eng_virial*d_vg2(i,j);
+  if (eflag_global) ev.ecoul += eng;
+}
+
+template<class DeviceType>
+KOKKOS_INLINE_FUNCTION
+void PPPSKokkos<DeviceType>::operator()(TagPPPS_poisson_ik3, const int &i, EV_FLOAT& ev) const
+{
+  ev.ecoul +=
+    s2 * d_greensfn[i] * (d_work1[2*i]*d_work1[2*i] + d_work1[2*i+1]*d_work1[2*i+1]);
+}
+
+template<class DeviceType>
+KOKKOS_INLINE_FUNCTION
+void PPPSKokkos<DeviceType>::operator()(TagPPPS_poisson_ik4, const int &i) const
+{
+  d_work1[2*i] *= scaleinv * d_greensfn[i];
+  d_work1[2*i+1] *= scaleinv * d_greensfn[i];
+}
+
+template<class DeviceType>
+KOKKOS_INLINE_FUNCTION
+void PPPSKokkos<DeviceType>::operator()(TagPPPS_poisson_ik5, const int &ii) const
+{
+  const int n = ii*2;
+  const int k = ii/(numy_fft*numx_fft);
+  const int j = (ii - k*numy_fft*numx_fft) / numx_fft;
+  const int i = ii - k*numy_fft*numx_fft - j*numx_fft;
+  d_work2[n] = -d_fkx[i]*d_work1[n+1];
+  d_work2[n+1] = d_fkx[i]*d_work1[n];
+}
+
+template<class DeviceType>
+KOKKOS_INLINE_FUNCTION
+void PPPSKokkos<DeviceType>::operator()(TagPPPS_poisson_ik6, const int &ii) const
+{
+  const int n = ii*2;
+  int k = ii/(numy_inout*numx_inout);
+  int j = (ii - k*numy_inout*numx_inout) / numx_inout;
+  int i = ii - k*numy_inout*numx_inout - j*numx_inout;
+  k += nzlo_in-nzlo_out;
+  j += nylo_in-nylo_out;
+  i += nxlo_in-nxlo_out;
+  d_vdx_brick(k,j,i) = d_work2[n];
+}
+
+template<class DeviceType>
+KOKKOS_INLINE_FUNCTION
+void PPPSKokkos<DeviceType>::operator()(TagPPPS_poisson_ik7, const int &ii) const
+{
+  const int n = ii*2;
+  const int k = ii/(numy_fft*numx_fft);
+  const int j = (ii - k*numy_fft*numx_fft) / numx_fft;
+  d_work2[n] = -d_fky[j]*d_work1[n+1];
+  d_work2[n+1] = d_fky[j]*d_work1[n];
+}
+
+template<class DeviceType>
+KOKKOS_INLINE_FUNCTION
+void PPPSKokkos<DeviceType>::operator()(TagPPPS_poisson_ik8, const int &ii) const
+{
+  const int n = ii*2;
+  int k = ii/(numy_inout*numx_inout);
+  int j = (ii - k*numy_inout*numx_inout) / numx_inout;
+  int i = ii - k*numy_inout*numx_inout - j*numx_inout;
+  k += nzlo_in-nzlo_out;
+  j += nylo_in-nylo_out;
+  i += nxlo_in-nxlo_out;
+  d_vdy_brick(k,j,i) = d_work2[n];
+}
+
+template<class DeviceType>
+KOKKOS_INLINE_FUNCTION
+void PPPSKokkos<DeviceType>::operator()(TagPPPS_poisson_ik9, const int &ii) const
+{
+  const int n = ii*2;
+  const int k = ii/(numy_fft*numx_fft);
+  d_work2[n] = -d_fkz[k]*d_work1[n+1];
+  d_work2[n+1] = d_fkz[k]*d_work1[n];
+}
+
+template<class DeviceType>
+KOKKOS_INLINE_FUNCTION
+void PPPSKokkos<DeviceType>::operator()(TagPPPS_poisson_ik10, const int &ii) const
+{
+  const int n = ii*2;
+  int k = ii/(numy_inout*numx_inout);
+  int j = (ii - k*numy_inout*numx_inout) / numx_inout;
+  int i = ii - k*numy_inout*numx_inout - j*numx_inout;
+  k += nzlo_in-nzlo_out;
+  j += nylo_in-nylo_out;
+  i += nxlo_in-nxlo_out;
+  d_vdz_brick(k,j,i) = d_work2[n];
+}
+
+/* ----------------------------------------------------------------------
+   FFT-based Poisson solver for per-atom energy/virial
+   the 6 virial components share one kernel pair, see peratom_component
+------------------------------------------------------------------------- */
+
+template<class DeviceType>
+void PPPSKokkos<DeviceType>::poisson_peratom()
+{
+  // merge three outer loops into one for better threading
+
+  numz_inout = (nzhi_in-nzlo_out)-(nzlo_in-nzlo_out) + 1;
+  numy_inout = (nyhi_in-nylo_out)-(nylo_in-nylo_out) + 1;
+  numx_inout = (nxhi_in-nxlo_out)-(nxlo_in-nxlo_out) + 1;
+  const int inum_inout = numz_inout*numy_inout*numx_inout;
+
+  // energy
+
+  if (eflag_atom) {
+    copymode = 1;
+    Kokkos::parallel_for(Kokkos::RangePolicy<DeviceType, TagPPPS_poisson_peratom1>(0,nfft),*this);
+    copymode = 0;
+
+    fft2->compute(d_work2,d_work2,FFT3dKokkos<DeviceType>::BACKWARD);
+
+    copymode = 1;
+    Kokkos::parallel_for(Kokkos::RangePolicy<DeviceType, TagPPPS_poisson_peratom2>(0,inum_inout),*this);
+    copymode = 0;
+  }
+
+  // 6 components of virial in v0 thru v5
+
+  if (!vflag_atom) return;
+
+  typename FFT_AT::t_FFT_SCALAR_3d v_brick[6] = {d_v0_brick, d_v1_brick, d_v2_brick,
+                                                d_v3_brick, d_v4_brick, d_v5_brick};
+
+  for (peratom_component = 0; peratom_component < 6; peratom_component++) {
+    d_vpa_brick = v_brick[peratom_component];
+
+    copymode = 1;
+    Kokkos::parallel_for(Kokkos::RangePolicy<DeviceType, TagPPPS_poisson_peratom3>(0,nfft),*this);
+    copymode = 0;
+
+    fft2->compute(d_work2,d_work2,FFT3dKokkos<DeviceType>::BACKWARD);
+
+    copymode = 1;
+    Kokkos::parallel_for(Kokkos::RangePolicy<DeviceType, TagPPPS_poisson_peratom4>(0,inum_inout),*this);
+    copymode = 0;
+  }
+}
+
+template<class DeviceType>
+KOKKOS_INLINE_FUNCTION
+void PPPSKokkos<DeviceType>::operator()(TagPPPS_poisson_peratom1, const int &i) const
+{
+  const int n = 2*i;
+  d_work2[n] = d_work1[n];
+  d_work2[n+1] = d_work1[n+1];
+}
+
+template<class DeviceType>
+KOKKOS_INLINE_FUNCTION
+void PPPSKokkos<DeviceType>::operator()(TagPPPS_poisson_peratom2, const int &ii) const
+{
+  const int n = ii*2;
+  int k = ii/(numy_inout*numx_inout);
+  int j = (ii - k*numy_inout*numx_inout) / numx_inout;
+  int i = ii - k*numy_inout*numx_inout - j*numx_inout;
+  k += nzlo_in-nzlo_out;
+  j += nylo_in-nylo_out;
+  i += nxlo_in-nxlo_out;
+  d_u_brick(k,j,i) = d_work2[n];
+}
+
+template<class DeviceType>
+KOKKOS_INLINE_FUNCTION
+void PPPSKokkos<DeviceType>::operator()(TagPPPS_poisson_peratom3, const int &i) const
+{
+  const int n = 2*i;
+  d_work2[n] = d_work1[n]*d_vg(i,peratom_component);
+  d_work2[n+1] = d_work1[n+1]*d_vg(i,peratom_component);
+}
+
+template<class DeviceType>
+KOKKOS_INLINE_FUNCTION
+void PPPSKokkos<DeviceType>::operator()(TagPPPS_poisson_peratom4, const int &ii) const
+{
+  const int n = ii*2;
+  int k = ii/(numy_inout*numx_inout);
+  int j = (ii - k*numy_inout*numx_inout) / numx_inout;
+  int i = ii - k*numy_inout*numx_inout - j*numx_inout;
+  k += nzlo_in-nzlo_out;
+  j += nylo_in-nylo_out;
+  i += nxlo_in-nxlo_out;
+  d_vpa_brick(k,j,i) = d_work2[n];
+}
+
+/* ----------------------------------------------------------------------
+   interpolate from grid to get electric field & force on my particles
+------------------------------------------------------------------------- */
+
+template<class DeviceType>
+void PPPSKokkos<DeviceType>::fieldforce()
+{
+  fieldforce_ik();
+}
+
+/* ----------------------------------------------------------------------
+   interpolate from grid to get electric field & force on my particles for ik
+   reuses the spreading weights of make_rho()
+------------------------------------------------------------------------- */
+
+template<class DeviceType>
+void PPPSKokkos<DeviceType>::fieldforce_ik()
+{
+  // loop over my charges, interpolate electric field from nearby grid points
+  // (nx,ny,nz) = global coords of grid pt to "lower left" of charge
+  // (dx,dy,dz) = distance to "lower left" grid pt
+  // (mx,my,mz) = global coords of moving stencil pt
+  // ek = 3 components of E-field on particle
+
+  int nlocal = atomKK->nlocal;
+
+  copymode = 1;
+  Kokkos::parallel_for(Kokkos::RangePolicy<DeviceType, TagPPPS_fieldforce_ik>(0,nlocal),*this);
+  copymode = 0;
+}
+
+template<class DeviceType>
+KOKKOS_INLINE_FUNCTION
+void PPPSKokkos<DeviceType>::operator()(TagPPPS_fieldforce_ik, const int &i) const
+{
+  int l,m,n,nx,ny,nz,mx,my,mz;
+  FFT_SCALAR x0,y0,z0;
+  FFT_SCALAR ekx,eky,ekz;
+
+  nx = d_part2grid(i,0);
+  ny = d_part2grid(i,1);
+  nz = d_part2grid(i,2);
+
+  nz -= nzlo_out;
+  ny -= nylo_out;
+  nx -= nxlo_out;
+
+  ekx = eky = ekz = ZEROF;
+  for (n = nlower; n <= nupper; n++) {
+    mz = n+nz;
+    z0 = d_rho1d(i,n+order/2,2);
+    for (m = nlower; m <= nupper; m++) {
+      my = m+ny;
+      y0 = z0*d_rho1d(i,m+order/2,1);
+      for (l = nlower; l <= nupper; l++) {
+        mx = l+nx;
+        x0 = y0*d_rho1d(i,l+order/2,0);
+        ekx -= x0*d_vdx_brick(mz,my,mx);
+        eky -= x0*d_vdy_brick(mz,my,mx);
+        ekz -= x0*d_vdz_brick(mz,my,mx);
+      }
+    }
+  }
+
+  // convert E-field to force
+
+  const double qfactor = qqrd2e * scale * q[i];
+  f(i,0) += qfactor*ekx;
+  f(i,1) += qfactor*eky;
+  if (slabflag != 2) f(i,2) += qfactor*ekz;
+}
+
+/* ----------------------------------------------------------------------
+   interpolate from grid to get per-atom energy/virial
+   reuses the spreading weights of make_rho()
+------------------------------------------------------------------------- */
+
+template<class DeviceType>
+void PPPSKokkos<DeviceType>::fieldforce_peratom()
+{
+  // loop over my charges, interpolate from nearby grid points
+  // (nx,ny,nz) = global coords of grid pt to "lower left" of charge
+  // (mx,my,mz) = global coords of moving stencil pt
+
+  int nlocal = atomKK->nlocal;
+
+  copymode = 1;
+  Kokkos::parallel_for(Kokkos::RangePolicy<DeviceType, TagPPPS_fieldforce_peratom>(0,nlocal),*this);
+  copymode = 0;
+}
+
+template<class DeviceType>
+KOKKOS_INLINE_FUNCTION
+void PPPSKokkos<DeviceType>::operator()(TagPPPS_fieldforce_peratom, const int &i) const
+{
+  int l,m,n,nx,ny,nz,mx,my,mz;
+  FFT_SCALAR x0,y0,z0;
+  FFT_SCALAR u,v0,v1,v2,v3,v4,v5;
+
+  nx = d_part2grid(i,0);
+  ny = d_part2grid(i,1);
+  nz = d_part2grid(i,2);
+
+  nz -= nzlo_out;
+  ny -= nylo_out;
+  nx -= nxlo_out;
+
+  u = v0 = v1 = v2 = v3 = v4 = v5 = ZEROF;
+  for (n = nlower; n <= nupper; n++) {
+    mz = n+nz;
+    z0 = d_rho1d(i,n+order/2,2);
+    for (m = nlower; m <= nupper; m++) {
+      my = m+ny;
+      y0 = z0*d_rho1d(i,m+order/2,1);
+      for (l = nlower; l <= nupper; l++) {
+        mx = l+nx;
+        x0 = y0*d_rho1d(i,l+order/2,0);
+        if (eflag_atom) u += x0*d_u_brick(mz,my,mx);
+        if (vflag_atom) {
+          v0 += x0*d_v0_brick(mz,my,mx);
+          v1 += x0*d_v1_brick(mz,my,mx);
+          v2 += x0*d_v2_brick(mz,my,mx);
+          v3 += x0*d_v3_brick(mz,my,mx);
+          v4 += x0*d_v4_brick(mz,my,mx);
+          v5 += x0*d_v5_brick(mz,my,mx);
+        }
+      }
+    }
+  }
+
+  if (eflag_atom) d_eatom[i] += q[i]*u;
+  if (vflag_atom) {
+    d_vatom(i,0) += q[i]*v0;
+    d_vatom(i,1) += q[i]*v1;
+    d_vatom(i,2) += q[i]*v2;
+    d_vatom(i,3) += q[i]*v3;
+    d_vatom(i,4) += q[i]*v4;
+    d_vatom(i,5) += q[i]*v5;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   pack own values to buf to send to another proc
+------------------------------------------------------------------------- */
+
+template<class DeviceType>
+void PPPSKokkos<DeviceType>::pack_forward_grid_kokkos(int flag, FFT_DAT::tdual_FFT_SCALAR_1d &k_buf, int nlist, DAT::tdual_int_2d &k_list, int index)
+{
+  typename AT::t_int_2d_um d_list = k_list.view<DeviceType>();
+  d_list_index = Kokkos::subview(d_list,index,Kokkos::ALL());
+  d_buf = k_buf.view<DeviceType>();
+
+  nx = (nxhi_out-nxlo_out+1);
+  ny = (nyhi_out-nylo_out+1);
+
+  if (flag == FORWARD_IK) {
+    copymode = 1;
+    Kokkos::parallel_for(Kokkos::RangePolicy<DeviceType, TagPPPS_pack_forward1>(0,nlist),*this);
+    copymode = 0;
+  } else if (flag == FORWARD_IK_PERATOM) {
+    copymode = 1;
+    Kokkos::parallel_for(Kokkos::RangePolicy<DeviceType, TagPPPS_pack_forward2>(0,nlist),*this);
+    copymode = 0;
+  }
+}
+
+template<class DeviceType>
+KOKKOS_INLINE_FUNCTION
+void PPPSKokkos<DeviceType>::operator()(TagPPPS_pack_forward1, const int &i) const
+{
+  const double dlist = (double) d_list_index[i];
+  const int iz = (int) (dlist/(nx*ny));
+  const int iy = (int) ((dlist - iz*nx*ny)/nx);
+  const int ix = d_list_index[i] - iz*nx*ny - iy*nx;
+  d_buf[3*i] = d_vdx_brick(iz,iy,ix);
+  d_buf[3*i+1] = d_vdy_brick(iz,iy,ix);
+  d_buf[3*i+2] = d_vdz_brick(iz,iy,ix);
+}
+
+template<class DeviceType>
+KOKKOS_INLINE_FUNCTION
+void PPPSKokkos<DeviceType>::operator()(TagPPPS_pack_forward2, const int &i) const
+{
+  const double dlist = (double) d_list_index[i];
+  const int iz = (int) (dlist/(nx*ny));
+  const int iy = (int) ((dlist - iz*nx*ny)/nx);
+  const int ix = d_list_index[i] - iz*nx*ny - iy*nx;
+  if (eflag_atom) d_buf[7*i] = d_u_brick(iz,iy,ix);
+  if (vflag_atom) {
+    d_buf[7*i+1] = d_v0_brick(iz,iy,ix);
+    d_buf[7*i+2] = d_v1_brick(iz,iy,ix);
+    d_buf[7*i+3] = d_v2_brick(iz,iy,ix);
+    d_buf[7*i+4] = d_v3_brick(iz,iy,ix);
+    d_buf[7*i+5] = d_v4_brick(iz,iy,ix);
+    d_buf[7*i+6] = d_v5_brick(iz,iy,ix);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   unpack another proc's own values from buf and set own ghost values
+------------------------------------------------------------------------- */
+
+template<class DeviceType>
+void PPPSKokkos<DeviceType>::unpack_forward_grid_kokkos(int flag, FFT_DAT::tdual_FFT_SCALAR_1d &k_buf, int offset, int nlist, DAT::tdual_int_2d &k_list, int index)
+{
+  typename AT::t_int_2d_um d_list = k_list.view<DeviceType>();
+  d_list_index = Kokkos::subview(d_list,index,Kokkos::ALL());
+  d_buf = k_buf.view<DeviceType>();
+  unpack_offset = offset;
+
+  nx = (nxhi_out-nxlo_out+1);
+  ny = (nyhi_out-nylo_out+1);
+
+  if (flag == FORWARD_IK) {
+    copymode = 1;
+    Kokkos::parallel_for(Kokkos::RangePolicy<DeviceType, TagPPPS_unpack_forward1>(0,nlist),*this);
+    copymode = 0;
+  } else if (flag == FORWARD_IK_PERATOM) {
+    copymode = 1;
+    Kokkos::parallel_for(Kokkos::RangePolicy<DeviceType, TagPPPS_unpack_forward2>(0,nlist),*this);
+    copymode = 0;
+  }
+}
+
+template<class DeviceType>
+KOKKOS_INLINE_FUNCTION
+void PPPSKokkos<DeviceType>::operator()(TagPPPS_unpack_forward1, const int &i) const
+{
+  const double dlist = (double) d_list_index[i];
+  const int iz = (int) (dlist/(nx*ny));
+  const int iy = (int) ((dlist - iz*nx*ny)/nx);
+  const int ix = d_list_index[i] - iz*nx*ny - iy*nx;
+  d_vdx_brick(iz,iy,ix) = d_buf[3*i   + unpack_offset];
+  d_vdy_brick(iz,iy,ix) = d_buf[3*i+1 + unpack_offset];
+  d_vdz_brick(iz,iy,ix) = d_buf[3*i+2 + unpack_offset];
+}
+
+template<class DeviceType>
+KOKKOS_INLINE_FUNCTION
+void PPPSKokkos<DeviceType>::operator()(TagPPPS_unpack_forward2, const int &i) const
+{
+  const double dlist = (double) d_list_index[i];
+  const int iz = (int) (dlist/(nx*ny));
+  const int iy = (int) ((dlist - iz*nx*ny)/nx);
+  const int ix = d_list_index[i] - iz*nx*ny - iy*nx;
+  if (eflag_atom) d_u_brick(iz,iy,ix) = d_buf[7*i + unpack_offset];
+  if (vflag_atom) {
+    d_v0_brick(iz,iy,ix) = d_buf[7*i+1 + unpack_offset];
+    d_v1_brick(iz,iy,ix) = d_buf[7*i+2 + unpack_offset];
+    d_v2_brick(iz,iy,ix) = d_buf[7*i+3 + unpack_offset];
+    d_v3_brick(iz,iy,ix) = d_buf[7*i+4 + unpack_offset];
+    d_v4_brick(iz,iy,ix) = d_buf[7*i+5 + unpack_offset];
+    d_v5_brick(iz,iy,ix) = d_buf[7*i+6 + unpack_offset];
+  }
+}
+
+/* ----------------------------------------------------------------------
+   pack ghost values into buf to send to another proc
+------------------------------------------------------------------------- */
+
+template<class DeviceType>
+void PPPSKokkos<DeviceType>::pack_reverse_grid_kokkos(int /*flag*/, FFT_DAT::tdual_FFT_SCALAR_1d &k_buf, int nlist, DAT::tdual_int_2d &k_list, int index)
+{
+  typename AT::t_int_2d_um d_list = k_list.view<DeviceType>();
+  d_list_index = Kokkos::subview(d_list,index,Kokkos::ALL());
+  d_buf = k_buf.view<DeviceType>();
+
+  nx = (nxhi_out-nxlo_out+1);
+  ny = (nyhi_out-nylo_out+1);
+
+  copymode = 1;
+  Kokkos::parallel_for(Kokkos::RangePolicy<DeviceType, TagPPPS_pack_reverse>(0,nlist),*this);
+  copymode = 0;
+}
+
+template<class DeviceType>
+KOKKOS_INLINE_FUNCTION
+void PPPSKokkos<DeviceType>::operator()(TagPPPS_pack_reverse, const int &i) const
+{
+  const double dlist = (double) d_list_index[i];
+  const int iz = (int) (dlist/(nx*ny));
+  const int iy = (int) ((dlist - iz*nx*ny)/nx);
+  const int ix = d_list_index[i] - iz*nx*ny - iy*nx;
+  d_buf[i] = d_density_brick(iz,iy,ix);
+}
+
+/* ----------------------------------------------------------------------
+   unpack another proc's ghost values from buf and add to own values
+------------------------------------------------------------------------- */
+
+template<class DeviceType>
+void PPPSKokkos<DeviceType>::unpack_reverse_grid_kokkos(int /*flag*/, FFT_DAT::tdual_FFT_SCALAR_1d &k_buf, int offset, int nlist, DAT::tdual_int_2d &k_list, int index)
+{
+  typename AT::t_int_2d_um d_list = k_list.view<DeviceType>();
+  d_list_index = Kokkos::subview(d_list,index,Kokkos::ALL());
+  d_buf = k_buf.view<DeviceType>();
+  unpack_offset = offset;
+
+  nx = (nxhi_out-nxlo_out+1);
+  ny = (nyhi_out-nylo_out+1);
+
+  copymode = 1;
+  Kokkos::parallel_for(Kokkos::RangePolicy<DeviceType, TagPPPS_unpack_reverse>(0,nlist),*this);
+  copymode = 0;
+}
+
+template<class DeviceType>
+KOKKOS_INLINE_FUNCTION
+void PPPSKokkos<DeviceType>::operator()(TagPPPS_unpack_reverse, const int &i) const
+{
+  const double dlist = (double) d_list_index[i];
+  const int iz = (int) (dlist/(nx*ny));
+  const int iy = (int) ((dlist - iz*nx*ny)/nx);
+  const int ix = d_list_index[i] - iz*nx*ny - iy*nx;
+  d_density_brick(iz,iy,ix) += d_buf[i + unpack_offset];
+}
+
+/* ----------------------------------------------------------------------
+   PSWF spreading weights of atom i into rho1d
+   dx,dy,dz = distance of particle from "lower left" grid point
+   Horner evaluation of the poly_order coefficients of each stencil point
+------------------------------------------------------------------------- */
+
+template<class DeviceType>
+KOKKOS_INLINE_FUNCTION
+void PPPSKokkos<DeviceType>::compute_rho1d(const int i, const FFT_SCALAR &dx, const FFT_SCALAR &dy,
+                         const FFT_SCALAR &dz) const
+{
+  int k,l;
+  FFT_SCALAR r1,r2,r3;
+
+  for (k = (1-order)/2; k <= order/2; k++) {
+    r1 = r2 = r3 = ZEROF;
+
+    for (l = poly_order-1; l >= 0; l--) {
+      r1 = d_rho_coeff(l,k-(1-order)/2) + r1*dx;
+      r2 = d_rho_coeff(l,k-(1-order)/2) + r2*dy;
+      r3 = d_rho_coeff(l,k-(1-order)/2) + r3*dz;
+    }
+    d_rho1d(i,k+order/2,0) = r1;
+    d_rho1d(i,k+order/2,1) = r2;
+    d_rho1d(i,k+order/2,2) = r3;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   Slab-geometry correction term to dampen inter-slab interactions between
+   periodically repeating slabs.  Yields good approximation to 2D Ewald if
+   adequate empty space is left between repeating slabs (J. Chem. Phys.
+   111, 3155).  Slabs defined here to be parallel to the xy plane. Also
+   extended to non-neutral systems (J. Chem. Phys. 131, 094107).
+------------------------------------------------------------------------- */
+
+template<class DeviceType>
+void PPPSKokkos<DeviceType>::slabcorr()
+{
+  // compute local contribution to global dipole moment
+
+  zprd_slab = domain->zprd*slab_volfactor;
+  int nlocal = atomKK->nlocal;
+
+  double dipole = 0.0;
+  copymode = 1;
+  Kokkos::parallel_reduce(Kokkos::RangePolicy<DeviceType, TagPPPS_slabcorr1>(0,nlocal),*this,dipole);
+  copymode = 0;
+
+  // sum local contributions to get global dipole moment
+
+  MPI_Allreduce(&dipole,&dipole_all,1,MPI_DOUBLE,MPI_SUM,world);
+
+  // need to make non-neutral systems and/or
+  //  per-atom energy translationally invariant
+
+  dipole_r2 = 0.0;
+  if (eflag_atom || fabs(qsum) > SMALL) {
+    copymode = 1;
+    Kokkos::parallel_reduce(Kokkos::RangePolicy<DeviceType, TagPPPS_slabcorr2>(0,nlocal),*this,dipole_r2);
+    copymode = 0;
+
+    // sum local contributions
+
+    double tmp;
+    MPI_Allreduce(&dipole_r2,&tmp,1,MPI_DOUBLE,MPI_SUM,world);
+    dipole_r2 = tmp;
+  }
+
+  // compute corrections
+
+  const double e_slabcorr = MY_2PI*(dipole_all*dipole_all -
+    qsum*dipole_r2 - qsum*qsum*zprd_slab*zprd_slab/12.0)/volume;
+  qscale = qqrd2e * scale;
+
+  if (eflag_global) energy += qscale * e_slabcorr;
+
+  // per-atom energy
+
+  if (eflag_atom) {
+    efact = qscale * MY_2PI/volume;
+    copymode = 1;
+    Kokkos::parallel_for(Kokkos::RangePolicy<DeviceType, TagPPPS_slabcorr3>(0,nlocal),*this);
+    copymode = 0;
+  }
+
+  // add on force corrections
+
+  ffact = qscale * (-4.0*MY_PI/volume);
+
+  copymode = 1;
+  Kokkos::parallel_for(Kokkos::RangePolicy<DeviceType, TagPPPS_slabcorr4>(0,nlocal),*this);
+  copymode = 0;
+}
+
+template<class DeviceType>
+KOKKOS_INLINE_FUNCTION
+void PPPSKokkos<DeviceType>::operator()(TagPPPS_slabcorr1, const int &i, double &dipole) const
+{
+  dipole += q[i]*x(i,2);
+}
+
+template<class DeviceType>
+KOKKOS_INLINE_FUNCTION
+void PPPSKokkos<DeviceType>::operator()(TagPPPS_slabcorr2, const int &i, double &dipole_r2) const
+{
+  dipole_r2 += q[i]*x(i,2)*x(i,2);
+}
+
+template<class DeviceType>
+KOKKOS_INLINE_FUNCTION
+void PPPSKokkos<DeviceType>::operator()(TagPPPS_slabcorr3, const int &i) const
+{
+  d_eatom[i] += efact * q[i]*(x(i,2)*dipole_all - 0.5*(dipole_r2 +
+    qsum*x(i,2)*x(i,2)) - qsum*zprd_slab*zprd_slab/12.0);
+}
+
+template<class DeviceType>
+KOKKOS_INLINE_FUNCTION
+void PPPSKokkos<DeviceType>::operator()(TagPPPS_slabcorr4, const int &i) const
+{
+  f(i,2) += ffact * q[i]*(dipole_all - qsum*x(i,2));
+}
+
+/* ----------------------------------------------------------------------
+   perform and time the 1d FFTs required for N timesteps
+------------------------------------------------------------------------- */
+
+template<class DeviceType>
+int PPPSKokkos<DeviceType>::timing_1d(int n, double &time1d)
+{
+  double time1,time2;
+
+  copymode = 1;
+  Kokkos::parallel_for(Kokkos::RangePolicy<DeviceType, TagPPPS_timing_zero>(0,2*nfft_both),*this);
+  copymode = 0;
+
+  MPI_Barrier(world);
+  time1 = platform::walltime();
+
+  for (int i = 0; i < n; i++) {
+    fft1->timing1d(d_work1,nfft_both,FFT3dKokkos<DeviceType>::FORWARD);
+    fft2->timing1d(d_work1,nfft_both,FFT3dKokkos<DeviceType>::BACKWARD);
+    fft2->timing1d(d_work1,nfft_both,FFT3dKokkos<DeviceType>::BACKWARD);
+    fft2->timing1d(d_work1,nfft_both,FFT3dKokkos<DeviceType>::BACKWARD);
+  }
+
+  MPI_Barrier(world);
+  time2 = platform::walltime();
+  time1d = time2 - time1;
+
+  return 4;
+}
+
+template<class DeviceType>
+KOKKOS_INLINE_FUNCTION
+void PPPSKokkos<DeviceType>::operator()(TagPPPS_timing_zero, const int &i) const
+{
+  d_work1[i] = ZEROF;
+}
+
+/* ----------------------------------------------------------------------
+   perform and time the 3d FFTs required for N timesteps
+------------------------------------------------------------------------- */
+
+template<class DeviceType>
+int PPPSKokkos<DeviceType>::timing_3d(int n, double &time3d)
+{
+  double time1,time2;
+
+  copymode = 1;
+  Kokkos::parallel_for(Kokkos::RangePolicy<DeviceType, TagPPPS_timing_zero>(0,2*nfft_both),*this);
+  copymode = 0;
+
+  MPI_Barrier(world);
+  time1 = platform::walltime();
+
+  for (int i = 0; i < n; i++) {
+    fft1->compute(d_work1,d_work1,FFT3dKokkos<DeviceType>::FORWARD);
+    fft2->compute(d_work1,d_work1,FFT3dKokkos<DeviceType>::BACKWARD);
+    fft2->compute(d_work1,d_work1,FFT3dKokkos<DeviceType>::BACKWARD);
+    fft2->compute(d_work1,d_work1,FFT3dKokkos<DeviceType>::BACKWARD);
+  }
+
+  MPI_Barrier(world);
+  time2 = platform::walltime();
+  time3d = time2 - time1;
+
+  return 4;
+}
+
+/* ----------------------------------------------------------------------
+   memory usage of local arrays
+------------------------------------------------------------------------- */
+
+template<class DeviceType>
+double PPPSKokkos<DeviceType>::memory_usage()
+{
+  double bytes = (double)nmax*3 * sizeof(int);
+  bytes += (double)nmax*3*order * sizeof(FFT_SCALAR);
+  int nbrick = (nxhi_out-nxlo_out+1) * (nyhi_out-nylo_out+1) *
+    (nzhi_out-nzlo_out+1);
+  bytes += (double)4 * nbrick * sizeof(FFT_SCALAR);
+  bytes += (double)12 * nfft_both * sizeof(double);
+  bytes += (double)2 * nfft_both * sizeof(double);
+  bytes += (double)nfft_both*5 * sizeof(FFT_SCALAR);
+
+  if (peratom_allocate_flag)
+    bytes += (double)7 * nbrick * sizeof(FFT_SCALAR);
+
+  // two Grid3d bufs
+
+  bytes += (double)(ngc_buf1 + ngc_buf2) * npergrid * sizeof(FFT_SCALAR);
+
+  return bytes;
+}
+
+namespace LAMMPS_NS {
+template class PPPSKokkos<LMPDeviceType>;
+#ifdef LMP_KOKKOS_GPU
+template class PPPSKokkos<LMPHostType>;
+#endif
+}
@@ -0,0 +1,320 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef KSPACE_CLASS
+// clang-format off
+KSpaceStyle(ppps/kk,PPPSKokkos<LMPDeviceType>);
+KSpaceStyle(ppps/kk/device,PPPSKokkos<LMPDeviceType>);
+KSpaceStyle(ppps/kk/host,PPPSKokkos<LMPHostType>);
+// clang-format on
+#else
+
+// clang-format off
+#ifndef LMP_PPPS_KOKKOS_H
+#define LMP_PPPS_KOKKOS_H
+
+#include "grid3d_kokkos.h"
+#include "remap_kokkos.h"
+#include "fft3d_kokkos.h"
+#include "kokkos_base_fft.h"
+#include "fftdata_kokkos.h"
+#include "kokkos_type.h"
+
+#include "ppps.h"
+
+namespace LAMMPS_NS {
+
+struct TagPPPS_setup1{};
+struct TagPPPS_setup2{};
+struct TagPPPS_setup3{};
+struct TagPPPS_setup4{};
+struct TagPPPS_self1{};
+struct TagPPPS_self2{};
+struct TagPPPS_brick2fft{};
+struct TagPPPS_particle_map{};
+struct TagPPPS_make_rho_zero{};
+struct TagPPPS_make_rho_atomic{};
+struct TagPPPS_make_rho{};
+struct TagPPPS_poisson_ik1{};
+struct TagPPPS_poisson_ik2{};
+struct TagPPPS_poisson_ik3{};
+struct TagPPPS_poisson_ik4{};
+struct TagPPPS_poisson_ik5{};
+struct TagPPPS_poisson_ik6{};
+struct TagPPPS_poisson_ik7{};
+struct TagPPPS_poisson_ik8{};
+struct TagPPPS_poisson_ik9{};
+struct TagPPPS_poisson_ik10{};
+struct TagPPPS_poisson_peratom1{};
+struct TagPPPS_poisson_peratom2{};
+struct TagPPPS_poisson_peratom3{};
+struct TagPPPS_poisson_peratom4{};
+struct TagPPPS_fieldforce_ik{};
+struct TagPPPS_fieldforce_peratom{};
+struct TagPPPS_pack_forward1{};
+struct TagPPPS_pack_forward2{};
+struct TagPPPS_unpack_forward1{};
+struct TagPPPS_unpack_forward2{};
+struct TagPPPS_pack_reverse{};
+struct TagPPPS_unpack_reverse{};
+struct TagPPPS_slabcorr1{};
+struct TagPPPS_slabcorr2{};
+struct TagPPPS_slabcorr3{};
+struct TagPPPS_slabcorr4{};
+struct TagPPPS_timing_zero{};
+
+template<class DeviceType>
+class PPPSKokkos : public PPPS, public KokkosBaseFFT {
+ public:
+  typedef DeviceType device_type;
+  typedef ArrayTypes<DeviceType> AT;
+  typedef FFTArrayTypes<DeviceType> FFT_AT;
+
+  PPPSKokkos(class LAMMPS *);
+  ~PPPSKokkos() override;
+  void init() override;
+  void setup() override;
+  void reset_grid() override;
+  void compute(int, int) override;
+  int timing_1d(int, double &) override;
+  int timing_3d(int, double &) override;
+  double memory_usage() override;
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(TagPPPS_setup1, const int&) const;
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(TagPPPS_setup2, const int&) const;
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(TagPPPS_setup3, const int&) const;
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(TagPPPS_setup4, const int&) const;
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(TagPPPS_self1, const int&) const;
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(TagPPPS_self2, const int&) const;
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(TagPPPS_brick2fft, const int&) const;
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(TagPPPS_particle_map, const int&) const;
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(TagPPPS_make_rho_zero, const int&) const;
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(TagPPPS_make_rho_atomic, const int&) const;
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(TagPPPS_make_rho, typename Kokkos::TeamPolicy<DeviceType, TagPPPS_make_rho>::member_type) const;
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(TagPPPS_poisson_ik1, const int&) const;
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(TagPPPS_poisson_ik2, const int&, EV_FLOAT &) const;
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(TagPPPS_poisson_ik3, const int&, EV_FLOAT &) const;
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(TagPPPS_poisson_ik4, const int&) const;
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(TagPPPS_poisson_ik5, const int&) const;
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(TagPPPS_poisson_ik6, const int&) const;
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(TagPPPS_poisson_ik7, const int&) const;
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(TagPPPS_poisson_ik8, const int&) const;
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(TagPPPS_poisson_ik9, const int&) const;
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(TagPPPS_poisson_ik10, const int&) const;
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(TagPPPS_poisson_peratom1, const int&) const;
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(TagPPPS_poisson_peratom2, const int&) const;
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(TagPPPS_poisson_peratom3, const int&) const;
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(TagPPPS_poisson_peratom4, const int&) const;
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(TagPPPS_fieldforce_ik, const int&) const;
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(TagPPPS_fieldforce_peratom, const int&) const;
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(TagPPPS_pack_forward1, const int&) const;
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(TagPPPS_pack_forward2, const int&) const;
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(TagPPPS_unpack_forward1, const int&) const;
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(TagPPPS_unpack_forward2, const int&) const;
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(TagPPPS_pack_reverse, const int&) const;
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(TagPPPS_unpack_reverse, const int&) const;
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(TagPPPS_slabcorr1, const int&, double&) const;
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(TagPPPS_slabcorr2, const int&, double&) const;
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(TagPPPS_slabcorr3, const int&) const;
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(TagPPPS_slabcorr4, const int&) const;
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(TagPPPS_timing_zero, const int&) const;
+
+ protected:
+  double unitkx,unitky,unitkz;
+  double scaleinv,s2;
+  double qscale,efact,ffact,dipole_all,dipole_r2;
+  double zprd_slab;
+  double self_scale;         // self energy per squared charge, self_coeff/cutoff/2
+  int numx_fft,numy_fft,numz_fft;
+  int numx_inout,numy_inout,numz_inout;
+  int numx_out,numy_out,numz_out;
+  int ix,iy,nlocal;
+  int peratom_component;     // virial component transformed by TagPPPS_poisson_peratom3/4
+
+  int nx,ny,nz;
+  typename AT::t_int_1d_um d_list_index;
+  typename FFT_AT::t_FFT_SCALAR_1d_um d_buf;
+  int unpack_offset;
+
+  DAT::tdual_int_scalar k_flag;
+
+  typename AT::t_x_array_randomread x;
+  typename AT::t_f_array f;
+  typename AT::t_float_1d_randomread q;
+
+  DAT::tdual_efloat_1d k_eatom;
+  DAT::tdual_virial_array k_vatom;
+  typename ArrayTypes<DeviceType>::t_efloat_1d d_eatom;
+  typename ArrayTypes<DeviceType>::t_virial_array d_vatom;
+
+  typename FFT_AT::t_FFT_SCALAR_3d d_density_brick;
+  typename FFT_AT::t_FFT_SCALAR_3d d_vdx_brick,d_vdy_brick,d_vdz_brick;
+  typename FFT_AT::t_FFT_SCALAR_3d d_u_brick;
+  typename FFT_AT::t_FFT_SCALAR_3d d_v0_brick,d_v1_brick,d_v2_brick;
+  typename FFT_AT::t_FFT_SCALAR_3d d_v3_brick,d_v4_brick,d_v5_brick;
+  typename FFT_AT::t_FFT_SCALAR_3d d_vpa_brick;    // v0-v5 brick filled by TagPPPS_poisson_peratom4
+
+  // the Green's function is computed on the host by PPPS, greensfn and greensfn2 are its host views
+
+  DAT::tdual_float_1d k_greensfn,k_greensfn2;
+  typename AT::t_float_1d d_greensfn,d_greensfn2;
+  typename AT::t_virial_array d_vg,d_vg2;
+  typename AT::t_float_1d d_fkx;
+  typename AT::t_float_1d d_fky;
+  typename AT::t_float_1d d_fkz;
+  FFT_DAT::tdual_FFT_SCALAR_1d k_density_fft;
+  FFT_DAT::tdual_FFT_SCALAR_1d k_work1;
+  FFT_DAT::tdual_FFT_SCALAR_1d k_work2;
+  typename FFT_AT::t_FFT_SCALAR_1d d_density_fft;
+  typename FFT_AT::t_FFT_SCALAR_1d d_work1;
+  typename FFT_AT::t_FFT_SCALAR_1d d_work2;
+
+  // PSWF spreading weights, poly_order coefficients per stencil point
+
+  typename FFT_AT::t_FFT_SCALAR_2d_3 d_rho1d;
+  FFT_DAT::tdual_FFT_SCALAR_2d k_rho_coeff;
+  typename FFT_AT::t_FFT_SCALAR_2d d_rho_coeff;
+
+  // FFTs and grid communication
+
+  FFT3dKokkos<DeviceType> *fft1,*fft2;
+  RemapKokkos<DeviceType> *remap;
+  Grid3dKokkos<DeviceType> *gc;
+
+  FFT_DAT::tdual_FFT_SCALAR_1d k_gc_buf1,k_gc_buf2;
+
+  typename AT::t_int_1d_3 d_part2grid;
+
+  double boxlo[3];
+
+  // kernels may still run when a phase ends, wait for them when timing
+
+  void phase_stamp_kk(int which)
+  {
+    if (!phase_flag) return;
+    Kokkos::fence();
+    phase_stamp(which);
+  }
+
+  void set_grid_local() override;
+
+  void allocate() override;
+  void allocate_peratom() override;
+  void deallocate() override;
+  void deallocate_peratom() override;
+  void copy_rho_coeff();
+
+  void particle_map() override;
+  void make_rho() override;
+  void brick2fft() override;
+
+  void poisson_ik() override;
+
+  void fieldforce() override;
+  void fieldforce_ik() override;
+
+  void poisson_peratom() override;
+  void fieldforce_peratom() override;
+
+  KOKKOS_INLINE_FUNCTION
+  void compute_rho1d(const int i, const FFT_SCALAR &, const FFT_SCALAR &,
+                     const FFT_SCALAR &) const;
+  void slabcorr() override;
+
+  // grid communication
+
+  void pack_forward_grid_kokkos(int, FFT_DAT::tdual_FFT_SCALAR_1d &, int, DAT::tdual_int_2d &, int) override;
+  void unpack_forward_grid_kokkos(int, FFT_DAT::tdual_FFT_SCALAR_1d &, int, int, DAT::tdual_int_2d &, int) override;
+  void pack_reverse_grid_kokkos(int, FFT_DAT::tdual_FFT_SCALAR_1d &, int, DAT::tdual_int_2d &, int) override;
+  void unpack_reverse_grid_kokkos(int, FFT_DAT::tdual_FFT_SCALAR_1d &, int, int, DAT::tdual_int_2d &, int) override;
+};
+
+}
+
+#endif
+#endif
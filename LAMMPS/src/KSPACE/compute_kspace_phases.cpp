@@ -0,0 +1,83 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "compute_kspace_phases.h"
+
+#include "comm.h"
+#include "error.h"
+#include "force.h"
+#include "kspace.h"
+#include "update.h"
+
+using namespace LAMMPS_NS;
+
+/* ---------------------------------------------------------------------- */
+
+ComputeKspacePhases::ComputeKspacePhases(LAMMPS *lmp, int narg, char **arg) :
+    Compute(lmp, narg, arg), one(nullptr)
+{
+  if (narg != 3) error->all(FLERR, "Illegal compute kspace/phases command");
+
+  if (!force->kspace)
+    error->all(FLERR, "Compute kspace/phases requires a kspace style");
+
+  const char *const *names;
+  const double *times;
+  nphase = force->kspace->timing_phases(names, times);
+  if (nphase == 0)
+    error->all(FLERR, "Kspace style {} does not time its phases", force->kspace_style);
+
+  vector_flag = 1;
+  size_vector = nphase;
+  extvector = 0;
+
+  one = new double[nphase];
+  vector = new double[nphase];
+}
+
+/* ---------------------------------------------------------------------- */
+
+ComputeKspacePhases::~ComputeKspacePhases()
+{
+  delete[] one;
+  delete[] vector;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void ComputeKspacePhases::init()
+{
+  // recheck for kspace style in case it has been changed
+
+  const char *const *names;
+  const double *times;
+  if (!force->kspace || force->kspace->timing_phases(names, times) != nphase)
+    error->all(FLERR, "Kspace style for compute kspace/phases has changed");
+}
+
+/* ----------------------------------------------------------------------
+   wall time of each phase since the start of the run, averaged over procs
+------------------------------------------------------------------------- */
+
+void ComputeKspacePhases::compute_vector()
+{
+  invoked_vector = update->ntimestep;
+
+  const char *const *names;
+  const double *times;
+  force->kspace->timing_phases(names, times);
+  for (int i = 0; i < nphase; i++) one[i] = times[i];
+
+  MPI_Allreduce(one, vector, nphase, MPI_DOUBLE, MPI_SUM, world);
+  for (int i = 0; i < nphase; i++) vector[i] /= comm->nprocs;
+}
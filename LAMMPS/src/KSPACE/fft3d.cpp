@@ -39,6 +39,13 @@
 #define MIN(A,B) ((A) < (B) ? (A) : (B))
 #define MAX(A,B) ((A) > (B) ? (A) : (B))
 
+#if defined(FFT_KISS)
+static void fft_1d(FFT_DATA *, int, int, struct fft_plan_3d *);
+static void fft_1d_setup(struct fft_plan_3d *, int, int, int);
+static void fft_1d_r2c(FFT_SCALAR *, FFT_SCALAR *, struct fft_plan_3d *);
+static void fft_1d_c2r(FFT_SCALAR *, FFT_SCALAR *, struct fft_plan_3d *);
+#endif
+
 /* ----------------------------------------------------------------------
    Data layout for 3d FFTs:
 
@@ -282,6 +289,8 @@ struct fft_plan_3d *fft_3d_create_plan(
 
   plan = (struct fft_plan_3d *) malloc(sizeof(struct fft_plan_3d));
   if (plan == nullptr) return nullptr;
+  plan->real = 0;
+  plan->rwork = nullptr;
 
   // remap from initial distribution to layout needed for 1st set of 1d FFTs
   // not needed if all procs own entire fast axis initially
@@ -595,6 +604,435 @@ struct fft_plan_3d *fft_3d_create_plan(
   return plan;
 }
 
+#if defined(FFT_KISS)
+
+/* ----------------------------------------------------------------------
+   Perform 3d FFT of real data, only the half spectrum with
+     fast index 0 to Nfast/2 is computed, the rest follows from
+     Hermitian symmetry
+
+   Arguments:
+   in           starting address of real input data on this proc
+   out          starting address of where complex output data for this proc
+                  will be placed (can be same as in)
+   plan         plan returned by previous call to fft_3d_create_plan_real
+                  with direction = 1
+------------------------------------------------------------------------- */
+
+void fft_3d_r2c(FFT_SCALAR *in, FFT_DATA *out, struct fft_plan_3d *plan)
+{
+  FFT_SCALAR *real;
+  FFT_DATA *data,*copy;
+
+  // pre-remap of real data to entire fast-axis lines if needed
+
+  if (plan->pre_plan) {
+    if (plan->pre_target == 0) real = (FFT_SCALAR *) out;
+    else real = (FFT_SCALAR *) plan->copy;
+    remap_3d(in,real,(FFT_SCALAR *) plan->scratch,plan->pre_plan);
+  } else real = in;
+
+  // real-to-complex 1d FFTs along fast axis
+
+  if (plan->real_target == 0) data = out;
+  else data = plan->copy;
+  fft_1d_r2c(real,(FFT_SCALAR *) data,plan);
+
+  // remaps and complex 1d FFTs along mid and slow axis as in fft_3d()
+
+  if (plan->mid1_target == 0) copy = out;
+  else copy = plan->copy;
+  remap_3d((FFT_SCALAR *) data, (FFT_SCALAR *) copy,
+           (FFT_SCALAR *) plan->scratch, plan->mid1_plan);
+  data = copy;
+
+  fft_1d(data,1,1,plan);
+
+  if (plan->mid2_target == 0) copy = out;
+  else copy = plan->copy;
+  remap_3d((FFT_SCALAR *) data, (FFT_SCALAR *) copy,
+           (FFT_SCALAR *) plan->scratch, plan->mid2_plan);
+  data = copy;
+
+  fft_1d(data,1,2,plan);
+
+  remap_3d((FFT_SCALAR *) data, (FFT_SCALAR *) out,
+           (FFT_SCALAR *) plan->scratch, plan->post_plan);
+}
+
+/* ----------------------------------------------------------------------
+   Perform backward 3d FFT of a half spectrum to real data,
+     inverse of fft_3d_r2c()
+
+   Arguments:
+   in           starting address of complex input data on this proc
+   out          starting address of where real output data for this proc
+                  will be placed (can be same as in)
+   plan         plan returned by previous call to fft_3d_create_plan_real
+                  with direction = -1
+------------------------------------------------------------------------- */
+
+void fft_3d_c2r(FFT_DATA *in, FFT_SCALAR *out, struct fft_plan_3d *plan)
+{
+  FFT_SCALAR *real;
+  FFT_DATA *data,*copy;
+
+  // remap to mid-axis lines, complex 1d FFTs along mid and slow axis
+
+  if (plan->pre_target == 0) copy = (FFT_DATA *) out;
+  else copy = plan->copy;
+  remap_3d((FFT_SCALAR *) in, (FFT_SCALAR *) copy,
+           (FFT_SCALAR *) plan->scratch, plan->pre_plan);
+  data = copy;
+
+  fft_1d(data,-1,1,plan);
+
+  if (plan->mid1_target == 0) copy = (FFT_DATA *) out;
+  else copy = plan->copy;
+  remap_3d((FFT_SCALAR *) data, (FFT_SCALAR *) copy,
+           (FFT_SCALAR *) plan->scratch, plan->mid1_plan);
+  data = copy;
+
+  fft_1d(data,-1,2,plan);
+
+  // remap to fast-axis lines
+
+  if (plan->mid2_target == 0) copy = (FFT_DATA *) out;
+  else copy = plan->copy;
+  remap_3d((FFT_SCALAR *) data, (FFT_SCALAR *) copy,
+           (FFT_SCALAR *) plan->scratch, plan->mid2_plan);
+  data = copy;
+
+  // complex-to-real 1d FFTs along fast axis
+  // post-remap of real data to output format if needed
+
+  if (plan->post_plan) {
+    if (plan->real_target == 0) real = out;
+    else real = (FFT_SCALAR *) plan->copy;
+    fft_1d_c2r((FFT_SCALAR *) data,real,plan);
+    remap_3d(real,out,(FFT_SCALAR *) plan->scratch,plan->post_plan);
+  } else fft_1d_c2r((FFT_SCALAR *) data,out,plan);
+
+  // scaling if required
+
+  if (plan->scaled) {
+    const FFT_SCALAR norm = plan->norm;
+    const int num = plan->normnum;
+    for (int i = 0; i < num; i++) out[i] *= norm;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   Create plan for performing a 3d FFT of real data
+
+   Arguments:
+   comm                 MPI communicator for the P procs which own the data
+   nfast,nmid,nslow     size of global 3d matrix of real data
+   in_ilo,in_ihi        input bounds of data I own in fast index
+   in_jlo,in_jhi        input bounds of data I own in mid index
+   in_klo,in_khi        input bounds of data I own in slow index
+   out_ilo,out_ihi      output bounds of data I own in fast index
+   out_jlo,out_jhi      output bounds of data I own in mid index
+   out_klo,out_khi      output bounds of data I own in slow index
+   scaled               0 = no scaling of result, 1 = scaling
+   direction            1 = real-to-complex (forward), input is real,
+                          output is complex
+                        -1 = complex-to-real (backward), input is complex,
+                          output is real
+   nbuf                 returns size of internal storage buffers used by FFT
+   usecollective        use collective MPI operations for remapping data
+
+   the complex data is the half spectrum with fast index 0 to Nfast/2,
+     so its fast bounds must lie within 0 to Nfast/2
+   only the backward transform is scaled
+   there is no permutation of indices on output
+------------------------------------------------------------------------- */
+
+struct fft_plan_3d *fft_3d_create_plan_real(
+       MPI_Comm comm, int nfast, int nmid, int nslow,
+       int in_ilo, int in_ihi, int in_jlo, int in_jhi,
+       int in_klo, int in_khi,
+       int out_ilo, int out_ihi, int out_jlo, int out_jhi,
+       int out_klo, int out_khi,
+       int scaled, int direction, int *nbuf, int usecollective)
+{
+  struct fft_plan_3d *plan;
+  int me,nprocs;
+  int flag,remapflag;
+  int real_ilo,real_ihi,real_jlo,real_jhi,real_klo,real_khi;
+  int cplx_ilo,cplx_ihi,cplx_jlo,cplx_jhi,cplx_klo,cplx_khi;
+  int first_jlo,first_jhi,first_klo,first_khi;
+  int second_ilo,second_ihi,second_jlo,second_jhi,second_klo,second_khi;
+  int third_ilo,third_ihi,third_jlo,third_jhi,third_klo,third_khi;
+  int real_size,cplx_size,first_real_size,first_cplx_size;
+  int second_size,third_size,out_size,copy_size,scratch_size,rwork_size;
+  int np1,np2,ip1,ip2;
+
+  // query MPI info
+
+  MPI_Comm_rank(comm,&me);
+  MPI_Comm_size(comm,&nprocs);
+
+  // compute division of procs in 2 dimensions not on-processor
+
+  bifactor(nprocs,&np1,&np2);
+  ip1 = me % np1;
+  ip2 = me/np1;
+
+  // allocate memory for plan data struct
+
+  plan = (struct fft_plan_3d *) malloc(sizeof(struct fft_plan_3d));
+  if (plan == nullptr) return nullptr;
+
+  const int nhalf = nfast/2 + 1;
+  plan->real = direction;
+  plan->nreal = nfast;
+  plan->nhalf = nhalf;
+  plan->pre_plan = plan->mid1_plan = plan->mid2_plan = plan->post_plan = nullptr;
+
+  // real bounds = my real data, input for r2c, output for c2r
+  // cplx bounds = my half spectrum, output for r2c, input for c2r
+
+  if (direction == 1) {
+    real_ilo = in_ilo; real_ihi = in_ihi; real_jlo = in_jlo;
+    real_jhi = in_jhi; real_klo = in_klo; real_khi = in_khi;
+    cplx_ilo = out_ilo; cplx_ihi = out_ihi; cplx_jlo = out_jlo;
+    cplx_jhi = out_jhi; cplx_klo = out_klo; cplx_khi = out_khi;
+  } else {
+    real_ilo = out_ilo; real_ihi = out_ihi; real_jlo = out_jlo;
+    real_jhi = out_jhi; real_klo = out_klo; real_khi = out_khi;
+    cplx_ilo = in_ilo; cplx_ihi = in_ihi; cplx_jlo = in_jlo;
+    cplx_jhi = in_jhi; cplx_klo = in_klo; cplx_khi = in_khi;
+  }
+
+  // first indices = distribution for real <-> complex FFTs along fast axis,
+  //   entire fast axis, 0 to Nfast-1 for real, 0 to Nfast/2 for complex data
+  // use the real distribution if all procs own entire fast axis,
+  //   else remap the real data in a pre (r2c) or post (c2r) stage
+
+  if (real_ilo == 0 && real_ihi == nfast-1)
+    flag = 0;
+  else
+    flag = 1;
+
+  MPI_Allreduce(&flag,&remapflag,1,MPI_INT,MPI_MAX,comm);
+
+  if (remapflag == 0) {
+    first_jlo = real_jlo;
+    first_jhi = real_jhi;
+    first_klo = real_klo;
+    first_khi = real_khi;
+  } else {
+    first_jlo = ip1*nmid/np1;
+    first_jhi = (ip1+1)*nmid/np1 - 1;
+    first_klo = ip2*nslow/np2;
+    first_khi = (ip2+1)*nslow/np2 - 1;
+  }
+
+  plan->nlines = (first_jhi-first_jlo+1) * (first_khi-first_klo+1);
+
+  // second indices = distribution for 1d FFTs along mid axis
+  // third indices = distribution for 1d FFTs along slow axis
+  // both only cover the half spectrum
+
+  second_ilo = ip1*nhalf/np1;
+  second_ihi = (ip1+1)*nhalf/np1 - 1;
+  second_jlo = 0;
+  second_jhi = nmid - 1;
+  second_klo = ip2*nslow/np2;
+  second_khi = (ip2+1)*nslow/np2 - 1;
+
+  third_ilo = ip1*nhalf/np1;
+  third_ihi = (ip1+1)*nhalf/np1 - 1;
+  third_jlo = ip2*nmid/np2;
+  third_jhi = (ip2+1)*nmid/np2 - 1;
+  third_klo = 0;
+  third_khi = nslow - 1;
+
+  // remaps
+  // r2c: real pre-remap, fast FFTs, mid1 remap, mid FFTs, mid2 remap,
+  //      slow FFTs, post-remap of the half spectrum to the output
+  // c2r: pre-remap of the half spectrum, mid FFTs, mid1 remap, slow FFTs,
+  //      mid2 remap, fast FFTs, real post-remap to the output
+  // complex remaps permute once, so the axis of the next 1d FFTs is fast
+
+  if (direction == 1) {
+    if (remapflag) {
+      plan->pre_plan =
+        remap_3d_create_plan(comm,real_ilo,real_ihi,real_jlo,real_jhi,real_klo,real_khi,
+                             0,nfast-1,first_jlo,first_jhi,first_klo,first_khi,
+                             1,0,0,FFT_PRECISION,0);
+      if (plan->pre_plan == nullptr) return nullptr;
+    }
+
+    plan->mid1_plan =
+      remap_3d_create_plan(comm,0,nhalf-1,first_jlo,first_jhi,first_klo,first_khi,
+                           second_ilo,second_ihi,second_jlo,second_jhi,
+                           second_klo,second_khi,2,1,0,FFT_PRECISION,usecollective);
+    if (plan->mid1_plan == nullptr) return nullptr;
+
+    plan->mid2_plan =
+      remap_3d_create_plan(comm,second_jlo,second_jhi,second_klo,second_khi,
+                           second_ilo,second_ihi,
+                           third_jlo,third_jhi,third_klo,third_khi,
+                           third_ilo,third_ihi,2,1,0,FFT_PRECISION,usecollective);
+    if (plan->mid2_plan == nullptr) return nullptr;
+
+    plan->post_plan =
+      remap_3d_create_plan(comm,third_klo,third_khi,third_ilo,third_ihi,
+                           third_jlo,third_jhi,
+                           cplx_klo,cplx_khi,cplx_ilo,cplx_ihi,
+                           cplx_jlo,cplx_jhi,2,1,0,FFT_PRECISION,0);
+    if (plan->post_plan == nullptr) return nullptr;
+
+  } else {
+    plan->pre_plan =
+      remap_3d_create_plan(comm,cplx_ilo,cplx_ihi,cplx_jlo,cplx_jhi,cplx_klo,cplx_khi,
+                           second_ilo,second_ihi,second_jlo,second_jhi,
+                           second_klo,second_khi,2,1,0,FFT_PRECISION,0);
+    if (plan->pre_plan == nullptr) return nullptr;
+
+    plan->mid1_plan =
+      remap_3d_create_plan(comm,second_jlo,second_jhi,second_klo,second_khi,
+                           second_ilo,second_ihi,
+                           third_jlo,third_jhi,third_klo,third_khi,
+                           third_ilo,third_ihi,2,1,0,FFT_PRECISION,usecollective);
+    if (plan->mid1_plan == nullptr) return nullptr;
+
+    plan->mid2_plan =
+      remap_3d_create_plan(comm,third_klo,third_khi,third_ilo,third_ihi,
+                           third_jlo,third_jhi,
+                           first_klo,first_khi,0,nhalf-1,
+                           first_jlo,first_jhi,2,1,0,FFT_PRECISION,usecollective);
+    if (plan->mid2_plan == nullptr) return nullptr;
+
+    if (remapflag) {
+      plan->post_plan =
+        remap_3d_create_plan(comm,0,nfast-1,first_jlo,first_jhi,first_klo,first_khi,
+                             real_ilo,real_ihi,real_jlo,real_jhi,real_klo,real_khi,
+                             1,0,0,FFT_PRECISION,0);
+      if (plan->post_plan == nullptr) return nullptr;
+    }
+  }
+
+  // 1d FFTs
+  // pairs of real lines are transformed as one complex line along fast axis
+
+  plan->length1 = nfast;
+  plan->total1 = nfast * ((plan->nlines+1)/2);
+  plan->length2 = nmid;
+  plan->total2 = (second_ihi-second_ilo+1) * nmid * (second_khi-second_klo+1);
+  plan->length3 = nslow;
+  plan->total3 = (third_ihi-third_ilo+1) * (third_jhi-third_jlo+1) * nslow;
+
+  // configure plan memory pointers and allocate work space
+  // all sizes are counted in FFT_SCALAR values
+  // out_size = amount of memory given to FFT by user
+  // for each remap and for the fast-axis FFTs:
+  //   out space used for result if big enough, else require copy buffer
+  //   accumulate largest required remap scratch space
+
+  real_size = (real_ihi-real_ilo+1) * (real_jhi-real_jlo+1) * (real_khi-real_klo+1);
+  cplx_size = 2 * (cplx_ihi-cplx_ilo+1) * (cplx_jhi-cplx_jlo+1) * (cplx_khi-cplx_klo+1);
+  first_real_size = nfast * plan->nlines;
+  first_cplx_size = 2 * nhalf * plan->nlines;
+  second_size = 2 * plan->total2;
+  third_size = 2 * plan->total3;
+  out_size = (direction == 1) ? cplx_size : real_size;
+  rwork_size = 2 * plan->total1;
+
+  copy_size = 0;
+  scratch_size = 0;
+
+  int fast_size,pre_size,mid1_size,mid2_size;
+  if (direction == 1) {
+    pre_size = first_real_size;
+    fast_size = first_cplx_size;
+    mid1_size = second_size;
+    mid2_size = third_size;
+  } else {
+    pre_size = second_size;
+    mid1_size = third_size;
+    mid2_size = first_cplx_size;
+    fast_size = first_real_size;
+  }
+
+  if (plan->pre_plan) {
+    if (pre_size <= out_size)
+      plan->pre_target = 0;
+    else {
+      plan->pre_target = 1;
+      copy_size = MAX(copy_size,pre_size);
+    }
+    scratch_size = MAX(scratch_size,pre_size);
+  }
+
+  if (direction == 1 || plan->post_plan) {
+    if (fast_size <= out_size)
+      plan->real_target = 0;
+    else {
+      plan->real_target = 1;
+      copy_size = MAX(copy_size,fast_size);
+    }
+  }
+
+  if (mid1_size <= out_size)
+    plan->mid1_target = 0;
+  else {
+    plan->mid1_target = 1;
+    copy_size = MAX(copy_size,mid1_size);
+  }
+  scratch_size = MAX(scratch_size,mid1_size);
+
+  if (mid2_size <= out_size)
+    plan->mid2_target = 0;
+  else {
+    plan->mid2_target = 1;
+    copy_size = MAX(copy_size,mid2_size);
+  }
+  scratch_size = MAX(scratch_size,mid2_size);
+
+  if (plan->post_plan)
+    scratch_size = MAX(scratch_size,out_size);
+
+  *nbuf = (copy_size + scratch_size + rwork_size + 1) / 2;
+
+  if (copy_size) {
+    plan->copy = (FFT_DATA *) malloc(copy_size*sizeof(FFT_SCALAR));
+    if (plan->copy == nullptr) return nullptr;
+  }
+  else plan->copy = nullptr;
+
+  if (scratch_size) {
+    plan->scratch = (FFT_DATA *) malloc(scratch_size*sizeof(FFT_SCALAR));
+    if (plan->scratch == nullptr) return nullptr;
+  }
+  else plan->scratch = nullptr;
+
+  if (rwork_size) {
+    plan->rwork = (FFT_DATA *) malloc(rwork_size*sizeof(FFT_SCALAR));
+    if (plan->rwork == nullptr) return nullptr;
+  }
+  else plan->rwork = nullptr;
+
+  // system specific pre-computation of 1d FFT coeffs
+  // and scaling normalization of real output
+
+  fft_1d_setup(plan,nfast,nmid,nslow);
+
+  if (scaled == 0 || direction == 1)
+    plan->scaled = 0;
+  else {
+    plan->scaled = 1;
+    plan->norm = 1.0/(nfast*nmid*nslow);
+    plan->normnum = real_size;
+  }
+
+  return plan;
+}
+
+#endif
+
 /* ----------------------------------------------------------------------
    Destroy a 3d fft plan
 ------------------------------------------------------------------------- */
@@ -608,6 +1046,7 @@ void fft_3d_destroy_plan(struct fft_plan_3d *plan)
 
   if (plan->copy) free(plan->copy);
   if (plan->scratch) free(plan->scratch);
+  if (plan->rwork) free(plan->rwork);
 
 #if defined(FFT_MKL)
   DftiFreeDescriptor(&(plan->handle_fast));
@@ -812,3 +1251,186 @@ void fft_1d_only(FFT_DATA *data, int nsize, int flag, struct fft_plan_3d *plan)
     }
   }
 }
+
+#if defined(FFT_KISS)
+
+/* ----------------------------------------------------------------------
+   perform the batched 1d FFTs along one axis of a real 3d FFT in place
+
+   Arguments:
+   data         data in the layout of the 1d FFTs of this axis
+   flag         1 for forward FFT, -1 for backward FFT
+   axis         0 = fast, 1 = mid, 2 = slow axis
+   plan         plan returned by fft_3d_create_plan_real()
+------------------------------------------------------------------------- */
+
+static void fft_1d(FFT_DATA *data, int flag, int axis, struct fft_plan_3d *plan)
+{
+  int total,length;
+  kiss_fft_cfg cfg;
+  if (axis == 0) {
+    total = plan->total1;
+    length = plan->length1;
+    cfg = (flag == 1) ? plan->cfg_fast_forward : plan->cfg_fast_backward;
+  } else if (axis == 1) {
+    total = plan->total2;
+    length = plan->length2;
+    cfg = (flag == 1) ? plan->cfg_mid_forward : plan->cfg_mid_backward;
+  } else {
+    total = plan->total3;
+    length = plan->length3;
+    cfg = (flag == 1) ? plan->cfg_slow_forward : plan->cfg_slow_backward;
+  }
+
+  for (int offset = 0; offset < total; offset += length)
+    kiss_fft(cfg,&data[offset],&data[offset]);
+}
+
+/* ----------------------------------------------------------------------
+   pre-computation of the 1d FFT coeffs of a real 3d FFT plan,
+     same sharing of configurations as in fft_3d_create_plan()
+------------------------------------------------------------------------- */
+
+static void fft_1d_setup(struct fft_plan_3d *plan, int nfast, int nmid, int nslow)
+{
+  plan->cfg_fast_forward = kiss_fft_alloc(nfast,0,nullptr,nullptr);
+  plan->cfg_fast_backward = kiss_fft_alloc(nfast,1,nullptr,nullptr);
+
+  if (nmid == nfast) {
+    plan->cfg_mid_forward = plan->cfg_fast_forward;
+    plan->cfg_mid_backward = plan->cfg_fast_backward;
+  }
+  else {
+    plan->cfg_mid_forward = kiss_fft_alloc(nmid,0,nullptr,nullptr);
+    plan->cfg_mid_backward = kiss_fft_alloc(nmid,1,nullptr,nullptr);
+  }
+
+  if (nslow == nfast) {
+    plan->cfg_slow_forward = plan->cfg_fast_forward;
+    plan->cfg_slow_backward = plan->cfg_fast_backward;
+  }
+  else if (nslow == nmid) {
+    plan->cfg_slow_forward = plan->cfg_mid_forward;
+    plan->cfg_slow_backward = plan->cfg_mid_backward;
+  }
+  else {
+    plan->cfg_slow_forward = kiss_fft_alloc(nslow,0,nullptr,nullptr);
+    plan->cfg_slow_backward = kiss_fft_alloc(nslow,1,nullptr,nullptr);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   real-to-complex 1d FFTs along the fast axis
+   in = nlines real lines of length nreal
+   out = nlines half spectra of length nhalf = nreal/2+1
+   lines 2m and 2m+1 are transformed together as real and imaginary
+     part of one complex line, the two spectra A,B are separated via
+     A(k) = (Z(k) + conj(Z(N-k)))/2 and B(k) = (Z(k) - conj(Z(N-k)))/2i
+   in and out may be the same
+------------------------------------------------------------------------- */
+
+static void fft_1d_r2c(FFT_SCALAR *in, FFT_SCALAR *out, struct fft_plan_3d *plan)
+{
+  const int n = plan->nreal;
+  const int nh = plan->nhalf;
+  const int nlines = plan->nlines;
+  FFT_SCALAR *z = (FFT_SCALAR *) plan->rwork;
+
+  for (int m = 0; m < nlines; m += 2) {
+    const FFT_SCALAR *a = &in[m*n];
+    FFT_SCALAR *zm = &z[m*n];
+    if (m+1 < nlines) {
+      const FFT_SCALAR *b = &in[(m+1)*n];
+      for (int i = 0; i < n; i++) {
+        zm[2*i] = a[i];
+        zm[2*i+1] = b[i];
+      }
+    } else {
+      for (int i = 0; i < n; i++) {
+        zm[2*i] = a[i];
+        zm[2*i+1] = 0.0;
+      }
+    }
+  }
+
+  fft_1d(plan->rwork,1,0,plan);
+
+  for (int m = 0; m < nlines; m += 2) {
+    const FFT_SCALAR *zm = &z[m*n];
+    FFT_SCALAR *ha = &out[2*m*nh];
+    FFT_SCALAR *hb = &out[2*(m+1)*nh];
+    const int both = (m+1 < nlines);
+    for (int k = 0; k < nh; k++) {
+      const int c = (k == 0) ? 0 : n-k;
+      const FFT_SCALAR zr = zm[2*k];
+      const FFT_SCALAR zi = zm[2*k+1];
+      const FFT_SCALAR cr = zm[2*c];
+      const FFT_SCALAR ci = zm[2*c+1];
+      ha[2*k] = 0.5*(zr+cr);
+      ha[2*k+1] = 0.5*(zi-ci);
+      if (both) {
+        hb[2*k] = 0.5*(zi+ci);
+        hb[2*k+1] = -0.5*(zr-cr);
+      }
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   complex-to-real 1d FFTs along the fast axis, inverse of fft_1d_r2c()
+   in = nlines half spectra of length nhalf, out = nlines real lines
+   the spectra A,B of lines 2m and 2m+1 are extended by Hermitian symmetry
+     and transformed together as Z = A + iB, line 2m = Re z, 2m+1 = Im z
+   imaginary parts of the k = 0 and k = N/2 coefficients are ignored
+   in and out may be the same
+------------------------------------------------------------------------- */
+
+static void fft_1d_c2r(FFT_SCALAR *in, FFT_SCALAR *out, struct fft_plan_3d *plan)
+{
+  const int n = plan->nreal;
+  const int nh = plan->nhalf;
+  const int nlines = plan->nlines;
+  FFT_SCALAR *z = (FFT_SCALAR *) plan->rwork;
+
+  for (int m = 0; m < nlines; m += 2) {
+    const FFT_SCALAR *ha = &in[2*m*nh];
+    const FFT_SCALAR *hb = &in[2*(m+1)*nh];
+    const int both = (m+1 < nlines);
+    FFT_SCALAR *zm = &z[m*n];
+    for (int k = 0; k < n; k++) {
+      FFT_SCALAR ar,ai,br,bi;
+      if (k < nh) {
+        ar = ha[2*k];
+        ai = ha[2*k+1];
+        br = both ? hb[2*k] : 0.0;
+        bi = both ? hb[2*k+1] : 0.0;
+      } else {
+        ar = ha[2*(n-k)];
+        ai = -ha[2*(n-k)+1];
+        br = both ? hb[2*(n-k)] : 0.0;
+        bi = both ? -hb[2*(n-k)+1] : 0.0;
+      }
+      if (k == 0 || 2*k == n) ai = bi = 0.0;
+      zm[2*k] = ar - bi;
+      zm[2*k+1] = ai + br;
+    }
+  }
+
+  fft_1d(plan->rwork,-1,0,plan);
+
+  for (int m = 0; m < nlines; m += 2) {
+    const FFT_SCALAR *zm = &z[m*n];
+    FFT_SCALAR *a = &out[m*n];
+    if (m+1 < nlines) {
+      FFT_SCALAR *b = &out[(m+1)*n];
+      for (int i = 0; i < n; i++) {
+        a[i] = zm[2*i];
+        b[i] = zm[2*i+1];
+      }
+    } else {
+      for (int i = 0; i < n; i++) a[i] = zm[2*i];
+    }
+  }
+}
+
+#endif
@@ -108,6 +108,12 @@ struct fft_plan_3d {
   int length1, length2, length3;      // length of 1st,2nd,3rd FFTs
   int pre_target;                     // where to put remap results
   int mid1_target, mid2_target;
+  int real_target;                    // where to put fast-axis results of real FFTs
+  int real;       // 0 = complex, 1 = real-to-complex, -1 = complex-to-real
+  int nreal;      // length of real lines along fast axis
+  int nhalf;      // length of half-spectrum lines = nreal/2+1
+  int nlines;     // # of real lines along fast axis on this proc
+  FFT_DATA *rwork;    // pairs of real lines packed into complex lines
   int scaled;     // whether to scale FFT results
   int normnum;    // # of values to rescale
   double norm;    // normalization factor for rescaling
@@ -140,6 +146,12 @@ extern "C" {
 void fft_3d(FFT_DATA *, FFT_DATA *, int, struct fft_plan_3d *);
 struct fft_plan_3d *fft_3d_create_plan(MPI_Comm, int, int, int, int, int, int, int, int, int, int,
                                        int, int, int, int, int, int, int, int *, int);
+#if defined(FFT_KISS)
+void fft_3d_r2c(FFT_SCALAR *, FFT_DATA *, struct fft_plan_3d *);
+void fft_3d_c2r(FFT_DATA *, FFT_SCALAR *, struct fft_plan_3d *);
+struct fft_plan_3d *fft_3d_create_plan_real(MPI_Comm, int, int, int, int, int, int, int, int, int,
+                                            int, int, int, int, int, int, int, int, int *, int);
+#endif
 void fft_3d_destroy_plan(struct fft_plan_3d *);
 void factor(int, int *, int *);
 void bifactor(int, int *, int *);
@@ -25,15 +25,31 @@ FFT3d::FFT3d(LAMMPS *lmp, MPI_Comm comm, int nfast, int nmid, int nslow,
              int in_klo, int in_khi,
              int out_ilo, int out_ihi, int out_jlo, int out_jhi,
              int out_klo, int out_khi,
-             int scaled, int permute, int *nbuf, int usecollective) : Pointers(lmp)
+             int scaled, int permute, int *nbuf, int usecollective,
+             int real) : Pointers(lmp)
 {
+  // real = FORWARD: real input, half spectrum output with fast index
+  //          0 to nfast/2, real = BACKWARD: the reverse, see fft3d.cpp
+
   #ifndef FFT_HEFFTE
-  plan = fft_3d_create_plan(comm,nfast,nmid,nslow,
-                            in_ilo,in_ihi,in_jlo,in_jhi,in_klo,in_khi,
-                            out_ilo,out_ihi,out_jlo,out_jhi,out_klo,out_khi,
-                            scaled,permute,nbuf,usecollective);
+  if (real) {
+#if defined(FFT_KISS)
+    if (permute) error->all(FLERR,"Cannot permute indices of a real 3d FFT");
+    plan = fft_3d_create_plan_real(comm,nfast,nmid,nslow,
+                                   in_ilo,in_ihi,in_jlo,in_jhi,in_klo,in_khi,
+                                   out_ilo,out_ihi,out_jlo,out_jhi,out_klo,out_khi,
+                                   scaled,real,nbuf,usecollective);
+#else
+    error->all(FLERR,"Real 3d FFTs require the KISS FFT library");
+#endif
+  } else
+    plan = fft_3d_create_plan(comm,nfast,nmid,nslow,
+                              in_ilo,in_ihi,in_jlo,in_jhi,in_klo,in_khi,
+                              out_ilo,out_ihi,out_jlo,out_jhi,out_klo,out_khi,
+                              scaled,permute,nbuf,usecollective);
   if (plan == nullptr) error->one(FLERR,"Could not create 3d FFT plan");
   #else
+  if (real) error->all(FLERR,"Real 3d FFTs are not supported with heFFTe");
   heffte::plan_options options = heffte::default_options<heffte_backend>();
   options.algorithm = (usecollective == 0) ?
                           heffte::reshape_algorithm::p2p_plined
@@ -66,7 +82,16 @@ FFT3d::~FFT3d()
 void FFT3d::compute(FFT_SCALAR *in, FFT_SCALAR *out, int flag)
 {
   #ifndef FFT_HEFFTE
-  fft_3d((FFT_DATA *) in,(FFT_DATA *) out,flag,plan);
+  // the direction of real FFTs is fixed by their plan
+
+  if (plan->real) {
+    if (flag != plan->real)
+      error->one(FLERR,"Direction {} does not match real 3d FFT plan",flag);
+#if defined(FFT_KISS)
+    if (plan->real == FORWARD) fft_3d_r2c(in,(FFT_DATA *) out,plan);
+    else fft_3d_c2r((FFT_DATA *) in,out,plan);
+#endif
+  } else fft_3d((FFT_DATA *) in,(FFT_DATA *) out,flag,plan);
   #else
   if (flag == 1)
       heffte_plan->forward(reinterpret_cast<std::complex<FFT_SCALAR>*>(in),
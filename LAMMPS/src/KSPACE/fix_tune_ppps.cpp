@@ -0,0 +1,447 @@
+// clang-format off
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "fix_tune_ppps.h"
+
+#include "atom.h"
+#include "comm.h"
+#include "compute.h"
+#include "error.h"
+#include "force.h"
+#include "kspace.h"
+#include "modify.h"
+#include "neighbor.h"
+#include "pair.h"
+#include "ppps.h"
+#include "timer.h"
+#include "update.h"
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+using namespace LAMMPS_NS;
+using namespace FixConst;
+
+static constexpr double CUT_TOL = 1.0e-6;    // relative tolerance for equal cutoffs
+
+/* ----------------------------------------------------------------------
+   least squares fit of y = c[0]*x1 + c[1]*x2 with non-negative c,
+   else of a single multiple of w1*x1 + w2*x2
+------------------------------------------------------------------------- */
+
+static void fit2(const std::vector<double> &x1, const std::vector<double> &x2,
+                 const std::vector<double> &y, double w1, double w2, double *c)
+{
+  const int n = y.size();
+  double a11 = 0.0, a12 = 0.0, a22 = 0.0, b1 = 0.0, b2 = 0.0;
+  for (int i = 0; i < n; i++) {
+    a11 += x1[i]*x1[i];
+    a12 += x1[i]*x2[i];
+    a22 += x2[i]*x2[i];
+    b1 += x1[i]*y[i];
+    b2 += x2[i]*y[i];
+  }
+
+  const double det = a11*a22 - a12*a12;
+  if (det > 1.0e-8*a11*a22) {
+    c[0] = (b1*a22 - b2*a12)/det;
+    c[1] = (b2*a11 - b1*a12)/det;
+    if (c[0] >= 0.0 && c[1] >= 0.0) return;
+  }
+
+  double zz = 0.0, zy = 0.0;
+  for (int i = 0; i < n; i++) {
+    const double z = w1*x1[i] + w2*x2[i];
+    zz += z*z;
+    zy += z*y[i];
+  }
+  const double s = (zz > 0.0) ? zy/zz : 0.0;
+  c[0] = s*w1;
+  c[1] = s*w2;
+}
+
+/* ---------------------------------------------------------------------- */
+
+FixTunePPPS::FixTunePPPS(LAMMPS *lmp, int narg, char **arg) :
+  Fix(lmp, narg, arg)
+{
+  if (narg < 4) utils::missing_cmd_args(FLERR,"fix tune/ppps",error);
+
+  global_freq = 1;
+
+  nevery = utils::inumeric(FLERR,arg[3],false,lmp);
+  if (nevery <= 0) error->all(FLERR,"Illegal fix tune/ppps nevery value: {}",nevery);
+
+  // defaults that depend on the initial setting are set in build_trials()
+
+  ntry_max = 10;
+  ncut = 5;
+  cut_lo = cut_hi = -1.0;
+  order_lo = 2;
+  order_hi = 8;
+  spread_lo = spread_hi = -1.0;
+
+  int iarg = 4;
+  while (iarg < narg) {
+    if (strcmp(arg[iarg],"cutoff") == 0) {
+      if (iarg+4 > narg) utils::missing_cmd_args(FLERR,"fix tune/ppps cutoff",error);
+      cut_lo = utils::numeric(FLERR,arg[iarg+1],false,lmp);
+      cut_hi = utils::numeric(FLERR,arg[iarg+2],false,lmp);
+      ncut = utils::inumeric(FLERR,arg[iarg+3],false,lmp);
+      if (cut_lo <= 0.0 || cut_hi < cut_lo || ncut < 1)
+        error->all(FLERR,"Illegal fix tune/ppps cutoff values");
+      iarg += 4;
+    } else if (strcmp(arg[iarg],"order") == 0) {
+      if (iarg+3 > narg) utils::missing_cmd_args(FLERR,"fix tune/ppps order",error);
+      order_lo = utils::inumeric(FLERR,arg[iarg+1],false,lmp);
+      order_hi = utils::inumeric(FLERR,arg[iarg+2],false,lmp);
+      if (order_lo < 2 || order_hi < order_lo)
+        error->all(FLERR,"Illegal fix tune/ppps order values");
+      iarg += 3;
+    } else if (strcmp(arg[iarg],"spreading") == 0) {
+      if (iarg+3 > narg) utils::missing_cmd_args(FLERR,"fix tune/ppps spreading",error);
+      spread_lo = utils::numeric(FLERR,arg[iarg+1],false,lmp);
+      spread_hi = utils::numeric(FLERR,arg[iarg+2],false,lmp);
+      if (spread_lo <= 0.0 || spread_hi < spread_lo || spread_hi >= 1.0)
+        error->all(FLERR,"Illegal fix tune/ppps spreading values");
+      iarg += 3;
+    } else if (strcmp(arg[iarg],"ntry") == 0) {
+      if (iarg+2 > narg) utils::missing_cmd_args(FLERR,"fix tune/ppps ntry",error);
+      ntry_max = utils::inumeric(FLERR,arg[iarg+1],false,lmp);
+      if (ntry_max < 1) error->all(FLERR,"Illegal fix tune/ppps ntry value: {}",ntry_max);
+      iarg += 2;
+    } else error->all(FLERR,"Unknown fix tune/ppps keyword: {}",arg[iarg]);
+  }
+
+  resume = 1;
+  done = 0;
+  current = 0;
+  last_step = 0;
+  last_total = last_pair = last_kspace = 0.0;
+  pair_coeff[0] = pair_coeff[1] = 0.0;
+  kspace_coeff[0] = kspace_coeff[1] = 0.0;
+  other_time = 0.0;
+
+  // set up reneighboring
+
+  force_reneighbor = 1;
+  next_reneighbor = update->ntimestep + 1;
+}
+
+/* ---------------------------------------------------------------------- */
+
+int FixTunePPPS::setmask()
+{
+  int mask = 0;
+  mask |= PRE_EXCHANGE;
+  return mask;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixTunePPPS::init()
+{
+  if (!force->kspace || !dynamic_cast<PPPS *>(force->kspace))
+    error->all(FLERR,"Fix tune/ppps requires a ppps kspace style");
+  if (!force->pair)
+    error->all(FLERR,"Cannot use fix tune/ppps without a pair style");
+  if (force->kspace->tip4pflag)
+    error->all(FLERR,"Cannot use fix tune/ppps with TIP4P water");
+
+  // the electrode matrix depends on the cutoff and mesh and is not rebuilt
+
+  if (utils::strmatch(force->kspace_style,"^ppps/electrode"))
+    error->all(FLERR,"Cannot use fix tune/ppps with kspace style {}",force->kspace_style);
+
+  int itmp;
+  if (!force->pair->extract("cut_coul",itmp))
+    error->all(FLERR,"Pair style {} does not support fix tune/ppps",force->pair_style);
+
+  // timers restart with every run, so resume measuring the current trial
+
+  if (!done) {
+    resume = 1;
+    next_reneighbor = update->ntimestep + 1;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   measure the current setting and switch to the next one
+------------------------------------------------------------------------- */
+
+void FixTunePPPS::pre_exchange()
+{
+  if (done) return;
+  if (next_reneighbor != update->ntimestep) return;
+  next_reneighbor = update->ntimestep + nevery;
+
+  double total, pair, kspace;
+
+  if (resume) {
+    if (trials.empty()) build_trials();
+    read_timers(last_total,last_pair,last_kspace);
+    last_step = update->ntimestep;
+    resume = 0;
+    return;
+  }
+
+  // times per step since the last switch, averaged over procs
+
+  read_timers(total,pair,kspace);
+  const double nsteps = update->ntimestep - last_step;
+  double t[3], t_all[3];
+  t[0] = (total - last_total)/nsteps;
+  t[1] = (pair - last_pair)/nsteps;
+  t[2] = (kspace - last_kspace)/nsteps;
+  MPI_Allreduce(t,t_all,3,MPI_DOUBLE,MPI_SUM,world);
+  for (double &v : t_all) v /= comm->nprocs;
+
+  Trial &trial = trials[current];
+  trial.time = t_all[0];
+  measured.push_back(current);
+  time_pair.push_back(t_all[1]);
+  time_kspace.push_back(t_all[2]);
+  time_other.push_back(t_all[0] - t_all[1] - t_all[2]);
+
+  if (comm->me == 0)
+    utils::logmesg(lmp,"fix tune/ppps: cutoff {:.6g} spreading {:.3g} order {} mesh {} {} {}: "
+                   "{:.6g} s/step, pair {:.6g}, kspace {:.6g}\n",
+                   trial.cutoff,trial.spreading,trial.order,trial.mesh[0],trial.mesh[1],
+                   trial.mesh[2],t_all[0],t_all[1],t_all[2]);
+
+  int next = select_trial();
+
+  // switch to the fastest measured setting when done
+
+  if (next < 0) {
+    next = 0;
+    for (int i = 1; i < (int) trials.size(); i++)
+      if (trials[i].time >= 0.0 && trials[i].time < trials[next].time) next = i;
+    done = 1;
+    next_reneighbor = -1;
+
+    const Trial &best = trials[next];
+    if (comm->me == 0)
+      utils::logmesg(lmp,"fix tune/ppps: fastest of {} settings: cutoff {:.6g} spreading {:.3g} "
+                     "order {} mesh {} {} {}, {:.6g} s/step vs {:.6g} s/step initially\n",
+                     measured.size(),best.cutoff,best.spreading,best.order,best.mesh[0],
+                     best.mesh[1],best.mesh[2],best.time,trials[0].time);
+    if (next == current) return;
+  }
+
+  current = next;
+  apply(trials[current]);
+  read_timers(last_total,last_pair,last_kspace);
+  last_step = update->ntimestep;
+}
+
+/* ----------------------------------------------------------------------
+   wall times of the run, pair and neighbor, and kspace on this proc
+------------------------------------------------------------------------- */
+
+void FixTunePPPS::read_timers(double &total, double &pair, double &kspace)
+{
+  total = timer->elapsed(Timer::TOTAL);
+  pair = timer->get_wall(Timer::PAIR) + timer->get_wall(Timer::NEIGH);
+  kspace = timer->get_wall(Timer::KSPACE);
+}
+
+/* ----------------------------------------------------------------------
+   candidate settings, the initial one first
+   the mesh of each order and spreading accuracy is computed for the
+     initial cutoff and scaled for the others until it is measured
+------------------------------------------------------------------------- */
+
+void FixTunePPPS::build_trials()
+{
+  auto ppps = dynamic_cast<PPPS *>(force->kspace);
+  int itmp;
+  const double cut0 = *((double *) force->pair->extract("cut_coul",itmp));
+  const double acc = force->kspace->accuracy_relative;
+  const double spread0 = force->kspace->spreading_accuracy;
+
+  if (cut_lo < 0.0) {
+    cut_lo = 0.8*cut0;
+    cut_hi = 1.2*cut0;
+  }
+  if (spread_lo < 0.0) {
+    spread_hi = MAX(spread0,acc);
+    spread_lo = MIN(0.1*acc,spread_hi);
+  }
+
+  Trial t0;
+  t0.cutoff = cut0;
+  t0.spreading = spread0;
+  t0.order = force->kspace->order;
+  t0.mesh[0] = force->kspace->nx_pppm;
+  t0.mesh[1] = force->kspace->ny_pppm;
+  t0.mesh[2] = force->kspace->nz_pppm;
+  t0.exact = 1;
+  t0.time = -1.0;
+  trials.push_back(t0);
+
+  std::vector<double> cuts;
+  for (int i = 0; i < ncut; i++) {
+    double cut = cut_lo;
+    if (ncut > 1) cut += i*(cut_hi-cut_lo)/(ncut-1);
+    if (fabs(cut-cut0) < CUT_TOL*cut0) cut = cut0;
+    cuts.push_back(cut);
+  }
+
+  // spreading accuracies in factors of 10 down from spread_hi
+
+  for (double spread = spread_hi; spread >= spread_lo*(1.0-CUT_TOL); spread *= 0.1) {
+    for (int order = order_lo; order <= order_hi; order++) {
+      int mesh0[3];
+      if (!ppps->tune_mesh(cut0,order,spread,mesh0)) continue;
+
+      for (double cut : cuts) {
+        Trial t;
+        t.cutoff = cut;
+        t.spreading = spread;
+        t.order = order;
+        t.exact = (cut == cut0);
+        for (int d = 0; d < 3; d++)
+          t.mesh[d] = t.exact ? mesh0[d] : static_cast<int>(ceil(mesh0[d]*cut0/cut));
+        t.time = -1.0;
+        if (t.exact && t.order == t0.order && t.mesh[0] == t0.mesh[0] &&
+            t.mesh[1] == t0.mesh[1] && t.mesh[2] == t0.mesh[2] &&
+            fabs(spread-spread0) < CUT_TOL*spread0) continue;
+        trials.push_back(t);
+      }
+    }
+  }
+
+  if (comm->me == 0)
+    utils::logmesg(lmp,"fix tune/ppps: {} candidate settings, measuring at most {} "
+                   "for {} steps each\n",trials.size(),ntry_max,nevery);
+}
+
+/* ----------------------------------------------------------------------
+   fit the cost model to all measured settings
+------------------------------------------------------------------------- */
+
+void FixTunePPPS::fit_model()
+{
+  const double skin = neighbor->skin;
+  const double natoms = atom->natoms;
+  const double nfft = (force->kspace->differentiation_flag == 1) ? 2.0 : 4.0;
+  const int n = measured.size();
+
+  std::vector<double> one(n,1.0), cube(n), spread(n), fft(n);
+  other_time = 0.0;
+  for (int i = 0; i < n; i++) {
+    const Trial &t = trials[measured[i]];
+    const double ngrid = (double) t.mesh[0]*t.mesh[1]*t.mesh[2];
+    cube[i] = pow(t.cutoff+skin,3.0);
+    spread[i] = natoms*t.order*t.order*t.order;
+    fft[i] = nfft*ngrid*log2(ngrid);
+    other_time += time_other[i]/n;
+  }
+
+  // until two cutoffs are measured, the pair time is taken proportional to
+  //   the neighbor volume, the kspace time to PPPS::estimated_cost()
+
+  fit2(one,cube,time_pair,0.0,1.0,pair_coeff);
+  fit2(spread,fft,time_kspace,2.0,2.5,kspace_coeff);
+}
+
+/* ---------------------------------------------------------------------- */
+
+double FixTunePPPS::predict(const Trial &t)
+{
+  const double skin = neighbor->skin;
+  const double natoms = atom->natoms;
+  const double nfft = (force->kspace->differentiation_flag == 1) ? 2.0 : 4.0;
+  const double ngrid = (double) t.mesh[0]*t.mesh[1]*t.mesh[2];
+
+  return other_time + pair_coeff[0] + pair_coeff[1]*pow(t.cutoff+skin,3.0) +
+    kspace_coeff[0]*natoms*t.order*t.order*t.order + kspace_coeff[1]*nfft*ngrid*log2(ngrid);
+}
+
+/* ----------------------------------------------------------------------
+   unmeasured setting with the lowest predicted time, with its exact mesh
+   return -1 if none is predicted to beat the fastest measured one
+------------------------------------------------------------------------- */
+
+int FixTunePPPS::select_trial()
+{
+  if ((int) measured.size() >= ntry_max) return -1;
+
+  auto ppps = dynamic_cast<PPPS *>(force->kspace);
+  double best_time = std::numeric_limits<double>::infinity();
+  for (const Trial &t : trials)
+    if (t.time >= 0.0) best_time = MIN(best_time,t.time);
+
+  fit_model();
+
+  while (true) {
+    int next = -1;
+    double next_time = 0.0;
+    for (int i = 0; i < (int) trials.size(); i++) {
+      if (trials[i].time >= 0.0) continue;
+      const double time = predict(trials[i]);
+      if (next < 0 || time < next_time) {
+        next = i;
+        next_time = time;
+      }
+    }
+
+    if (next < 0 || next_time >= best_time) return -1;
+
+    // the scaled mesh is replaced by the exact one and the trial predicted again
+    // settings that cannot meet the accuracy are marked as measured but never chosen
+
+    Trial &t = trials[next];
+    if (t.exact) return next;
+    t.exact = 1;
+    if (!ppps->tune_mesh(t.cutoff,t.order,t.spreading,t.mesh))
+      t.time = std::numeric_limits<double>::infinity();
+  }
+}
+
+/* ----------------------------------------------------------------------
+   switch the pair and kspace styles to a setting
+   other kspace_modify settings of the kspace style are kept
+------------------------------------------------------------------------- */
+
+void FixTunePPPS::apply(const Trial &t)
+{
+  int itmp;
+  auto p_cutoff = (double *) force->pair->extract("cut_coul",itmp);
+  *p_cutoff = t.cutoff;
+
+  auto ppps = dynamic_cast<PPPS *>(force->kspace);
+  ppps->set_accuracy(ppps->accuracy_relative,t.spreading);
+
+  auto words = utils::split_words(fmt::format("mesh {} {} {} order {}",t.mesh[0],t.mesh[1],
+                                              t.mesh[2],t.order));
+  std::vector<char *> margs;
+  for (auto &word : words) margs.push_back((char *) word.c_str());
+  force->kspace->modify_params((int) margs.size(),margs.data());
+
+  // initialize pair and kspace styles, neighbor lists and ghost cutoff
+  //   for the new cutoff, then set up the Green's function
+
+  force->init();
+  neighbor->init();
+  comm->setup();
+  if (neighbor->style) neighbor->setup_bins();
+  force->kspace->setup();
+
+  // re-init computes to update pointers to virials, etc.
+
+  for (auto &compute : modify->get_compute_list()) compute->init();
+}
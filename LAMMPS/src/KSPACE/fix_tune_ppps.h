@@ -0,0 +1,83 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef FIX_CLASS
+// clang-format off
+FixStyle(tune/ppps,FixTunePPPS);
+// clang-format on
+#else
+
+#ifndef LMP_FIX_TUNE_PPPS_H
+#define LMP_FIX_TUNE_PPPS_H
+
+#include "fix.h"
+
+#include <vector>
+
+namespace LAMMPS_NS {
+
+class FixTunePPPS : public Fix {
+ public:
+  FixTunePPPS(class LAMMPS *, int, char **);
+
+  int setmask() override;
+  void init() override;
+  void pre_exchange() override;
+
+ private:
+  struct Trial {
+    double cutoff;       // Coulomb cutoff of the pair style
+    double spreading;    // spreading accuracy
+    int order;           // stencil order
+    int mesh[3];         // FFT grid
+    int exact;           // 1 if mesh is from PPPS::tune_mesh(), 0 if scaled with the cutoff
+    double time;         // measured time per step, negative if not yet measured
+  };
+
+  int nevery;
+  int ntry_max;                     // most settings measured, including the initial one
+  int ncut;                         // number of cutoffs in [cut_lo,cut_hi]
+  double cut_lo, cut_hi;
+  int order_lo, order_hi;
+  double spread_lo, spread_hi;
+
+  int resume;                       // 1 to restart the timers before measuring
+  int done;                         // 1 once the best setting is in place
+  int current;                      // trial measured since the last pre_exchange()
+  std::vector<Trial> trials;
+
+  // measured times per step of the trials, for fitting the cost model
+
+  std::vector<double> time_pair, time_kspace, time_other;
+  std::vector<int> measured;
+
+  bigint last_step;
+  double last_total, last_pair, last_kspace;
+
+  // cost model: time = other + pair_coeff[0] + pair_coeff[1]*(cutoff+skin)^3
+  //   + kspace_coeff[0]*natoms*order^3 + kspace_coeff[1]*nfft*M*log2(M)
+
+  double pair_coeff[2], kspace_coeff[2], other_time;
+
+  void build_trials();
+  void fit_model();
+  double predict(const Trial &);
+  int select_trial();
+  void apply(const Trial &);
+  void read_timers(double &, double &, double &);
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
+#endif
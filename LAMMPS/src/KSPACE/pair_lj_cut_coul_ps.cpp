@@ -21,7 +21,6 @@
 #include "atom.h"
 #include "comm.h"
 #include "error.h"
-#include "ewald_const.h"
 #include "force.h"
 #include "kspace.h"
 #include "math_const.h"
@@ -36,7 +35,6 @@
 
 using namespace LAMMPS_NS;
 using namespace MathConst;
-using namespace EwaldConst;
 
 /* ---------------------------------------------------------------------- */
 
@@ -82,7 +80,7 @@ void PairLJCutCoulPs::compute(int eflag, int vflag)
   double qtmp,xtmp,ytmp,ztmp,delx,dely,delz,evdwl,ecoul,fpair;
   double fraction,table;
   double r,r2inv,r6inv,forcecoul,forcelj,factor_coul,factor_lj;
-  double grij,expm2,prefactor,t,erfc;
+  double prefactor;
   int *ilist,*jlist,*numneigh,**firstneigh;
   double rsq;
 
@@ -134,20 +132,9 @@ void PairLJCutCoulPs::compute(int eflag, int vflag)
         if (rsq < cut_coulsq) {
           if (!ncoultablebits || rsq <= tabinnersq) {
             r = sqrt(rsq);
-            //printf("rsq: %f",rsq);
-            // Polynomial approximation
-            double force_poly_appx = force_poly_coeff[0];
-            double force_poly_r = 1.0;
-            double r_scal = r/cut_coul;
-
-            for(int index=1; index<num_of_force_poly; index++){
-               force_poly_r *= r_scal;
-               force_poly_appx += force_poly_coeff[index] * force_poly_r;
-               //printf("tabinnersq: %f, rsq: %f, r: %f, force_poly_appx: %f, coeff: %f\n", tabinnersq, rsq, r_scal, force_poly_appx, force_poly_coeff[index]);
-            }
-
             prefactor = qqrd2e * qtmp* q[j] / r;
-            forcecoul = prefactor * force_poly_appx; 
+            forcecoul = prefactor * PSWFPoly::piecewise(force_poly_coeff,num_of_force_poly,
+                                                        num_of_poly_pieces,r/cut_coul);
             if (factor_coul < 1.0) forcecoul -= (1.0-factor_coul)*prefactor;
           } else {
             union_int_float_t rsq_lookup;
@@ -184,19 +171,9 @@ void PairLJCutCoulPs::compute(int eflag, int vflag)
 
         if (eflag) {
           if (rsq < cut_coulsq) { 
-            if (!ncoultablebits || rsq <= tabinnersq){
-              double energy_poly_appx = energy_poly_coeff[0];
-              double energy_poly_r = 1.0;
-              double r_scal = r/cut_coul;
-              for(int index = 1; index<num_of_energy_poly; index++){
-                energy_poly_r *= r_scal;
-                energy_poly_appx = energy_poly_appx + energy_poly_coeff[index] * energy_poly_r;
-                //printf("tabinnersq: %f, rsq: %f, r: %f, energy_poly_appx: %f\n  coeff: %f\n", tabinnersq, rsq, r_scal, energy_poly_appx, energy_poly_coeff[i]);
-              } 
-              //printf("rsq: %f, r: %f, energy_poly_appx: %f\n", rsq, r_scal, energy_poly_appx); 
-              //printf("%f   %f    %f\n", energy_poly_coeff[0], energy_poly_coeff[1], energy_poly_coeff[2]);
-              ecoul = prefactor * energy_poly_appx;
-            }
+            if (!ncoultablebits || rsq <= tabinnersq)
+              ecoul = prefactor * PSWFPoly::piecewise(energy_poly_coeff,num_of_energy_poly,
+                                                      num_of_poly_pieces,r/cut_coul);
             else {
               table = etable[itable] + fraction*detable[itable];
               ecoul = qtmp * q[j] * table;
@@ -407,7 +384,7 @@ void PairLJCutCoulPs::compute_outer(int eflag, int vflag)
   double qtmp,xtmp,ytmp,ztmp,delx,dely,delz,evdwl,ecoul,fpair;
   double fraction,table;
   double r,r2inv,r6inv,forcecoul,forcelj,factor_coul,factor_lj;
-  double grij,expm2,prefactor,t,erfc;
+  double prefactor,fpswf;
   double rsw;
   int *ilist,*jlist,*numneigh,**firstneigh;
   double rsq;
@@ -467,12 +444,10 @@ void PairLJCutCoulPs::compute_outer(int eflag, int vflag)
         if (rsq < cut_coulsq) {
           if (!ncoultablebits || rsq <= tabinnersq) {
             r = sqrt(rsq);
-            grij = g_ewald * r;
-            expm2 = exp(-grij*grij);
-            t = 1.0 / (1.0 + EWALD_P*grij);
-            erfc = t * (A1+t*(A2+t*(A3+t*(A4+t*A5)))) * expm2;
             prefactor = qqrd2e * qtmp * q[j] / r;
-            forcecoul = prefactor * (erfc + EWALD_F*grij*expm2 - 1.0);
+            fpswf = PSWFPoly::piecewise(force_poly_coeff,num_of_force_poly,
+                                        num_of_poly_pieces,r/cut_coul);
+            forcecoul = prefactor * (fpswf - 1.0);
 
             if (rsq > cut_in_off_sq) {
               if (rsq < cut_in_on_sq) {
@@ -526,7 +501,9 @@ void PairLJCutCoulPs::compute_outer(int eflag, int vflag)
         if (eflag) {
           if (rsq < cut_coulsq) {
             if (!ncoultablebits || rsq <= tabinnersq) {
-              ecoul = prefactor*erfc;
+              ecoul = prefactor *
+                PSWFPoly::piecewise(energy_poly_coeff,num_of_energy_poly,
+                                    num_of_poly_pieces,r/cut_coul);
               if (factor_coul < 1.0) ecoul -= (1.0-factor_coul)*prefactor;
             } else {
               table = etable[itable] + fraction*detable[itable];
@@ -550,7 +527,7 @@ void PairLJCutCoulPs::compute_outer(int eflag, int vflag)
         if (vflag) {
           if (rsq < cut_coulsq) {
             if (!ncoultablebits || rsq <= tabinnersq) {
-              forcecoul = prefactor * (erfc + EWALD_F*grij*expm2);
+              forcecoul = prefactor * fpswf;
               if (factor_coul < 1.0) forcecoul -= (1.0-factor_coul)*prefactor;
             } else {
               table = vtable[itable] + fraction*dvtable[itable];
@@ -699,6 +676,11 @@ void PairLJCutCoulPs::init_style()
   num_of_force_poly = force->kspace->num_of_force_poly;
   energy_poly_coeff = force->kspace->energy_poly_coeff;
   num_of_energy_poly = force->kspace->num_of_energy_poly;
+  num_of_poly_pieces = force->kspace->num_of_poly_pieces;
+
+  if ((num_of_force_poly < 1) || (num_of_force_poly > PSWFPoly::MAXPOLY) ||
+      (num_of_energy_poly < 1) || (num_of_energy_poly > PSWFPoly::MAXPOLY))
+    error->all(FLERR,"Unsupported PSWF polynomial degree for pair style lj/cut/coul/ps");
 
   // setup force tables
 
@@ -891,7 +873,7 @@ double PairLJCutCoulPs::single(int i, int j, int itype, int jtype,
                                  double factor_coul, double factor_lj,
                                  double &fforce)
 {
-  double r2inv,r6inv,r,grij,expm2,t,erfc,prefactor;
+  double r2inv,r6inv,r,prefactor;
   double fraction,table,forcecoul,forcelj,phicoul,philj;
   int itable;
 
@@ -899,12 +881,9 @@ double PairLJCutCoulPs::single(int i, int j, int itype, int jtype,
   if (rsq < cut_coulsq) {
     if (!ncoultablebits || rsq <= tabinnersq) {
       r = sqrt(rsq);
-      grij = g_ewald * r;
-      expm2 = exp(-grij*grij);
-      t = 1.0 / (1.0 + EWALD_P*grij);
-      erfc = t * (A1+t*(A2+t*(A3+t*(A4+t*A5)))) * expm2;
       prefactor = force->qqrd2e * atom->q[i]*atom->q[j]/r;
-      forcecoul = prefactor * (erfc + EWALD_F*grij*expm2);
+      forcecoul = prefactor * PSWFPoly::piecewise(force_poly_coeff,num_of_force_poly,
+                                                  num_of_poly_pieces,r/cut_coul);
       if (factor_coul < 1.0) forcecoul -= (1.0-factor_coul)*prefactor;
     } else {
       union_int_float_t rsq_lookup_single;
@@ -932,7 +911,8 @@ double PairLJCutCoulPs::single(int i, int j, int itype, int jtype,
   double eng = 0.0;
   if (rsq < cut_coulsq) {
     if (!ncoultablebits || rsq <= tabinnersq)
-      phicoul = prefactor*erfc;
+      phicoul = prefactor * PSWFPoly::piecewise(energy_poly_coeff,num_of_energy_poly,
+                                                num_of_poly_pieces,r/cut_coul);
     else {
       table = etable[itable] + fraction*detable[itable];
       phicoul = atom->q[i]*atom->q[j] * table;
@@ -21,6 +21,7 @@ PairStyle(lj/cut/coul/ps,PairLJCutCoulPs);
 #define LMP_PAIR_LJ_CUT_COUL_PS_H
 
 #include "pair.h"
+#include "pswf_poly.h"
 
 namespace LAMMPS_NS {
 
@@ -57,7 +58,7 @@ class PairLJCutCoulPs : public Pair {
   double qdist;    // TIP4P distance from O site to negative charge
   double g_ewald;
   double *force_poly_coeff, *energy_poly_coeff;
-  int num_of_force_poly, num_of_energy_poly;
+  int num_of_force_poly, num_of_energy_poly, num_of_poly_pieces;
 
   virtual void allocate();
 };
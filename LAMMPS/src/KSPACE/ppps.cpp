@@ -35,9 +35,12 @@
 #include "memory.h"
 #include "neighbor.h"
 #include "pair.h"
+#include "pswf.h"
+#include "timer.h"
+#include "update.h"
 #include "remap_wrap.h"
 
-#include <iostream>
+#include <cctype>
 #include <cmath>
 #include <cstring>
 
@@ -45,12 +48,27 @@ using namespace LAMMPS_NS;
 using namespace MathConst;
 using namespace MathSpecial;
 
-static constexpr int MAXORDER = 8;
+static constexpr int MAXORDER = 16;
 static constexpr int OFFSET = 16384;
 static constexpr double LARGE = 10000.0;
 static constexpr double SMALL = 0.00001;
 static constexpr double EPS_HOC = 1.0e-7;
 static constexpr FFT_SCALAR ZEROF = 0.0;
+static constexpr double POLY_FIT_RATIO = 0.01;    // PSWF polynomial fit error / requested accuracy
+static constexpr int GF_DENOM_ALIAS = 5;    // aliases on either side in the Green's function denominator
+static constexpr double RHO_TABLE_RATIO = 0.1;    // spreading table error / spreading accuracy
+static constexpr int RHO_TABLE_MIN = 256;         // fewest intervals of a spreading table
+static constexpr bigint QOPT_SAMPLES = 1 << 16;   // most grid points sampled by compute_qopt()
+static constexpr int ORDER_AUTO_MIN = 4;          // lowest order tried by select_order()
+static constexpr int ORDER_AUTO_MAX = 10;         // highest order tried by select_order()
+static constexpr double GRID_REFINE_MAX = 4.0;    // finest grid spacing of compute_grid(), relative
+static constexpr int RHO_TABLE_MAX = 1 << 20;     // most intervals of a spreading table
+static constexpr int MAXPIECES = 64;              // most pieces of piecewise kernel polynomials
+
+// Green's function cache file format
+
+static constexpr char GF_CACHE_MAGIC[] = "LMP PPPS GF 2";
+static constexpr int GF_CACHE_VERSION = 2;
 
 /* ---------------------------------------------------------------------- */
 
@@ -66,12 +84,66 @@ PPPS::PPPS(LAMMPS *lmp) : KSpace(lmp),
   gc_buf1(nullptr), gc_buf2(nullptr), density_A_brick(nullptr), density_B_brick(nullptr), density_A_fft(nullptr),
   density_B_fft(nullptr), part2grid(nullptr), boxlo(nullptr)
 {
+  rho1d_kernel = drho1d_kernel = nullptr;
+  rho_pieces = 1;
+  rho1d_pieces_kernel = drho1d_pieces_kernel = nullptr;
+  rho_table_flag = 0;
+  rho_points = 0;
+  rho_scale = rho_table_error = 0.0;
+  rho_lookup = drho_lookup = nullptr;
+  sort_block = 0;
+  sort_nx = sort_ny = sort_nz = 0;
+  nsort_max = 0;
+  part_order = tile_start = nullptr;
+  tile_density = nullptr;
+  rho_cache_max = nrho_cache = nrho_cache_alloc = 0;
+  rho_cache = nullptr;
+  vg_store_flag = 1;
+  // real FFTs are the default only for the validated KISS backend
+
+#if defined(FFT_KISS) && !defined(FFT_HEFFTE)
+  r2c_flag = 1;
+#else
+  r2c_flag = 0;
+#endif
+  nfft_real = 0;
+  fft2_stride = 2;
+  kx_weight = nullptr;
+  force_poly_coeff = energy_poly_coeff = Fourier_poly_coeff = nullptr;
+  Fourier_spreading_coeff = nullptr;
+  num_of_force_poly = num_of_energy_poly = num_of_Fourier_poly = 0;
+  poly_order = Fourier_spreading_order = 0;
+  self_coeff = 0.0;
+  sf_precoeff_flag = 0;
+
+  // order 0 selects the stencil order automatically
+
+  order = 0;
+  order_auto = 0;
+  order_auto_max = ORDER_AUTO_MAX;
+  estimated_accuracy = 0.0;
+
+  phase_flag = 0;
+  phase_last = 0.0;
+  for (int i = 0; i < NPHASE; i++) phase_time[i] = 0.0;
+  for (int d = 0; d < 3; d++) {
+    gf_nb[d] = 0;
+    gf_denom1d[d] = gf_w1d[d] = gf_alt1d[d] = nullptr;
+  }
+  gf_update_tol = 0.0;
+  gf_ref_flag = 0;
+  gf_strain_coeff = gf_error = 0.0;
+  gf_cache_file = nullptr;
+  gf_cache_flag = 0;
   peratom_allocate_flag = 0;
   group_allocate_flag = 0;
 
   pppmflag = 1;
   group_group_enable = 1;
-  triclinic = domain->triclinic;
+
+  // the PSWF Green's function and virial exist only for orthogonal boxes
+
+  triclinic_support = 0;
 
   nfactors = 3;
   factors = new int[nfactors];
@@ -155,11 +227,23 @@ PPPS::PPPS(LAMMPS *lmp) : KSpace(lmp),
 
 void PPPS::settings(int narg, char **arg)
 {
-  if (narg < 1) error->all(FLERR,"Illegal kspace_style {} command", force->kspace_style);
+  // relative splitting accuracy and spreading accuracy are both required
+
+  if (narg < 2) error->all(FLERR,"Illegal kspace_style {} command", force->kspace_style);
 
-  accuracy_relative = fabs(utils::numeric(FLERR, arg[0], false, lmp));
+  set_accuracy(fabs(utils::numeric(FLERR, arg[0], false, lmp)),
+               fabs(utils::numeric(FLERR, arg[1], false, lmp)));
+}
+
+/* ----------------------------------------------------------------------
+   set the splitting and spreading accuracies without parsing other
+     kspace_style arguments, also used by fix tune/ppps
+------------------------------------------------------------------------- */
 
-  spreading_accuracy = fabs(utils::numeric(FLERR, arg[1], false, lmp));
+void PPPS::set_accuracy(double relative, double spreading)
+{
+  accuracy_relative = relative;
+  spreading_accuracy = spreading;
 
   if (accuracy_relative > 1.0 || spreading_accuracy > 1.0)
     error->all(FLERR, "Invalid relative accuracy {:g} or spreading accuracy {:g} for kspace_style {}",
@@ -174,6 +258,61 @@ void PPPS::settings(int narg, char **arg)
                spreading_accuracy, force->kspace_style);
 }
 
+/* ----------------------------------------------------------------------
+   ppps specific kspace_modify options
+------------------------------------------------------------------------- */
+
+int PPPS::modify_param(int narg, char **arg)
+{
+  if (strcmp(arg[0],"cache") == 0) {
+    if (narg < 2) utils::missing_cmd_args(FLERR,"kspace_modify cache",error);
+    delete[] gf_cache_file;
+    gf_cache_file = nullptr;
+    if (strcmp(arg[1],"none") != 0) gf_cache_file = utils::strdup(arg[1]);
+    return 2;
+  } else if (strcmp(arg[0],"gf/update") == 0) {
+    if (narg < 2) utils::missing_cmd_args(FLERR,"kspace_modify gf/update",error);
+    gf_update_tol = utils::numeric(FLERR,arg[1],false,lmp);
+    if (gf_update_tol < 0.0 || gf_update_tol >= 1.0)
+      error->all(FLERR,"Illegal kspace_modify gf/update tolerance {}",gf_update_tol);
+    return 2;
+  } else if (strcmp(arg[0],"spread/table") == 0) {
+    if (narg < 2) utils::missing_cmd_args(FLERR,"kspace_modify spread/table",error);
+    rho_table_flag = utils::logical(FLERR,arg[1],false,lmp);
+    return 2;
+  } else if (strcmp(arg[0],"pieces") == 0) {
+    if (narg < 2) utils::missing_cmd_args(FLERR,"kspace_modify pieces",error);
+    num_of_poly_pieces = utils::inumeric(FLERR,arg[1],false,lmp);
+    if (num_of_poly_pieces < 1 || num_of_poly_pieces > MAXPIECES)
+      error->all(FLERR,"Illegal kspace_modify pieces {}, must be 1 to {}",
+                 num_of_poly_pieces,MAXPIECES);
+    rho_pieces = num_of_poly_pieces;
+    return 2;
+  } else if (strcmp(arg[0],"sort") == 0) {
+    if (narg < 2) utils::missing_cmd_args(FLERR,"kspace_modify sort",error);
+    sort_block = utils::inumeric(FLERR,arg[1],false,lmp);
+    if (sort_block < 0) error->all(FLERR,"Illegal kspace_modify sort tile size {}",sort_block);
+    return 2;
+  } else if (strcmp(arg[0],"virial/store") == 0) {
+    if (narg < 2) utils::missing_cmd_args(FLERR,"kspace_modify virial/store",error);
+    vg_store_flag = utils::logical(FLERR,arg[1],false,lmp);
+    return 2;
+  } else if (strcmp(arg[0],"spread/cache") == 0) {
+    if (narg < 2) utils::missing_cmd_args(FLERR,"kspace_modify spread/cache",error);
+    if (isdigit(arg[1][0])) rho_cache_max = utils::inumeric(FLERR,arg[1],false,lmp);
+    else rho_cache_max = utils::logical(FLERR,arg[1],false,lmp) ? MAXSMALLINT : 0;
+    return 2;
+  } else if (strcmp(arg[0],"fft/r2c") == 0) {
+    if (narg < 2) utils::missing_cmd_args(FLERR,"kspace_modify fft/r2c",error);
+    r2c_flag = utils::logical(FLERR,arg[1],false,lmp);
+#if !defined(FFT_KISS) || defined(FFT_HEFFTE)
+    if (r2c_flag) error->all(FLERR,"Kspace_modify fft/r2c yes requires the KISS FFT library");
+#endif
+    return 2;
+  }
+  return 0;
+}
+
 /* ----------------------------------------------------------------------
    free all memory
 ------------------------------------------------------------------------- */
@@ -187,10 +326,13 @@ PPPS::~PPPS()
   if (peratom_allocate_flag) PPPS::deallocate_peratom();
   if (group_allocate_flag) PPPS::deallocate_groups();
   memory->destroy(part2grid);
+  memory->destroy(part_order);
   memory->destroy(acons);
   memory->destroy(force_poly_coeff);
   memory->destroy(energy_poly_coeff);
   memory->destroy(Fourier_poly_coeff);
+  memory->destroy(Fourier_spreading_coeff);
+  delete[] gf_cache_file;
 }
 
 /* ----------------------------------------------------------------------
@@ -205,13 +347,6 @@ void PPPS::init()
 
   triclinic_check();
 
-  if (triclinic != domain->triclinic)
-    error->all(FLERR,"Must redefine kspace_style after changing to triclinic box");
-
-  if (domain->triclinic && differentiation_flag == 1)
-    error->all(FLERR,"Cannot (yet) use PPPM with triclinic box and kspace_modify diff ad");
-  if (domain->triclinic && slabflag)
-    error->all(FLERR,"Cannot (yet) use PPPM with triclinic box and slab correction");
   if (domain->dimension == 2)
     error->all(FLERR,"Cannot use PPPM with 2d simulation");
 
@@ -226,7 +361,13 @@ void PPPS::init()
       error->all(FLERR,"Incorrect boundaries with slab PPPM");
   }
 
-  if (order < 2 || order > MAXORDER)
+  // order is selected automatically if it is 0 or still the last selected order,
+  //   i.e. kspace_modify order has not been used since
+
+  const int auto_flag = (order == 0) || (order_auto && order == order_auto);
+  if (!auto_flag) order_auto = 0;
+
+  if (!auto_flag && (order < 2 || order > MAXORDER))
     error->all(FLERR,"PPPM order cannot be < 2 or > {}",MAXORDER);
 
   // compute two charge force
@@ -235,7 +376,6 @@ void PPPS::init()
 
   // extract short-range Coulombic cutoff from pair style
 
-  triclinic = domain->triclinic;
   pair_check();
 
   int itmp = 0;
@@ -243,11 +383,26 @@ void PPPS::init()
   if (p_cutoff == nullptr)
     error->all(FLERR,"KSpace style is incompatible with Pair style");
   cutoff = *p_cutoff;
-  
-  //std::cout<<"Before table"<<std::endl;
-  // Build Table for Real Space and Fourier Space Calulations
-  build_table(accuracy_relative, spreading_accuracy);
-  //std::cout<<"After table"<<std::endl;
+
+  // PSWF splitting coefficients for real and Fourier space
+
+  compute_split_coeff();
+
+  // largest |x F'(x)| / F(0) of the Fourier splitting kernel F on [0,1]
+  // bounds the relative Green's function change per unit box strain
+  //   that rescaling by 1/k^2 does not capture
+
+  gf_strain_coeff = 0.0;
+  for (int i = 0; i <= 100; i++) {
+    const double x = 0.01*i;
+    double dfx = 0.0, xpow = 1.0;
+    for (int j = 1; j < num_of_Fourier_poly; j++) {
+      xpow *= x;
+      dfx += j * Fourier_poly_coeff[j] * xpow;
+    }
+    gf_strain_coeff = MAX(gf_strain_coeff,fabs(dfx/Fourier_poly_coeff[0]));
+  }
+
   // if kspace is TIP4P, extract TIP4P params from pair style
   // bond/angle are not yet init(), so ensure equilibrium request is valid
 
@@ -289,6 +444,7 @@ void PPPS::init()
   qqrd2e = force->qqrd2e;
   qsum_qsq();
   natoms_original = atom->natoms;
+  q2 = qsqsum * force->qqrd2e;
 
   // set accuracy (force units) from accuracy_relative or accuracy_absolute
 
@@ -307,15 +463,23 @@ void PPPS::init()
   //   or overlap is allowed, then done
   // else reduce order and try again
 
+  if (auto_flag) select_order();
+
   gc = nullptr;
   int iteration = 0;
   while (order >= minorder) {
+
+    // skip reduced orders whose spreading fit has no stencil kernel
+
+    if (iteration && !spread_fit_supported(spreading_accuracy,order)) {
+      order--;
+      continue;
+    }
+
     if (iteration && me == 0)
       error->warning(FLERR,"Reducing PPPM order b/c stencil extends "
                      "beyond nearest neighbor processor");
 
-    //// if (stagger_flag && !differentiation_flag) compute_gf_denom();
-
     set_grid_global();
     set_grid_local();
     if (overlap_allowed) break;
@@ -341,12 +505,19 @@ void PPPS::init()
   if (!overlap_allowed && !gc->ghost_adjacent())
     error->all(FLERR,"PPPM grid stencil extends beyond nearest neighbor processor");
   if (gc) delete gc;
+  if (auto_flag) order_auto = order;
+
+  // PSWF spreading coefficients depend on the final stencil order
+
+  compute_spread_coeff();
 
   // adjust g_ewald
   //////if (!gewaldflag) adjust_gewald();
 
   // calculate the final accuracy
-  //////double estimated_accuracy = final_accuracy();
+
+  estimated_accuracy = final_accuracy();
+
   // allocate K-space dependent memory
   // don't invoke allocate peratom() or group(), will be allocated when needed
 
@@ -355,8 +526,14 @@ void PPPS::init()
   // pre-compute 1d charge distribution coefficients
 
   compute_gf_denom();
-  if (differentiation_flag == 1) compute_sf_precoeff();
-  //// compute_rho_coeff();
+  compute_rho_coeff();
+
+  // ad self-force coefficients are computed or loaded with the Green's function
+
+  sf_precoeff_flag = 0;
+  gf_cache_flag = 1;
+  gf_ref_flag = 0;
+
   // print stats
 
   int ngrid_max,nfft_both_max;
@@ -366,8 +543,19 @@ void PPPS::init()
   if (me == 0) {
     std::string mesg = fmt::format(" Spreading parameter c = {:.8g}\n",spreading_select_c);
     mesg += fmt::format(" Splitting parameter c = {:.8g}\n",select_c);
+    mesg += fmt::format("  splitting polynomial terms = {} {} {}\n",
+                        num_of_force_poly,num_of_energy_poly,num_of_Fourier_poly);
+    mesg += fmt::format("  spreading polynomial terms = {} {}\n",
+                        poly_order,Fourier_spreading_order);
+    if (num_of_poly_pieces > 1 || rho_pieces > 1)
+      mesg += fmt::format("  real space polynomial pieces = {} {}\n",
+                          num_of_poly_pieces,rho_pieces);
     mesg += fmt::format("  grid = {} {} {}\n",nx_pppm,ny_pppm,nz_pppm);
-    mesg += fmt::format("  stencil order = {}\n",order);
+    mesg += fmt::format("  stencil order = {}{}\n",order,order_auto ? " (automatic)" : "");
+    mesg += fmt::format("  estimated absolute RMS force accuracy = {:.8g}\n",
+                        estimated_accuracy);
+    mesg += fmt::format("  estimated relative force accuracy = {:.8g}\n",
+                        estimated_accuracy/two_charge_force);
     mesg += fmt::format("  estimated relative splitting force accuracy = {:.8g}\n",
                        accuracy_relative);
     mesg += fmt::format("  estimated relative spreading accuracy = {:.8g}\n",
@@ -375,6 +563,25 @@ void PPPS::init()
     mesg += "  using " LMP_FFT_PREC " precision " LMP_FFT_LIB "\n";
     mesg += fmt::format("  3d grid and FFT values/proc = {} {}\n",
                        ngrid_max,nfft_both_max);
+    if (gf_update_tol > 0.0)
+      mesg += fmt::format("  Green's function update tolerance = {:.8g}, "
+                          "estimated relative error <= {:.8g}\n",
+                          gf_update_tol,gf_update_tol*gf_strain_coeff);
+    if (gf_cache_file)
+      mesg += fmt::format("  Green's function cache files = {}.<proc>\n",gf_cache_file);
+    if (rho_table_flag)
+      mesg += fmt::format("  spreading weight table rows = {}, estimated relative error = {:.8g}\n",
+                          rho_points,rho_table_error);
+    if (!vg_store_flag)
+      mesg += fmt::format("  virial coefficients not stored, {:.4g} Mbytes/proc saved\n",
+                          12.0 * nfft_both_max *
+                          sizeof(double) / 1024.0 / 1024.0);
+    if (sort_block)
+      mesg += fmt::format("  atoms sorted by tiles of {}^3 grid points\n",sort_block);
+    if (rho_cache_max == MAXSMALLINT)
+      mesg += "  spreading weights cached for all atoms\n";
+    else if (rho_cache_max)
+      mesg += fmt::format("  spreading weights cached for up to {} atoms/proc\n",rho_cache_max);
     utils::logmesg(lmp,mesg);
   }
 }
@@ -385,11 +592,6 @@ void PPPS::init()
 
 void PPPS::setup()
 {
-  if (triclinic) {
-    setup_triclinic();
-    return;
-  }
-
   // perform some checks to avoid illegal boundaries with read_data
 
   if (slabflag == 0 && domain->nonperiodic > 0)
@@ -400,15 +602,14 @@ void PPPS::setup()
       error->all(FLERR,"Incorrect boundaries with slab PPPM");
   }
 
-  int i,j,k,n;
+  int i,n;
   double *prd;
 
   // volume-dependent factors
   // adjust z dimension for 2d slab PPPM
   // z dimension for 3d PPPM is zprd since slab_volfactor = 1.0
 
-  if (triclinic == 0) prd = domain->prd;
-  else prd = domain->prd_lamda;
+  prd = domain->prd;
 
   double xprd = prd[0];
   double yprd = prd[1];
@@ -445,132 +646,79 @@ void PPPS::setup()
     fkz[i] = unitkz*per;
   }
 
-  // virial coefficients
-
-  double sqk,vterm;
+  // virial coefficients, only if stored
 
-    n = 0;
-  for (k = nzlo_fft; k <= nzhi_fft; k++) {
-    for (j = nylo_fft; j <= nyhi_fft; j++) {
-      for (i = nxlo_fft; i <= nxhi_fft; i++) {
-        sqk = fkx[i]*fkx[i] + fky[j]*fky[j] + fkz[k]*fkz[k];
-        if (sqk == 0.0) {
-          vg[n][0] = 0.0;
-          vg[n][1] = 0.0;
-          vg[n][2] = 0.0;
-          vg[n][3] = 0.0;
-          vg[n][4] = 0.0;
-          vg[n][5] = 0.0;
-          vg2[n][0] = 0.0;
-          vg2[n][1] = 0.0;
-          vg2[n][2] = 0.0;
-          vg2[n][3] = 0.0;
-          vg2[n][4] = 0.0;
-          vg2[n][5] = 0.0;
-        } else {
-          // vterm = -2.0 * (1.0/sqk + 0.25/(g_ewald*g_ewald)); //  Ewald
-          vterm = -2.0 / sqk;
-          vg[n][0] = 1.0 + vterm*fkx[i]*fkx[i];
-          vg[n][1] = 1.0 + vterm*fky[j]*fky[j];
-          vg[n][2] = 1.0 + vterm*fkz[k]*fkz[k];
-          vg[n][3] = vterm*fkx[i]*fky[j];
-          vg[n][4] = vterm*fkx[i]*fkz[k];
-          vg[n][5] = vterm*fky[j]*fkz[k];
-          vg2[n][0] = fkx[i]*fkx[i];
-          vg2[n][1] = fky[j]*fky[j];
-          vg2[n][2] = fkz[k]*fkz[k];
-          vg2[n][3] = fkx[i]*fky[j];
-          vg2[n][4] = fkx[i]*fkz[k];
-          vg2[n][5] = fky[j]*fkz[k];
-        }
-        n++;
-      }
-    }
+  if (vg_store_flag) {
+    double v2[6];
+    for (n = 0; n < nfft; n++) virial_coeff(n,vg[n],vg2 ? vg2[n] : v2);
   }
 
-  if (differentiation_flag == 1) compute_gf_ad();
-  else compute_gf_ik();
+  setup_gf(prd);
 }
 
 /* ----------------------------------------------------------------------
-   adjust PPPM coeffs, called initially and whenever volume has changed
-   for a triclinic system
+   rebuild or rescale the Green's function for box lengths prd
+   with an update tolerance, small box changes only rescale the
+     Green's function, see rescale_gf(), and a rebuild reports the
+     largest error estimate of the rescaled Green's function
 ------------------------------------------------------------------------- */
 
-void PPPS::setup_triclinic()
+void PPPS::setup_gf(const double *prd)
 {
-  int i,j,k,n;
-  double *prd;
-
-  // volume-dependent factors
-  // adjust z dimension for 2d slab PPPM
-  // z dimension for 3d PPPM is zprd since slab_volfactor = 1.0
-
-  prd = domain->prd;
-
-  double xprd = prd[0];
-  double yprd = prd[1];
-  double zprd = prd[2];
-  double zprd_slab = zprd*slab_volfactor;
-  volume = xprd * yprd * zprd_slab;
-
-  // use lamda (0-1) coordinates
-
-  delxinv = nx_pppm;
-  delyinv = ny_pppm;
-  delzinv = nz_pppm;
-  delvolinv = delxinv*delyinv*delzinv/volume;
-
-  // fkx,fky,fkz for my FFT grid pts
-
-  double per_i,per_j,per_k;
-
-  n = 0;
-  for (k = nzlo_fft; k <= nzhi_fft; k++) {
-    per_k = k - nz_pppm*(2*k/nz_pppm);
-    for (j = nylo_fft; j <= nyhi_fft; j++) {
-      per_j = j - ny_pppm*(2*j/ny_pppm);
-      for (i = nxlo_fft; i <= nxhi_fft; i++) {
-        per_i = i - nx_pppm*(2*i/nx_pppm);
-
-        double unitk_lamda[3];
-        unitk_lamda[0] = 2.0*MY_PI*per_i;
-        unitk_lamda[1] = 2.0*MY_PI*per_j;
-        unitk_lamda[2] = 2.0*MY_PI*per_k;
-        x2lamdaT(&unitk_lamda[0],&unitk_lamda[0]);
-        fkx[n] = unitk_lamda[0];
-        fky[n] = unitk_lamda[1];
-        fkz[n] = unitk_lamda[2];
-        n++;
-      }
+  if (gf_update_tol > 0.0 && gf_ref_flag) {
+    double strain = 0.0;
+    for (int d = 0; d < 3; d++) strain = MAX(strain,fabs(prd[d]/gf_prd_ref[d] - 1.0));
+    if (strain < gf_update_tol) {
+      rescale_gf();
+      gf_error = MAX(gf_error,strain*gf_strain_coeff);
+      return;
     }
+    if (me == 0 && gf_error > 0.0)
+      utils::logmesg(lmp,"  PPPS Green's function rebuilt at step {}, max estimated relative "
+                     "error since last rebuild = {:.8g}\n",update->ntimestep,gf_error);
   }
 
-  // virial coefficients
+  compute_gf();
 
-  double sqk,vterm;
+  for (int d = 0; d < 3; d++) gf_prd_ref[d] = gf_prd_last[d] = prd[d];
+  gf_ref_flag = 1;
+  gf_error = 0.0;
+}
 
-  for (n = 0; n < nfft; n++) {
-    sqk = fkx[n]*fkx[n] + fky[n]*fky[n] + fkz[n]*fkz[n];
-    if (sqk == 0.0) {
-      vg[n][0] = 0.0;
-      vg[n][1] = 0.0;
-      vg[n][2] = 0.0;
-      vg[n][3] = 0.0;
-      vg[n][4] = 0.0;
-      vg[n][5] = 0.0;
-    } else {
-      vterm = -2.0 * (1.0/sqk + 0.25/(g_ewald*g_ewald));
-      vg[n][0] = 1.0 + vterm*fkx[n]*fkx[n];
-      vg[n][1] = 1.0 + vterm*fky[n]*fky[n];
-      vg[n][2] = 1.0 + vterm*fkz[n]*fkz[n];
-      vg[n][3] = vterm*fkx[n]*fky[n];
-      vg[n][4] = vterm*fkx[n]*fkz[n];
-      vg[n][5] = vterm*fky[n]*fkz[n];
-    }
+/* ----------------------------------------------------------------------
+   virial coefficients v = vg and v2 = vg2 of FFT point n on my FFT grid
+   called by setup() to store them or by the virial sums if they are not stored
+------------------------------------------------------------------------- */
+
+void PPPS::virial_coeff(int n, double *v, double *v2) const
+{
+  const int nx = nxhi_fft - nxlo_fft + 1;
+  const int ny = nyhi_fft - nylo_fft + 1;
+  const double kx = fkx[nxlo_fft + n % nx];
+  const double ky = fky[nylo_fft + (n / nx) % ny];
+  const double kz = fkz[nzlo_fft + n / (nx*ny)];
+  double vterm;
+
+  const double sqk = kx*kx + ky*ky + kz*kz;
+  if (sqk == 0.0) {
+    for (int d = 0; d < 6; d++) v[d] = v2[d] = 0.0;
+    return;
   }
 
-  compute_gf_ik_triclinic();
+  v2[0] = kx*kx;
+  v2[1] = ky*ky;
+  v2[2] = kz*kz;
+  v2[3] = kx*ky;
+  v2[4] = kx*kz;
+  v2[5] = ky*kz;
+
+  vterm = -2.0 / sqk;
+  v[0] = 1.0 + vterm*v2[0];
+  v[1] = 1.0 + vterm*v2[1];
+  v[2] = 1.0 + vterm*v2[2];
+  v[3] = vterm*v2[3];
+  v[4] = vterm*v2[4];
+  v[5] = vterm*v2[5];
 }
 
 /* ----------------------------------------------------------------------
@@ -603,9 +751,10 @@ void PPPS::reset_grid()
   // pre-compute 1d charge distribution coefficients
 
   compute_gf_denom();
-  if (differentiation_flag == 1) compute_sf_precoeff();
-  
-  ////compute_rho_coeff();
+  compute_rho_coeff();
+  sf_precoeff_flag = 0;
+  gf_cache_flag = 1;
+  gf_ref_flag = 0;
 
   // pre-compute volume-dependent coeffs for portion of grid I now own
 
@@ -638,13 +787,18 @@ void PPPS::compute(int eflag, int vflag)
 
   if (qsqsum == 0.0) return;
 
-  // convert atoms from box to lamda coords
+  // time the phases with the normal Timer level
+  // the setup force computation is not part of the timed loop,
+  //   it restarts the phase times as Timer::init() does for the run
 
-  if (triclinic == 0) boxlo = domain->boxlo;
-  else {
-    boxlo = domain->boxlo_lamda;
-    domain->x2lamda(atom->nlocal);
+  phase_flag = timer->has_normal();
+  if (update->ntimestep == update->firststep) {
+    for (i = 0; i < NPHASE; i++) phase_time[i] = 0.0;
+    phase_flag = 0;
   }
+  if (phase_flag) phase_last = platform::walltime();
+
+  boxlo = domain->boxlo;
 
   // extend size of per-atom arrays if necessary
 
@@ -657,18 +811,20 @@ void PPPS::compute(int eflag, int vflag)
   // find grid points for all my particles
   // map my particle charge onto my local 3d density grid
 
-  
   particle_map();
+  phase_stamp(PHASE_MAP);
   make_rho();
-  
-  
+  phase_stamp(PHASE_RHO);
+
   // all procs communicate density values from their ghost cells
   //   to fully sum contribution in their 3d bricks
   // remap from 3d decomposition to FFT decomposition
 
   gc->reverse_comm(Grid3d::KSPACE,this,REVERSE_RHO,1,sizeof(FFT_SCALAR),
                    gc_buf1,gc_buf2,MPI_FFT_SCALAR);
+  phase_stamp(PHASE_REVCOMM);
   brick2fft();
+  phase_stamp(PHASE_REMAP);
 
   // compute potential gradient on my FFT grid and
   //   portion of e_long on this proc's FFT grid
@@ -676,6 +832,7 @@ void PPPS::compute(int eflag, int vflag)
   // also performs per-atom calculations via poisson_peratom()
 
   poisson();
+  phase_stamp(PHASE_IFFT);
 
   // all procs communicate E-field values
   // to fill ghost cells surrounding their 3d bricks
@@ -697,6 +854,7 @@ void PPPS::compute(int eflag, int vflag)
       gc->forward_comm(Grid3d::KSPACE,this,FORWARD_IK_PERATOM,7,sizeof(FFT_SCALAR),
                        gc_buf1,gc_buf2,MPI_FFT_SCALAR);
   }
+  phase_stamp(PHASE_FWDCOMM);
 
   // calculate the force on my particles
 
@@ -705,6 +863,7 @@ void PPPS::compute(int eflag, int vflag)
   // extra per-atom energy/virial communication
 
   if (evflag_atom) fieldforce_peratom();
+  phase_stamp(PHASE_FIELD);
 
   // sum global energy across procs and add in volume-dependent term
 
@@ -716,7 +875,7 @@ void PPPS::compute(int eflag, int vflag)
     energy = energy_all;
 
     energy *= 0.5*volume;
-    energy -= (-energy_poly_coeff[1]/cutoff) * qsqsum / 2.0; //(Fourier_poly_coeff[0]/(cutoff*Lambda_0))*qsqsum/2.0;
+    energy -= (self_coeff/cutoff) * qsqsum / 2.0;
       // + MY_PI2*qsum*qsum / (g_ewald*g_ewald*volume); // No non-neutral correction
     energy *= qscale;
   } 
@@ -742,8 +901,7 @@ void PPPS::compute(int eflag, int vflag)
     if (eflag_atom) {
       for (i = 0; i < nlocal; i++) {
         eatom[i] *= 0.5;
-        eatom[i] -= g_ewald*q[i]*q[i]/MY_PIS + MY_PI2*q[i]*qsum /
-          (g_ewald*g_ewald*volume);
+        eatom[i] -= (self_coeff/cutoff) * q[i]*q[i] / 2.0;
         eatom[i] *= qscale;
       }
       for (i = nlocal; i < ntotal; i++) eatom[i] *= 0.5*qscale;
@@ -758,10 +916,6 @@ void PPPS::compute(int eflag, int vflag)
   // 2d slab correction
 
   if (slabflag == 1) slabcorr();
-
-  // convert atoms back from lamda to box coords
-
-  if (triclinic) domain->lamda2x(atom->nlocal);
 }
 
 /* ----------------------------------------------------------------------
@@ -796,7 +950,8 @@ void PPPS::allocate()
   // nfft_brick = FFT points in 3d brick-decomposition on this proc
   //              same as count of owned grid cells
   // nfft = FFT points in x-pencil FFT decomposition on this proc
-  // nfft_both = greater of nfft and nfft_brick
+  //        only half the x range for real-to-complex FFTs, see nfft_real
+  // nfft_both = greater of nfft, nfft_real and nfft_brick
 
   ngrid = (nxhi_out-nxlo_out+1) * (nyhi_out-nylo_out+1) *
     (nzhi_out-nzlo_out+1);
@@ -808,6 +963,7 @@ void PPPS::allocate()
     (nzhi_fft-nzlo_fft+1);
 
   nfft_both = MAX(nfft,nfft_brick);
+  nfft_both = MAX(nfft_both,nfft_real);
 
   // allocate distributed grid data
 
@@ -819,19 +975,25 @@ void PPPS::allocate()
   memory->create(greensfn2,nfft_both,"pppm:greensfn2");
   memory->create(work1,2*nfft_both,"pppm:work1");
   memory->create(work2,2*nfft_both,"pppm:work2");
-  memory->create(vg,nfft_both,6,"pppm:vg");
-  memory->create(vg2,nfft_both,6,"pppm:vg2");
 
-  if (triclinic == 0) {
-    memory->create1d_offset(fkx,nxlo_fft,nxhi_fft,"pppm:fkx");
-    memory->create1d_offset(fky,nylo_fft,nyhi_fft,"pppm:fky");
-    memory->create1d_offset(fkz,nzlo_fft,nzhi_fft,"pppm:fkz");
-  } else {
-    memory->create(fkx,nfft_both,"pppm:fkx");
-    memory->create(fky,nfft_both,"pppm:fky");
-    memory->create(fkz,nfft_both,"pppm:fkz");
+  // vg2 is the second virial term from the k dependence of the splitting kernel
+
+  if (vg_store_flag) {
+    memory->create(vg,nfft_both,6,"pppm:vg");
+    memory->create(vg2,nfft_both,6,"pppm:vg2");
   }
 
+  // each x frequency of the half spectrum except 0 and nx_pppm/2
+  //   also stands for its negative in sums over the FFT grid
+
+  memory->create1d_offset(kx_weight,nxlo_fft,nxhi_fft,"pppm:kx_weight");
+  for (int i = nxlo_fft; i <= nxhi_fft; i++)
+    kx_weight[i] = (r2c_flag && i > 0 && 2*i != nx_pppm) ? 2.0 : 1.0;
+
+  memory->create1d_offset(fkx,nxlo_fft,nxhi_fft,"pppm:fkx");
+  memory->create1d_offset(fky,nylo_fft,nyhi_fft,"pppm:fky");
+  memory->create1d_offset(fkz,nzlo_fft,nzhi_fft,"pppm:fkz");
+
   if (differentiation_flag == 1) {
     memory->create3d_offset(u_brick,nzlo_out,nzhi_out,nylo_out,nyhi_out,
                           nxlo_out,nxhi_out,"pppm:u_brick");
@@ -855,33 +1017,48 @@ void PPPS::allocate()
   // summation coeffs
 
   order_allocated = order;
-  if (!stagger_flag) memory->create(gf_b,order,"pppm:gf_b");
+  memory->create(gf_b,order,"pppm:gf_b");
   memory->create2d_offset(rho1d,3,-order/2,order/2,"pppm:rho1d");
   memory->create2d_offset(drho1d,3,-order/2,order/2,"pppm:drho1d");
-  //// memory->create2d_offset(rho_coeff,order,(1-order)/2,order/2,"pppm:rho_coeff");
-  //// memory->create2d_offset(drho_coeff,order,(1-order)/2,order/2,"pppm:drho_coeff");
-  
+  memory->create2d_offset(rho_coeff,poly_order*rho_pieces,(1-order)/2,order/2,"pppm:rho_coeff");
+  memory->create2d_offset(drho_coeff,poly_order*rho_pieces,(1-order)/2,order/2,"pppm:drho_coeff");
+
+  // tiles cover all central grid points whose stencil fits in my brick
+  // a tile's stencils span sort_block+order-1 grid points along each axis
+
+  if (sort_block) {
+    sort_nx = (nxhi_out-nxlo_out-order+1 + sort_block) / sort_block;
+    sort_ny = (nyhi_out-nylo_out-order+1 + sort_block) / sort_block;
+    sort_nz = (nzhi_out-nzlo_out-order+1 + sort_block) / sort_block;
+    const int nspan = sort_block + order - 1;
+    memory->create(tile_start,sort_nx*sort_ny*sort_nz+1,"pppm:tile_start");
+    memory->create(tile_density,nspan*nspan*nspan,"pppm:tile_density");
+  }
 
   // create 2 FFTs and a Remap
   // 1st FFT keeps data in FFT decomposition
   // 2nd FFT returns data in 3d brick decomposition
   // remap takes data from 3d brick to FFT decomposition
+  // with r2c_flag, 1st FFT is real-to-complex, 2nd FFT complex-to-real,
+  //   and the real density covers the full x range 0 to nx_pppm-1
 
   int tmp;
+  const int nxhi_real = nx_pppm - 1;
 
   fft1 = new FFT3d(lmp,world,nx_pppm,ny_pppm,nz_pppm,
+                   nxlo_fft,nxhi_real,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
                    nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
-                   nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
-                   0,0,&tmp,collective_flag);
+                   0,0,&tmp,collective_flag,r2c_flag ? FFT3d::FORWARD : 0);
 
   fft2 = new FFT3d(lmp,world,nx_pppm,ny_pppm,nz_pppm,
                    nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
                    nxlo_in,nxhi_in,nylo_in,nyhi_in,nzlo_in,nzhi_in,
-                   0,0,&tmp,collective_flag);
+                   0,0,&tmp,collective_flag,r2c_flag ? FFT3d::BACKWARD : 0);
+  fft2_stride = r2c_flag ? 1 : 2;
 
   remap = new Remap(lmp,world,
                     nxlo_in,nxhi_in,nylo_in,nyhi_in,nzlo_in,nzhi_in,
-                    nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
+                    nxlo_fft,nxhi_real,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
                     1,0,0,FFT_PRECISION,collective_flag);
 }
 
@@ -918,23 +1095,28 @@ void PPPS::deallocate()
   memory->destroy(work2);
   memory->destroy(vg);
   memory->destroy(vg2);
+  memory->destroy1d_offset(kx_weight,nxlo_fft);
 
-  if (triclinic == 0) {
-    memory->destroy1d_offset(fkx,nxlo_fft);
-    memory->destroy1d_offset(fky,nylo_fft);
-    memory->destroy1d_offset(fkz,nzlo_fft);
-  } else {
-    memory->destroy(fkx);
-    memory->destroy(fky);
-    memory->destroy(fkz);
-  }
+  memory->destroy1d_offset(fkx,nxlo_fft);
+  memory->destroy1d_offset(fky,nylo_fft);
+  memory->destroy1d_offset(fkz,nzlo_fft);
 
   memory->destroy(gf_b);
-  if (stagger_flag) gf_b = nullptr;
+  for (int d = 0; d < 3; d++) {
+    memory->destroy(gf_denom1d[d]);
+    memory->destroy(gf_w1d[d]);
+    memory->destroy(gf_alt1d[d]);
+  }
   memory->destroy2d_offset(rho1d,-order_allocated/2);
   memory->destroy2d_offset(drho1d,-order_allocated/2);
-  //// memory->destroy2d_offset(rho_coeff,(1-order_allocated)/2);
-  //// memory->destroy2d_offset(drho_coeff,(1-order_allocated)/2);
+  memory->destroy2d_offset(rho_coeff,(1-order_allocated)/2);
+  memory->destroy2d_offset(drho_coeff,(1-order_allocated)/2);
+  memory->destroy(rho_lookup);
+  memory->destroy(drho_lookup);
+  memory->destroy(tile_start);
+  memory->destroy(tile_density);
+  memory->destroy(rho_cache);
+  nrho_cache = nrho_cache_alloc = 0;
 
   delete fft1;
   delete fft2;
@@ -1005,7 +1187,7 @@ void PPPS::deallocate_peratom()
 
 void PPPS::set_grid_global()
 {
-  // use xprd,yprd,zprd (even if triclinic, and then scale later)
+  // use xprd,yprd,zprd
   // adjust z dimension for 2d slab PPPM
   // 3d PPPM just uses zprd since slab_volfactor = 1.0
 
@@ -1014,91 +1196,200 @@ void PPPS::set_grid_global()
   double zprd = domain->zprd;
   double zprd_slab = zprd*slab_volfactor;
 
-  // make initial g_ewald estimate
-  // based on desired accuracy and real space cutoff
-  // fluid-occupied volume used to estimate real-space error
-  // zprd used rather than zprd_slab
-
-  double h;
-  bigint natoms = atom->natoms;
-
   // set optimal nx_pppm,ny_pppm,nz_pppm based on order and accuracy
-  // nz_pppm uses extended zprd_slab instead of zprd
-  // reduce it until accuracy target is met
 
   if (!gridflag) {
+    if (!compute_grid())
+      error->all(FLERR,"Could not compute grid size for PPPS order {}, "
+                 "increase order or spreading accuracy",order);
+  }
+
+  // boost grid size until it is factorable
+
+  while (!factorable(nx_pppm)) nx_pppm++;
+  while (!factorable(ny_pppm)) ny_pppm++;
+  while (!factorable(nz_pppm)) nz_pppm++;
 
-    if (differentiation_flag == 1 || stagger_flag) {
+  h_x = xprd/nx_pppm;
+  h_y = yprd/ny_pppm;
+  h_z = zprd_slab/nz_pppm;
 
-      ////// h = h_x = h_y = h_z = 4.0/g_ewald;
-      h = h_x = h_y = h_z = MY_PI * cutoff / select_c;
+  if (nx_pppm >= OFFSET || ny_pppm >= OFFSET || nz_pppm >= OFFSET)
+    error->all(FLERR,"PPPM grid is too large");
+}
 
-      int count = 0;
-      while (true) {
+/* ----------------------------------------------------------------------
+   find the coarsest factorable grid whose estimated kspace force error
+     meets the accuracy for the current order
+   start from h = pi*cutoff/c, where the Nyquist frequency equals the
+     cutoff of the Fourier splitting kernel, then coarsen the grid while
+     the error stays below accuracy or refine it until it does
+   the spreading window scales with h, so refining far below the start
+     only reduces the aliasing of the splitting kernel, not of the window
+   return 0 if the accuracy cannot be reached with this order
+------------------------------------------------------------------------- */
 
-        // set grid dimensions
+int PPPS::compute_grid()
+{
+  // nz_pppm uses extended zprd_slab instead of zprd
+  // the spreading window coefficients are needed by compute_qopt()
 
-        nx_pppm = static_cast<int> (xprd/h_x);
-        ny_pppm = static_cast<int> (yprd/h_y);
-        nz_pppm = static_cast<int> (zprd_slab/h_z);
+  double xprd = domain->xprd;
+  double yprd = domain->yprd;
+  double zprd = domain->zprd;
+  double zprd_slab = zprd*slab_volfactor;
 
-        if (nx_pppm <= 1) nx_pppm = 2;
-        if (ny_pppm <= 1) ny_pppm = 2;
-        if (nz_pppm <= 1) nz_pppm = 2;
+  compute_spread_coeff();
 
-        // estimate Kspace force error
-      }
+  const double h0 = MY_PI * cutoff / select_c;
+  double h = h0;
+  int nx_ok = 0, ny_ok = 0, nz_ok = 0;
+  int nx_last = 0, ny_last = 0, nz_last = 0;
+  int coarsen = -1;
 
-    } else {
+  while (true) {
+
+    // set grid dimensions, with at least 2 grid points per dimension
+
+    nx_pppm = MAX(static_cast<int> (xprd/h) + 1,2);
+    ny_pppm = MAX(static_cast<int> (yprd/h) + 1,2);
+    nz_pppm = MAX(static_cast<int> (zprd_slab/h) + 1,2);
 
-      double err;
-      ////// h_x = h_y = h_z = 1.0/g_ewald;
-      h = h_x = h_y = h_z = MY_PI * cutoff / select_c;
+    while (!factorable(nx_pppm)) nx_pppm++;
+    while (!factorable(ny_pppm)) ny_pppm++;
+    while (!factorable(nz_pppm)) nz_pppm++;
 
-      nx_pppm = static_cast<int> (xprd/h_x) + 1;
-      ny_pppm = static_cast<int> (yprd/h_y) + 1;
-      nz_pppm = static_cast<int> (zprd_slab/h_z) + 1;
-      
-      err = accuracy;
+    if (nx_pppm != nx_last || ny_pppm != ny_last || nz_pppm != nz_last) {
+      nx_last = nx_pppm;
+      ny_last = ny_pppm;
+      nz_last = nz_pppm;
+
+      // estimate Kspace force error
+
+      const int ok = (compute_df_kspace() <= accuracy);
+      if (coarsen < 0) coarsen = ok;
+      if (ok) {
+        nx_ok = nx_pppm;
+        ny_ok = ny_pppm;
+        nz_ok = nz_pppm;
+        if (!coarsen) break;
+      } else if (coarsen) break;
     }
 
-    // scale grid for triclinic skew
-
-    if (triclinic) {
-      double tmp[3];
-      tmp[0] = nx_pppm/xprd;
-      tmp[1] = ny_pppm/yprd;
-      tmp[2] = nz_pppm/zprd;
-      lamda2xT(&tmp[0],&tmp[0]);
-      nx_pppm = static_cast<int>(tmp[0]) + 1;
-      ny_pppm = static_cast<int>(tmp[1]) + 1;
-      nz_pppm = static_cast<int>(tmp[2]) + 1;
+    // stop coarsening at 2 grid points per dimension, stop refining at h0/GRID_REFINE_MAX
+
+    if (coarsen) {
+      if (nx_pppm == 2 && ny_pppm == 2 && nz_pppm == 2) break;
+      h /= 0.95;
+    } else {
+      h *= 0.95;
+      if (h < h0/GRID_REFINE_MAX) return 0;
     }
   }
 
-  // boost grid size until it is factorable
+  nx_pppm = nx_ok;
+  ny_pppm = ny_ok;
+  nz_pppm = nz_ok;
+  return 1;
+}
 
-  while (!factorable(nx_pppm)) nx_pppm++;
-  while (!factorable(ny_pppm)) ny_pppm++;
-  while (!factorable(nz_pppm)) nz_pppm++;
+/* ----------------------------------------------------------------------
+   select the stencil order with the lowest estimated cost per step
+   with the mesh chosen by set_grid_global() for each order
+   with a fixed mesh the cost grows with the order, so this is the lowest
+     order that meets the accuracy, else the order with the smallest error
+------------------------------------------------------------------------- */
 
-  if (triclinic == 0) {
-    h_x = xprd/nx_pppm;
-    h_y = yprd/ny_pppm;
-    h_z = zprd_slab/nz_pppm;
-  } else {
-    double tmp[3];
-    tmp[0] = nx_pppm;
-    tmp[1] = ny_pppm;
-    tmp[2] = nz_pppm;
-    x2lamdaT(&tmp[0],&tmp[0]);
-    h_x = 1.0/tmp[0];
-    h_y = 1.0/tmp[1];
-    h_z = 1.0/tmp[2];
+void PPPS::select_order()
+{
+  const int order_min = MAX(minorder,ORDER_AUTO_MIN);
+  int order_best = 0;
+  double cost_best = 0.0;
+  double df_best = 0.0;
+  int ok_best = 0;
+
+  for (order = order_min; order <= order_auto_max; order++) {
+    if (!spread_fit_supported(spreading_accuracy,order)) continue;
+    double df = accuracy;
+    if (gridflag) {
+      set_grid_global();
+      compute_spread_coeff();
+      df = compute_df_kspace();
+    } else if (!compute_grid()) continue;
+    const int ok = (df <= accuracy);
+    const double cost = estimated_cost();
+
+    if (!order_best || (ok && !ok_best) || (ok && cost < cost_best) ||
+        (!ok && !ok_best && df < df_best)) {
+      order_best = order;
+      cost_best = cost;
+      df_best = df;
+      ok_best = ok;
+    }
   }
 
-  if (nx_pppm >= OFFSET || ny_pppm >= OFFSET || nz_pppm >= OFFSET)
-    error->all(FLERR,"PPPM grid is too large");
+  if (!order_best)
+    error->all(FLERR,"Could not compute grid size for PPPS orders {} to {}, "
+               "increase spreading accuracy",order_min,order_auto_max);
+  order = order_best;
+}
+
+/* ----------------------------------------------------------------------
+   coarsest grid meeting the accuracy for a Coulomb cutoff, stencil order
+     and spreading accuracy, used by fix tune/ppps
+   the current settings and spreading coefficients are restored
+   return 0 if the spreading fit or the accuracy cannot be reached
+------------------------------------------------------------------------- */
+
+int PPPS::tune_mesh(double cut, int ord, double spread, int *mesh)
+{
+  if (ord < minorder || ord > MAXORDER) return 0;
+
+  // the spreading fit must meet spread and have an unrolled stencil kernel
+
+  const PSWFSpreadingCoeffs &fit =
+    spreading_coeffs(spread,ord,POLY_FIT_RATIO*spread,PSWFPoly::MAXPOLY,rho_pieces);
+  if (fit.err > spread || !spread_fit_supported(spread,ord)) return 0;
+
+  const double cutoff_old = cutoff;
+  const double spreading_old = spreading_accuracy;
+  const int order_old = order;
+  const int nx_old = nx_pppm, ny_old = ny_pppm, nz_old = nz_pppm;
+
+  cutoff = cut;
+  order = ord;
+  spreading_accuracy = spread;
+
+  const int flag = compute_grid();
+  mesh[0] = nx_pppm;
+  mesh[1] = ny_pppm;
+  mesh[2] = nz_pppm;
+
+  cutoff = cutoff_old;
+  order = order_old;
+  spreading_accuracy = spreading_old;
+  nx_pppm = nx_old;
+  ny_pppm = ny_old;
+  nz_pppm = nz_old;
+  compute_spread_coeff();
+
+  return flag;
+}
+
+/* ----------------------------------------------------------------------
+   rough operation count of one step for the current order and mesh
+   spreading and interpolation visit order^3 grid points per atom,
+   each FFT costs about 2.5 N log2(N) for N grid points
+------------------------------------------------------------------------- */
+
+double PPPS::estimated_cost()
+{
+  const double ngrid = (double) nx_pppm * ny_pppm * nz_pppm;
+  const double natoms = MAX(atom->natoms,1);
+  const double nfft = (differentiation_flag == 1) ? 2.0 : 4.0;
+  const double fftcost = r2c_flag ? 1.25 : 2.5;
+  const double ngrids = stagger_flag ? 2.0 : 1.0;
+  return ngrids*(2.0*natoms*order*order*order + nfft*fftcost*ngrid*log2(ngrid));
 }
 
 /* ----------------------------------------------------------------------
@@ -1124,15 +1415,58 @@ int PPPS::factorable(int n)
 }
 
 /* ----------------------------------------------------------------------
-   compute qopt
+   calculate the final estimate of the accuracy
+------------------------------------------------------------------------- */
+
+double PPPS::final_accuracy()
+{
+  double xprd = domain->xprd;
+  double yprd = domain->yprd;
+  double zprd = domain->zprd;
+  bigint natoms = atom->natoms;
+  if (natoms == 0) natoms = 1; // avoid division by zero
+
+  // real space error as in Kolafa and Perram, with the PSWF force kernel
+  //   at the cutoff in place of the Gaussian factor
+
+  double df_kspace = compute_df_kspace();
+  double q2_over_sqrt = q2 / sqrt(natoms*cutoff*xprd*yprd*zprd);
+  double fcut = fabs(PSWFPoly::piecewise(force_poly_coeff,num_of_force_poly,
+                                         num_of_poly_pieces,1.0));
+  double df_rspace = 2.0 * q2_over_sqrt * fcut;
+  double df_table = estimate_table_accuracy(q2_over_sqrt,df_rspace);
+
+  return sqrt(df_kspace*df_kspace + df_rspace*df_rspace + df_table*df_table);
+}
+
+/* ----------------------------------------------------------------------
+   compute estimated kspace force error
+------------------------------------------------------------------------- */
+
+double PPPS::compute_df_kspace()
+{
+  double xprd = domain->xprd;
+  double yprd = domain->yprd;
+  double zprd = domain->zprd;
+  double zprd_slab = zprd*slab_volfactor;
+  bigint natoms = atom->natoms;
+  if (natoms == 0) natoms = 1;
+  double qopt = compute_qopt();
+  double df_kspace = sqrt(qopt/natoms)*q2/(xprd*yprd*zprd_slab);
+  return df_kspace;
+}
+
+/* ----------------------------------------------------------------------
+   compute qopt, the optimal Hockney-Eastwood error functional for the
+   PSWF splitting and spreading kernels, summed over a sample of
+   at most QOPT_SAMPLES grid points
 ------------------------------------------------------------------------- */
 
 double PPPS::compute_qopt()
 {
   int k,l,m,nx,ny,nz;
-  double argx,argy,argz,wx,wy,wz,sx,sy,sz,qx,qy,qz;
-  double u1,u2,sqk;
-  double sum1,sum2,sum3,sum4,dot2;
+  double qx,qy,qz,wx,wy,wz,wxy,u2,sqk,dot2,arg,phik,kq,sign;
+  double sum1,sum2,sum3,sum4,sum5,sum6,denominator;
 
   double *prd = domain->prd;
 
@@ -1146,17 +1480,31 @@ double PPPS::compute_qopt()
   const double unitky = (MY_2PI/yprd);
   const double unitkz = (MY_2PI/zprd_slab);
 
-  const int twoorder = 2*order;
+  // the spreading window vanishes beyond |k| = 2c/(order*h),
+  //   the splitting kernel beyond |k| = c/cutoff
+  // only aliases inside either bound contribute
 
-  // loop over entire FFT grid
-  // each proc calculates contributions from every Pth grid point
+  const double kcut = select_c/cutoff;
+  const double scalex = 0.5*order*xprd/nx_pppm/spreading_select_c;
+  const double scaley = 0.5*order*yprd/ny_pppm/spreading_select_c;
+  const double scalez = 0.5*order*zprd_slab/nz_pppm/spreading_select_c;
+  const int nbx = static_cast<int> (MAX(kcut,1.0/scalex)/(unitkx*nx_pppm) + 0.5) + 1;
+  const int nby = static_cast<int> (MAX(kcut,1.0/scaley)/(unitky*ny_pppm) + 0.5) + 1;
+  const int nbz = static_cast<int> (MAX(kcut,1.0/scalez)/(unitkz*nz_pppm) + 0.5) + 1;
+
+  // sample every stride-th grid point, with a stride coprime to the
+  //   grid factors so that all wave vector components are visited
+  // each proc calculates contributions from every Pth sample
 
   bigint ngridtotal = (bigint) nx_pppm * ny_pppm * nz_pppm;
   bigint nxy_pppm = (bigint) nx_pppm * ny_pppm;
 
+  bigint stride = MAX(ngridtotal/QOPT_SAMPLES,1);
+  while (stride % 2 == 0 || stride % 3 == 0 || stride % 5 == 0) stride++;
+
   double qopt = 0.0;
 
-  for (bigint i = me; i < ngridtotal; i += nprocs) {
+  for (bigint i = me*stride; i < ngridtotal; i += nprocs*stride) {
     k = i % nx_pppm;
     l = (i/nx_pppm) % ny_pppm;
     m = i / nxy_pppm;
@@ -1168,50 +1516,79 @@ double PPPS::compute_qopt()
     sqk = square(unitkx*kper) + square(unitky*lper) + square(unitkz*mper);
     if (sqk == 0.0) continue;
 
-    sum1 = sum2 = sum3 = sum4 = 0.0;
+    sum1 = sum2 = sum3 = sum4 = sum5 = sum6 = 0.0;
 
-    for (nx = -2; nx <= 2; nx++) {
+    for (nx = -nbx; nx <= nbx; nx++) {
       qx = unitkx*(kper+nx_pppm*nx);
-      sx = exp(-0.25*square(qx/g_ewald));
-      argx = 0.5*qx*xprd/nx_pppm;
-      wx = powsinxx(argx,twoorder);
-      qx *= qx;
+      wx = gf_window(scalex*fabs(qx));
+      if (wx == 0.0 && fabs(qx) > kcut) continue;
 
-      for (ny = -2; ny <= 2; ny++) {
+      for (ny = -nby; ny <= nby; ny++) {
         qy = unitky*(lper+ny_pppm*ny);
-        sy = exp(-0.25*square(qy/g_ewald));
-        argy = 0.5*qy*yprd/ny_pppm;
-        wy = powsinxx(argy,twoorder);
-        qy *= qy;
+        wy = gf_window(scaley*fabs(qy));
+        if (wy == 0.0 && fabs(qy) > kcut) continue;
+        wxy = wx*wy;
 
-        for (nz = -2; nz <= 2; nz++) {
+        for (nz = -nbz; nz <= nbz; nz++) {
           qz = unitkz*(mper+nz_pppm*nz);
-          sz = exp(-0.25*square(qz/g_ewald));
-          argz = 0.5*qz*zprd_slab/nz_pppm;
-          wz = powsinxx(argz,twoorder);
-          qz *= qz;
+          wz = gf_window(scalez*fabs(qz));
+          if (wz == 0.0 && fabs(qz) > kcut) continue;
+
+          dot2 = qx*qx+qy*qy+qz*qz;
+          u2 = wxy*wz;
 
-          dot2 = qx+qy+qz;
-          u1   = sx*sy*sz;
-          u2   = wx*wy*wz;
+          // 4 pi/k^2 times the PSWF splitting kernel
 
-          sum1 += u1*u1/dot2*MY_4PI*MY_4PI;
-          sum2 += u1 * u2 * MY_4PI;
+          arg = sqrt(dot2)*cutoff/select_c;
+          phik = 0.0;
+          if (arg <= 1.0)
+            phik = MY_2PI*PSWFPoly::poly(Fourier_poly_coeff,num_of_Fourier_poly,arg)/dot2;
+
+          sum1 += phik*phik*dot2;
           sum3 += u2;
-          sum4 += dot2*u2;
+          if (stagger_flag) {
+            sign = ((nx+ny+nz) % 2) ? -1.0 : 1.0;
+            sum5 += sign*u2;
+            sum6 += sign*u2*dot2;
+          }
+          if (differentiation_flag == 1) {
+            sum2 += u2*phik*dot2;
+            sum4 += u2*dot2;
+          } else {
+            kq = unitkx*kper*qx + unitky*lper*qy + unitkz*mper*qz;
+            sum2 += u2*phik*kq;
+          }
         }
       }
     }
 
+    // without any window weight the whole reference force is lost
+
+    if (sum3 == 0.0) {
+      qopt += sum1;
+      continue;
+    }
+
+    // staggered grids average the denominator of the two grids,
+    //   whose odd aliases have opposite phase
+    // the difference is non-negative up to round-off
+
+    if (differentiation_flag == 1) denominator = sum3*sum4;
+    else denominator = sqk*sum3*sum3;
+    if (stagger_flag) {
+      if (differentiation_flag == 1) denominator = 0.5*(denominator + sum5*sum6);
+      else denominator = 0.5*(denominator + sqk*sum5*sum5);
+    }
+
     sum2 *= sum2;
-    qopt += sum1 - sum2/(sum3*sum4);
+    qopt += MAX(sum1 - sum2/denominator,0.0);
   }
 
-  // sum qopt over all procs
+  // sum qopt over all procs and scale by the sampling stride
 
   double qopt_all;
   MPI_Allreduce(&qopt,&qopt_all,1,MPI_DOUBLE,MPI_SUM,world);
-  return qopt_all;
+  return qopt_all*stride;
 }
 
 /* ----------------------------------------------------------------------
@@ -1237,8 +1614,6 @@ void PPPS::set_grid_local()
 
   nlower = -(order-1)/2;
   nupper = order/2;
-  
-  std::cout<<"Here is the stencil "<<nlower<<"   "<<nupper<<"   "<<shift<<"    "<<shiftone<<std::endl;
 
   // shiftatom lo/hi are passed to Grid3d to determine ghost cell extents
   // shiftatom_lo = min shift on lo side
@@ -1289,6 +1664,13 @@ void PPPS::set_grid_local()
   nyhi_fft = (me_y+1)*ny_pppm/npey_fft - 1;
   nzlo_fft = me_z*nz_pppm/npez_fft;
   nzhi_fft = (me_z+1)*nz_pppm/npez_fft - 1;
+
+  // with real-to-complex FFTs, the density is real on the full x range
+  //   but k-space only holds x frequencies 0 to nx_pppm/2,
+  //   the negative ones are the complex conjugates
+
+  nfft_real = nx_pppm * (nyhi_fft-nylo_fft+1) * (nzhi_fft-nzlo_fft+1);
+  if (r2c_flag) nxhi_fft = nx_pppm/2;
 }
 
 /* ----------------------------------------------------------------------
@@ -1314,6 +1696,66 @@ void PPPS::compute_gf_denom()
   for (l = 0; l < order; l++) gf_b[l] *= gaminv;
 }
 
+/* ----------------------------------------------------------------------
+   pre-compute the separable parts of the PSWF Green's function
+   for each axis and each of my FFT grid indices:
+     gf_denom1d = sum of the squared spreading window over the
+       GF_DENOM_ALIAS aliases on either side, the denominator is the
+       square of the product of the three axis values
+     gf_w1d = squared spreading window of each alias -nb..nb that
+       enters the numerator, nb = 0 unless alias_flag is set
+     gf_alt1d = same sum as gf_denom1d with alternating signs of the
+       aliases, for the second of two staggered grids
+------------------------------------------------------------------------- */
+
+void PPPS::compute_gf_1d(int alias_flag)
+{
+  const double * const prd = domain->prd;
+  const double zprd_slab = prd[2]*slab_volfactor;
+  const double len[3] = {prd[0], prd[1], zprd_slab};
+  const int nmesh[3] = {nx_pppm, ny_pppm, nz_pppm};
+  const int nlo[3] = {nxlo_fft, nylo_fft, nzlo_fft};
+  const int nhi[3] = {nxhi_fft, nyhi_fft, nzhi_fft};
+
+  for (int d = 0; d < 3; d++) {
+    gf_nb[d] = 0;
+    if (alias_flag)
+      gf_nb[d] = static_cast<int> (select_c * prd[d] / (MY_2PI * cutoff * nmesh[d])) *
+        pow(-log(EPS_HOC),0.25);
+
+    const int nb = gf_nb[d];
+    const int nlocal = nhi[d] - nlo[d] + 1;
+    const double unitk = MY_2PI/len[d];
+    const double scale = 0.5 * order * len[d] / nmesh[d] / spreading_select_c;
+
+    memory->destroy(gf_denom1d[d]);
+    memory->destroy(gf_w1d[d]);
+    memory->destroy(gf_alt1d[d]);
+    memory->create(gf_denom1d[d],nlocal,"pppm:gf_denom1d");
+    memory->create(gf_w1d[d],nlocal*(2*nb+1),"pppm:gf_w1d");
+    if (stagger_flag) memory->create(gf_alt1d[d],nlocal,"pppm:gf_alt1d");
+
+    for (int i = 0; i < nlocal; i++) {
+      const int per = nlo[d] + i - nmesh[d]*(2*(nlo[d]+i)/nmesh[d]);
+
+      double sum = 0.0;
+      for (int a = -GF_DENOM_ALIAS; a <= GF_DENOM_ALIAS; a++)
+        sum += gf_window(scale * fabs(unitk*(per+nmesh[d]*a)));
+      gf_denom1d[d][i] = sum;
+
+      if (stagger_flag) {
+        sum = 0.0;
+        for (int a = -GF_DENOM_ALIAS; a <= GF_DENOM_ALIAS; a++)
+          sum += ((a % 2) ? -1.0 : 1.0) * gf_window(scale * fabs(unitk*(per+nmesh[d]*a)));
+        gf_alt1d[d][i] = sum;
+      }
+
+      for (int a = -nb; a <= nb; a++)
+        gf_w1d[d][i*(2*nb+1) + a+nb] = gf_window(scale * fabs(unitk*(per+nmesh[d]*a)));
+    }
+  }
+}
+
 /* ----------------------------------------------------------------------
    pre-compute modified (Hockney-Eastwood) Coulomb Green's function
 ------------------------------------------------------------------------- */
@@ -1330,428 +1772,256 @@ void PPPS::compute_gf_ik()
   const double unitky = (MY_2PI/yprd);
   const double unitkz = (MY_2PI/zprd_slab);
 
-  double snx,sny,snz;
-  double argx,argy,argz,wx,wy,wz,qx,qy,qz;
-  double sum1,dot1,dot2;
-  double numerator,denominator;
-  double sqk;
+  double qx,qy,qz,qsq,wx,wy,wz,wxy,arg,appx,appx_virial,r;
+  double sum1,sum2,dot1,denominator,sqk;
+  int i,k,l,m,n,nx,ny,nz,kper,lper,mper;
 
-  int k,l,m,n,nx,ny,nz,kper,lper,mper;
+  compute_gf_1d(1);
 
-  const int nbx = static_cast<int> (select_c * xprd / (MY_2PI * cutoff * nx_pppm)) * pow(-log(EPS_HOC),0.25); // formula
-  
-  //((g_ewald*xprd/(MY_PI*nx_pppm)) * pow(-log(EPS_HOC),0.25));
-  const int nby = static_cast<int> (select_c * yprd / (MY_2PI * cutoff * ny_pppm)) * pow(-log(EPS_HOC),0.25); // formula
+  const int nbx = gf_nb[0];
+  const int nby = gf_nb[1];
+  const int nbz = gf_nb[2];
 
-  const int nbz = static_cast<int> (select_c * zprd / (MY_2PI * cutoff * nz_pppm)) * pow(-log(EPS_HOC),0.25); // formula
-  
-  const int twoorder = 2*order;
- 
   n = 0;
   for (m = nzlo_fft; m <= nzhi_fft; m++) {
     mper = m - nz_pppm*(2*m/nz_pppm);
-
-    //// snz = square(sin(0.5*unitkz*mper*zprd_slab/nz_pppm));
-    snz = unitkz*mper;
+    const double *wz1d = gf_w1d[2] + (m-nzlo_fft)*(2*nbz+1) + nbz;
+    const double dz = gf_denom1d[2][m-nzlo_fft];
+    const double az = stagger_flag ? gf_alt1d[2][m-nzlo_fft] : 0.0;
 
     for (l = nylo_fft; l <= nyhi_fft; l++) {
       lper = l - ny_pppm*(2*l/ny_pppm);
-      
-      //// sny = square(sin(0.5*unitky*lper*yprd/ny_pppm));
-      sny = unitky*lper;
+      const double *wy1d = gf_w1d[1] + (l-nylo_fft)*(2*nby+1) + nby;
+      const double dyz = gf_denom1d[1][l-nylo_fft] * dz;
+      const double ayz = stagger_flag ? gf_alt1d[1][l-nylo_fft] * az : 0.0;
 
       for (k = nxlo_fft; k <= nxhi_fft; k++) {
         kper = k - nx_pppm*(2*k/nx_pppm);
-        
-        //// snx = square(sin(0.5*unitkx*kper*xprd/nx_pppm));
-        snx = unitkx*kper;
+        const double *wx1d = gf_w1d[0] + (k-nxlo_fft)*(2*nbx+1) + nbx;
 
         sqk = square(unitkx*kper) + square(unitky*lper) + square(unitkz*mper);
+        denominator = square(gf_denom1d[0][k-nxlo_fft] * dyz);
+        if (stagger_flag)
+          denominator = 0.5*(denominator + square(gf_alt1d[0][k-nxlo_fft] * ayz));
 
-        if (sqk != 0.0) {
-          //numerator = 12.5663706/sqk;
-          numerator = 1.0/sqk;
-
-          //// denominator = gf_denom(snx,sny,snz);
-          denominator = gf_denom_psw(snx,sny,snz,xprd/nx_pppm,yprd/ny_pppm,zprd_slab/nz_pppm);
-
-          sum1 = 0.0;
-
-          for (nx = -nbx; nx <= nbx; nx++) {
-            qx = unitkx*(kper+nx_pppm*nx); // kx^m = kx+2*pi/hx*mx
-
-            //// argx = 0.5*qx*xprd/nx_pppm; // kx^m * hx / 2
-            //// wx = powsinxx(argx,twoorder); // (sin(kx^m*hx/2)/(kx^m*hx/2))^(2*order)
-
-            double ph_2_kx_c = order * (xprd/nx_pppm) / 2.0 * fabs(qx) / spreading_select_c;
-            wx = 0.00;
-            if(ph_2_kx_c <= 1.00){
-                double Fourier_spreading_appx = Fourier_spreading_coeff[0];
-                double Fourier_spreading_r = 1.0;
-                for(int i=1; i<Fourier_spreading_order; i++){
-                    Fourier_spreading_r *= ph_2_kx_c;
-                    Fourier_spreading_appx += Fourier_spreading_coeff[i] * Fourier_spreading_r;
-                }
-                wx = order / 2.0 * Fourier_spreading_appx;
-                wx = wx * wx;
-            }
+        // the denominator can vanish when the spreading accuracy is low
 
-            for (ny = -nby; ny <= nby; ny++) {
-              qy = unitky*(lper+ny_pppm*ny);
-              
-              //// argy = 0.5*qy*yprd/ny_pppm;
-              //// wy = powsinxx(argy,twoorder);
-
-              double ph_2_ky_c = order * (yprd/ny_pppm) / 2.0 * fabs(qy) / spreading_select_c;
-              wy = 0.00;
-              if(ph_2_ky_c <= 1.00){
-                double Fourier_spreading_appx = Fourier_spreading_coeff[0];
-                double Fourier_spreading_r = 1.0;
-                for(int i=1; i<Fourier_spreading_order; i++){
-                    Fourier_spreading_r *= ph_2_ky_c;
-                    Fourier_spreading_appx += Fourier_spreading_coeff[i] * Fourier_spreading_r;
-                }
-                wy = order / 2.0 * Fourier_spreading_appx;
-                wy = wy * wy;
+        if (sqk == 0.0 || denominator == 0.0) {
+          greensfn[n] = 0.0;
+          greensfn2[n++] = 0.0;
+          continue;
+        }
+
+        // sum over aliases, skipping those outside the spreading window
+        // sum2 is the derivative of the splitting kernel for the virial, as in compute_gf_ad()
+
+        sum1 = sum2 = 0.0;
+        for (nx = -nbx; nx <= nbx; nx++) {
+          wx = wx1d[nx];
+          if (wx == 0.0) continue;
+          qx = unitkx*(kper+nx_pppm*nx);
+
+          for (ny = -nby; ny <= nby; ny++) {
+            wy = wy1d[ny];
+            if (wy == 0.0) continue;
+            qy = unitky*(lper+ny_pppm*ny);
+            wxy = wx*wy;
+
+            for (nz = -nbz; nz <= nbz; nz++) {
+              wz = wz1d[nz];
+              if (wz == 0.0) continue;
+              qz = unitkz*(mper+nz_pppm*nz);
+
+              qsq = qx*qx + qy*qy + qz*qz;
+              arg = sqrt(qsq) * cutoff / select_c;
+              if (arg > 1.0) continue;
+
+              appx = Fourier_poly_coeff[0];
+              appx_virial = 0.0;
+              r = 1.0;
+              for (i = 1; i < num_of_Fourier_poly; i++) {
+                r *= arg;
+                appx += Fourier_poly_coeff[i] * r;
+                appx_virial += Fourier_poly_coeff[i] * i * r;
               }
 
-              for (nz = -nbz; nz <= nbz; nz++) {
-                qz = unitkz*(mper+nz_pppm*nz);
-                
-                //// argz = 0.5*qz*zprd_slab/nz_pppm;
-                //// wz = powsinxx(argz,twoorder);
-
-                double ph_2_kz_c = order * (zprd/nz_pppm) / 2.0 * fabs(qz) / spreading_select_c;
-                wz = 0.00;
-                if(ph_2_kz_c <= 1.00){
-                  double Fourier_spreading_appx = Fourier_spreading_coeff[0];
-                  double Fourier_spreading_r = 1.0;
-                  for(int i=1; i<Fourier_spreading_order; i++){
-                    Fourier_spreading_r *= ph_2_kz_c;
-                    Fourier_spreading_appx += Fourier_spreading_coeff[i] * Fourier_spreading_r;
-                  }
-                  wz = order / 2.0 * Fourier_spreading_appx;
-                  wz = wz * wz;
-                }
-
-                dot1 = unitkx*kper*qx + unitky*lper*qy + unitkz*mper*qz;
-                
-                //printf("cutoff = %f, select_c = %f\n", cutoff, select_c);
-                double k_rc_c = sqrt(qx*qx+qy*qy+qz*qz) * cutoff / select_c;
-                dot2 = 0.00;
-                if(k_rc_c <= 1.00){
-                  double Fourier_poly_appx = Fourier_poly_coeff[0];
-                  double Fourier_poly_r = 1.0;
-                  for(int i=1; i<num_of_Fourier_poly; i++){
-                    Fourier_poly_r *= k_rc_c;
-                    Fourier_poly_appx += Fourier_poly_coeff[i] * Fourier_poly_r;
-                  }
-                  dot2 = 2 * 3.14159265 * Fourier_poly_appx / (qx*qx+qy*qy+qz*qz);
-                }
-                else
-                  dot2 = 0.0;
-                //printf("k_rc_c = %f, dot2 = %f\n", k_rc_c, dot2);
-                
-                sum1 += dot1 * dot2 * wx * wy * wz;
-                //////sum1 += dot1 * dot2 / (wx * wy * wz);// * (xprd/nx_pppm) * (xprd/nx_pppm) * (yprd/ny_pppm) * (yprd/ny_pppm) * (zprd/nz_pppm) * (zprd/nz_pppm));
-                
-                //printf("nominator == %f, denominator == %f\n", wx*wy*wz, denominator);
-              } 
+              dot1 = unitkx*kper*qx + unitky*lper*qy + unitkz*mper*qz;
+              sum1 += dot1 * MY_2PI * appx / qsq * wxy*wz;
+              sum2 += dot1 * MY_2PI * appx_virial / qsq * wxy*wz;
             }
           }
-          if(denominator==0.00){
-             greensfn[n++] = 0.00;
-          }
-          else{
-             greensfn[n++] = numerator*sum1/denominator;
-          } 
-          //greensfn[n++] = numerator*sum1/denominator;
-          //////greensfn[n++] = numerator*sum1;
-        } else greensfn[n++] = 0.0;
+        }
+        greensfn[n] = sum1/(sqk*denominator);
+        greensfn2[n++] = sum2/(sqk*sqk*denominator);
       }
     }
   }
-
-  if(me==0)
-    printf("nbx = %d, nby = %d, nbz = %d\n", nbx, nby, nbz);
-  
 }
 
 /* ----------------------------------------------------------------------
-   pre-compute modified (Hockney-Eastwood) Coulomb Green's function
-   for a triclinic system
+   compute optimized Green's function for energy calculation
 ------------------------------------------------------------------------- */
 
-void PPPS::compute_gf_ik_triclinic()
+void PPPS::compute_gf_ad()
 {
-  double snx,sny,snz;
-  double argx,argy,argz,wx,wy,wz,sx,sy,sz,qx,qy,qz;
-  double sum1,dot1,dot2;
-  double numerator,denominator;
-  double sqk;
+  const double * const prd = domain->prd;
 
-  int k,l,m,n,nx,ny,nz,kper,lper,mper;
+  const double xprd = prd[0];
+  const double yprd = prd[1];
+  const double zprd = prd[2];
+  const double zprd_slab = zprd*slab_volfactor;
+  const double unitkx = (MY_2PI/xprd);
+  const double unitky = (MY_2PI/yprd);
+  const double unitkz = (MY_2PI/zprd_slab);
 
-  double tmp[3];
-  tmp[0] = (g_ewald/(MY_PI*nx_pppm)) * pow(-log(EPS_HOC),0.25);
-  tmp[1] = (g_ewald/(MY_PI*ny_pppm)) * pow(-log(EPS_HOC),0.25);
-  tmp[2] = (g_ewald/(MY_PI*nz_pppm)) * pow(-log(EPS_HOC),0.25);
-  lamda2xT(&tmp[0],&tmp[0]);
-  const int nbx = static_cast<int> (tmp[0]);
-  const int nby = static_cast<int> (tmp[1]);
-  const int nbz = static_cast<int> (tmp[2]);
+  double qx,qy,qz,sqk,wyz,arg,appx,appx_virial,r;
+  double denominator,dot2,dot_virial;
+  double sf[6] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+  int i,k,l,m,n,kper,lper,mper;
 
-  const int twoorder = 2*order;
+  compute_gf_1d(0);
 
   n = 0;
   for (m = nzlo_fft; m <= nzhi_fft; m++) {
     mper = m - nz_pppm*(2*m/nz_pppm);
-    snz = square(sin(MY_PI*mper/nz_pppm));
+    qz = unitkz*mper;
 
     for (l = nylo_fft; l <= nyhi_fft; l++) {
       lper = l - ny_pppm*(2*l/ny_pppm);
-      sny = square(sin(MY_PI*lper/ny_pppm));
+      qy = unitky*lper;
+      wyz = gf_w1d[1][l-nylo_fft] * gf_w1d[2][m-nzlo_fft];
+      const double dyz = gf_denom1d[1][l-nylo_fft] * gf_denom1d[2][m-nzlo_fft];
+      const double ayz = stagger_flag ?
+        gf_alt1d[1][l-nylo_fft] * gf_alt1d[2][m-nzlo_fft] : 0.0;
 
       for (k = nxlo_fft; k <= nxhi_fft; k++) {
         kper = k - nx_pppm*(2*k/nx_pppm);
-        snx = square(sin(MY_PI*kper/nx_pppm));
-
-        double unitk_lamda[3];
-        unitk_lamda[0] = 2.0*MY_PI*kper;
-        unitk_lamda[1] = 2.0*MY_PI*lper;
-        unitk_lamda[2] = 2.0*MY_PI*mper;
-        x2lamdaT(&unitk_lamda[0],&unitk_lamda[0]);
-
-        sqk = square(unitk_lamda[0]) + square(unitk_lamda[1]) + square(unitk_lamda[2]);
-
-        if (sqk != 0.0) {
-          numerator = 12.5663706/sqk;
-          denominator = gf_denom(snx,sny,snz);
-          sum1 = 0.0;
-
-          for (nx = -nbx; nx <= nbx; nx++) {
-            argx = MY_PI*kper/nx_pppm + MY_PI*nx;
-            wx = powsinxx(argx,twoorder);
-
-            for (ny = -nby; ny <= nby; ny++) {
-              argy = MY_PI*lper/ny_pppm + MY_PI*ny;
-              wy = powsinxx(argy,twoorder);
-
-              for (nz = -nbz; nz <= nbz; nz++) {
-                argz = MY_PI*mper/nz_pppm + MY_PI*nz;
-                wz = powsinxx(argz,twoorder);
+        qx = unitkx*kper;
 
-                double b[3];
-                b[0] = 2.0*MY_PI*nx_pppm*nx;
-                b[1] = 2.0*MY_PI*ny_pppm*ny;
-                b[2] = 2.0*MY_PI*nz_pppm*nz;
-                x2lamdaT(&b[0],&b[0]);
+        sqk = qx*qx + qy*qy + qz*qz;
+        denominator = square(gf_denom1d[0][k-nxlo_fft] * dyz);
+        if (stagger_flag)
+          denominator = 0.5*(denominator + square(gf_alt1d[0][k-nxlo_fft] * ayz));
+        arg = sqrt(sqk) * cutoff / select_c;
 
-                qx = unitk_lamda[0]+b[0];
-                sx = exp(-0.25*square(qx/g_ewald));
+        // the denominator can vanish when the spreading accuracy is low
 
-                qy = unitk_lamda[1]+b[1];
-                sy = exp(-0.25*square(qy/g_ewald));
+        if (sqk == 0.0 || denominator == 0.0 || arg > 1.0) {
+          greensfn[n] = 0.0;
+          greensfn2[n] = 0.0;
+        } else {
+          appx = Fourier_poly_coeff[0];
+          appx_virial = 0.0;
+          r = 1.0;
+          for (i = 1; i < num_of_Fourier_poly; i++) {
+            r *= arg;
+            appx += Fourier_poly_coeff[i] * r;
+            appx_virial += Fourier_poly_coeff[i] * i * r;
+          }
+          dot2 = MY_2PI * appx / sqk;
+          dot_virial = MY_2PI * appx_virial / (sqk*sqk);
 
-                qz = unitk_lamda[2]+b[2];
-                sz = exp(-0.25*square(qz/g_ewald));
+          greensfn[n] = dot2 * gf_w1d[0][k-nxlo_fft]*wyz / denominator;
+          greensfn2[n] = dot_virial * gf_w1d[0][k-nxlo_fft]*wyz / denominator;
+        }
 
-                dot1 = unitk_lamda[0]*qx + unitk_lamda[1]*qy + unitk_lamda[2]*qz;
-                dot2 = qx*qx+qy*qy+qz*qz;
-                sum1 += (dot1/dot2) * sx*sy*sz * wx*wy*wz;
-              }
-            }
-          }
-          greensfn[n++] = numerator*sum1/denominator;
-        } else greensfn[n++] = 0.0;
+        sf[0] += kx_weight[k]*sf_precoeff1[n]*greensfn[n];
+        sf[1] += kx_weight[k]*sf_precoeff2[n]*greensfn[n];
+        sf[2] += kx_weight[k]*sf_precoeff3[n]*greensfn[n];
+        sf[3] += kx_weight[k]*sf_precoeff4[n]*greensfn[n];
+        sf[4] += kx_weight[k]*sf_precoeff5[n]*greensfn[n];
+        sf[5] += kx_weight[k]*sf_precoeff6[n]*greensfn[n];
+        n++;
       }
     }
   }
+
+  sum_sf_coeff(sf);
 }
 
 /* ----------------------------------------------------------------------
-   compute optimized Green's function for energy calculation
+   compute the coefficients for the ad self-force correction
+     from my partial sums of sf_precoeff * greensfn
 ------------------------------------------------------------------------- */
 
-void PPPS::compute_gf_ad()
+void PPPS::sum_sf_coeff(const double *sf)
 {
   const double * const prd = domain->prd;
+  const double zprd_slab = prd[2]*slab_volfactor;
 
-  const double xprd = prd[0];
-  const double yprd = prd[1];
-  const double zprd = prd[2];
-  const double zprd_slab = zprd*slab_volfactor;
-  const double unitkx = (MY_2PI/xprd);
-  const double unitky = (MY_2PI/yprd);
-  const double unitkz = (MY_2PI/zprd_slab);
+  double prex, prey, prez, tmp[6];
+  prex = prey = prez = MY_PI/volume;
+  prex *= nx_pppm/prd[0];
+  prey *= ny_pppm/prd[1];
+  prez *= nz_pppm/zprd_slab;
+  tmp[0] = sf[0] * prex;
+  tmp[1] = sf[1] * prex*2;
+  tmp[2] = sf[2] * prey;
+  tmp[3] = sf[3] * prey*2;
+  tmp[4] = sf[4] * prez;
+  tmp[5] = sf[5] * prez*2;
 
-  double snx,sny,snz,sqk;
-  double argx,argy,argz,wx,wy,wz,sx,sy,sz,qx,qy,qz;
-  double numerator,denominator;
-  double sum1, sum_virial, dot1, dot2, dot_virial;
-  int k,l,m,n,kper,lper,mper;
+  // communicate values with other procs
+
+  MPI_Allreduce(tmp,sf_coeff,6,MPI_DOUBLE,MPI_SUM,world);
+}
 
-  const int twoorder = 2*order;
+/* ----------------------------------------------------------------------
+   update the Green's function for a small change of an orthogonal box
+   the PSWF windows depend on each axis only through h*k, which does not
+     change when the box is scaled, so only the splitting factor F/k^2
+     changes; its 1/k^2 part is applied exactly, the change of F is
+     neglected, see gf_strain_coeff for the resulting error
+------------------------------------------------------------------------- */
 
-  for (int i = 0; i < 6; i++) sf_coeff[i] = 0.0;
+void PPPS::rescale_gf()
+{
+  const double * const prd = domain->prd;
+  const double zprd_slab = prd[2]*slab_volfactor;
+  const double unitkx = MY_2PI/prd[0];
+  const double unitky = MY_2PI/prd[1];
+  const double unitkz = MY_2PI/zprd_slab;
+  const double unitkx_last = MY_2PI/gf_prd_last[0];
+  const double unitky_last = MY_2PI/gf_prd_last[1];
+  const double unitkz_last = MY_2PI/(gf_prd_last[2]*slab_volfactor);
+
+  double sf[6] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+  double sqk,ratio;
+  int k,l,m,n,kper,lper,mper;
 
   n = 0;
   for (m = nzlo_fft; m <= nzhi_fft; m++) {
     mper = m - nz_pppm*(2*m/nz_pppm);
-    qz = unitkz*mper;
-    //snz = square(sin(0.5*qz*zprd_slab/nz_pppm));
-    snz = unitkz*mper;
-
-    //sz = exp(-0.25*square(qz/g_ewald));
-    //argz = 0.5*qz*zprd_slab/nz_pppm;
-    //wz = powsinxx(argz,twoorder);
-    
-    double ph_2_kz_c = order * (zprd/nz_pppm) / 2.0 * fabs(qz) / spreading_select_c;
-    wz = 0.00;
-    if(ph_2_kz_c <= 1.00){
-      double Fourier_spreading_appx = Fourier_spreading_coeff[0];
-      double Fourier_spreading_r = 1.0;
-      for(int i=1; i<Fourier_spreading_order; i++){
-        Fourier_spreading_r *= ph_2_kz_c;
-        Fourier_spreading_appx += Fourier_spreading_coeff[i] * Fourier_spreading_r;
-      }
-      wz = order / 2.0 * Fourier_spreading_appx;
-      wz = wz * wz;
-    }
 
     for (l = nylo_fft; l <= nyhi_fft; l++) {
       lper = l - ny_pppm*(2*l/ny_pppm);
-      qy = unitky*lper;
-      //sny = square(sin(0.5*qy*yprd/ny_pppm));
-      sny = unitky*lper;  
-
-      //sy = exp(-0.25*square(qy/g_ewald));
-      //argy = 0.5*qy*yprd/ny_pppm;
-      //wy = powsinxx(argy,twoorder);
-
-      double ph_2_ky_c = order * (yprd/ny_pppm) / 2.0 * fabs(qy) / spreading_select_c;
-      wy = 0.00;
-      if(ph_2_ky_c <= 1.00){
-        double Fourier_spreading_appx = Fourier_spreading_coeff[0];
-        double Fourier_spreading_r = 1.0;
-        for(int i=1; i<Fourier_spreading_order; i++){
-          Fourier_spreading_r *= ph_2_ky_c;
-          Fourier_spreading_appx += Fourier_spreading_coeff[i] * Fourier_spreading_r;
-       }
-        wy = order / 2.0 * Fourier_spreading_appx;
-        wy = wy * wy;
-      }
 
       for (k = nxlo_fft; k <= nxhi_fft; k++) {
         kper = k - nx_pppm*(2*k/nx_pppm);
-        qx = unitkx*kper;
-        //snx = square(sin(0.5*qx*xprd/nx_pppm));
-        snx = unitkx*kper;
-
-        //sx = exp(-0.25*square(qx/g_ewald));
-        //argx = 0.5*qx*xprd/nx_pppm;
-        //wx = powsinxx(argx,twoorder);
-        
-        double ph_2_kx_c = order * (xprd/nx_pppm) / 2.0 * fabs(qx) / spreading_select_c;
-        wx = 0.00;
-        if(ph_2_kx_c <= 1.00){
-          double Fourier_spreading_appx = Fourier_spreading_coeff[0];
-          double Fourier_spreading_r = 1.0;
-          for(int i=1; i<Fourier_spreading_order; i++){
-            Fourier_spreading_r *= ph_2_kx_c;
-            Fourier_spreading_appx += Fourier_spreading_coeff[i] * Fourier_spreading_r;
-          }
-          wx = order / 2.0 * Fourier_spreading_appx;
-          wx = wx * wx;
-        }
-
-        sqk = qx*qx + qy*qy + qz*qz;
-
-        dot1 = unitkx*kper*qx + unitky*lper*qy + unitkz*mper*qz;  
-        double k_rc_c = sqrt(sqk) * cutoff / select_c;
-        if(k_rc_c <= 1.00){
-          double Fourier_poly_appx = Fourier_poly_coeff[0];
-          double Fourier_poly_r = 1.0;
-
-          double Fourier_poly_appx_virial = 0.0;
-          double Fourier_poly_r_virial = 1.0;
-
-          for(int i=1; i<num_of_Fourier_poly; i++){
-            Fourier_poly_r *= k_rc_c;
-            Fourier_poly_r_virial *= k_rc_c;
-
-            Fourier_poly_appx += Fourier_poly_coeff[i] * Fourier_poly_r;
-            Fourier_poly_appx_virial += Fourier_poly_coeff[i] * (i + 0.00) * Fourier_poly_r_virial;
-          }
-          dot2 = MY_2PI * Fourier_poly_appx / (sqk);
-          dot_virial = MY_2PI * Fourier_poly_appx_virial / (sqk*sqk);
-        }
-        else
-        { 
-          dot2 = 0.0;
-          dot_virial = 0.0;
-        }
-        
-        sum1 = dot1 * dot2 * wx * wy * wz;
-        sum_virial = dot_virial * wx * wy * wz;
 
+        sqk = square(unitkx*kper) + square(unitky*lper) + square(unitkz*mper);
         if (sqk != 0.0) {
-          //numerator = MY_4PI/sqk;
-          numerator = 1.0/sqk;
-          //denominator = gf_denom(snx,sny,snz);
-          denominator = gf_denom_psw(snx,sny,snz,xprd/nx_pppm,yprd/ny_pppm,zprd_slab/nz_pppm);
-          //greensfn[n] = numerator*sx*sy*sz*wx*wy*wz/denominator;
-          
-          if(denominator==0.00){
-            greensfn[n] = 0.00;
-            greensfn2[n] = 0.00;
-          }
-          else{
-            greensfn[n] = numerator*sum1/denominator;
-            greensfn2[n] = sum_virial/denominator;
-          }
+          ratio = (square(unitkx_last*kper) + square(unitky_last*lper) +
+                   square(unitkz_last*mper)) / sqk;
+          greensfn[n] *= ratio;
+          greensfn2[n] *= ratio*ratio;
+        }
 
-          sf_coeff[0] += sf_precoeff1[n]*greensfn[n];
-          sf_coeff[1] += sf_precoeff2[n]*greensfn[n];
-          sf_coeff[2] += sf_precoeff3[n]*greensfn[n];
-          sf_coeff[3] += sf_precoeff4[n]*greensfn[n];
-          sf_coeff[4] += sf_precoeff5[n]*greensfn[n];
-          sf_coeff[5] += sf_precoeff6[n]*greensfn[n];
-          n++;
-        } else {
-          greensfn[n] = 0.0;
-          greensfn2[n] = 0.0;
-          sf_coeff[0] += sf_precoeff1[n]*greensfn[n];
-          sf_coeff[1] += sf_precoeff2[n]*greensfn[n];
-          sf_coeff[2] += sf_precoeff3[n]*greensfn[n];
-          sf_coeff[3] += sf_precoeff4[n]*greensfn[n];
-          sf_coeff[4] += sf_precoeff5[n]*greensfn[n];
-          sf_coeff[5] += sf_precoeff6[n]*greensfn[n];
-          n++;
+        if (differentiation_flag == 1) {
+          sf[0] += kx_weight[k]*sf_precoeff1[n]*greensfn[n];
+          sf[1] += kx_weight[k]*sf_precoeff2[n]*greensfn[n];
+          sf[2] += kx_weight[k]*sf_precoeff3[n]*greensfn[n];
+          sf[3] += kx_weight[k]*sf_precoeff4[n]*greensfn[n];
+          sf[4] += kx_weight[k]*sf_precoeff5[n]*greensfn[n];
+          sf[5] += kx_weight[k]*sf_precoeff6[n]*greensfn[n];
         }
+        n++;
       }
     }
   }
 
-  // compute the coefficients for the self-force correction
-
-  double prex, prey, prez;
-  prex = prey = prez = MY_PI/volume;
-  prex *= nx_pppm/xprd;
-  prey *= ny_pppm/yprd;
-  prez *= nz_pppm/zprd_slab;
-  sf_coeff[0] *= prex;
-  sf_coeff[1] *= prex*2;
-  sf_coeff[2] *= prey;
-  sf_coeff[3] *= prey*2;
-  sf_coeff[4] *= prez;
-  sf_coeff[5] *= prez*2;
-
-  // communicate values with other procs
-
-  double tmp[6];
-  MPI_Allreduce(sf_coeff,tmp,6,MPI_DOUBLE,MPI_SUM,world);
-  for (n = 0; n < 6; n++) sf_coeff[n] = tmp[n];
+  if (differentiation_flag == 1) sum_sf_coeff(sf);
+  for (int d = 0; d < 3; d++) gf_prd_last[d] = prd[d];
 }
 
 /* ----------------------------------------------------------------------
@@ -1958,6 +2228,149 @@ void PPPS::compute_sf_precoeff()
       }
     }
   }
+
+  sf_precoeff_flag = 1;
+}
+
+/* ----------------------------------------------------------------------
+   set up the Green's function (and ad self-force coefficients)
+   on the first call after init() or reset_grid() they are read from
+     the per-proc cache files if enabled and the cache key matches,
+     otherwise they are computed and the cache files are (re)written
+   later calls (box changes) always recompute
+------------------------------------------------------------------------- */
+
+void PPPS::compute_gf()
+{
+  const int use_cache = gf_cache_flag && gf_cache_file;
+  gf_cache_flag = 0;
+
+  if (use_cache) {
+    int flag = read_gf_cache();
+    int flag_all;
+    MPI_Allreduce(&flag,&flag_all,1,MPI_INT,MPI_MIN,world);
+    if (flag_all) {
+      if (me == 0) utils::logmesg(lmp,"  Green's function read from cache\n");
+      return;
+    }
+  }
+
+  if (differentiation_flag == 1) {
+    if (!sf_precoeff_flag) compute_sf_precoeff();
+    compute_gf_ad();
+  } else compute_gf_ik();
+
+  if (use_cache) write_gf_cache();
+}
+
+/* ----------------------------------------------------------------------
+   everything the cached Green's function depends on:
+   format version, decomposition, my FFT sub-grid, box shape,
+     stencil and differentiation settings, and the PSWF coefficients,
+   so a cache written by another code version or fit is never reused
+------------------------------------------------------------------------- */
+
+std::vector<double> PPPS::gf_cache_key()
+{
+  std::vector<double> key = {
+    (double) GF_CACHE_VERSION, (double) nprocs, (double) me,
+    (double) nx_pppm, (double) ny_pppm, (double) nz_pppm,
+    (double) nxlo_fft, (double) nxhi_fft, (double) nylo_fft, (double) nyhi_fft,
+    (double) nzlo_fft, (double) nzhi_fft,
+    (double) order, (double) differentiation_flag, slab_volfactor,
+    (double) stagger_flag,
+    cutoff, accuracy_relative, spreading_accuracy,
+    select_c, Lambda_0, spreading_select_c, spreading_Lambda_0};
+
+  for (int i = 0; i < 6; i++) key.push_back(domain->h[i]);
+
+  key.push_back(num_of_Fourier_poly);
+  key.insert(key.end(),Fourier_poly_coeff,Fourier_poly_coeff+num_of_Fourier_poly);
+  key.push_back(Fourier_spreading_order);
+  key.insert(key.end(),Fourier_spreading_coeff,Fourier_spreading_coeff+Fourier_spreading_order);
+  return key;
+}
+
+/* ----------------------------------------------------------------------
+   read my slab of the Green's function from my cache file
+   return 1 if the file exists, its key matches and it is complete, else 0
+------------------------------------------------------------------------- */
+
+int PPPS::read_gf_cache()
+{
+  FILE *fp = fopen(fmt::format("{}.{}",gf_cache_file,me).c_str(),"rb");
+  if (!fp) return 0;
+
+  const std::vector<double> key = gf_cache_key();
+  char magic[sizeof(GF_CACHE_MAGIC)];
+  int nkey = 0;
+  std::vector<double> filekey;
+
+  int flag = (fread(magic,sizeof(magic),1,fp) == 1) &&
+    (memcmp(magic,GF_CACHE_MAGIC,sizeof(magic)) == 0) &&
+    (fread(&nkey,sizeof(int),1,fp) == 1) && (nkey == (int) key.size());
+
+  if (flag) {
+    filekey.resize(nkey);
+    flag = (fread(filekey.data(),sizeof(double),nkey,fp) == (size_t) nkey) && (filekey == key);
+  }
+
+  if (flag) flag = (fread(greensfn,sizeof(double),nfft,fp) == (size_t) nfft);
+  if (flag) flag = (fread(greensfn2,sizeof(double),nfft,fp) == (size_t) nfft);
+
+  if (flag && differentiation_flag == 1) {
+    double *ad_arrays[] = {sf_precoeff1, sf_precoeff2, sf_precoeff3,
+                           sf_precoeff4, sf_precoeff5, sf_precoeff6};
+    for (auto &array : ad_arrays)
+      if (flag) flag = (fread(array,sizeof(double),nfft,fp) == (size_t) nfft);
+    if (flag) flag = (fread(sf_coeff,sizeof(double),6,fp) == 6);
+    sf_precoeff_flag = flag;
+  }
+
+  fclose(fp);
+  return flag;
+}
+
+/* ----------------------------------------------------------------------
+   write my slab of the Green's function to my cache file
+   failure to write is not fatal, the cache is only an optimization
+------------------------------------------------------------------------- */
+
+void PPPS::write_gf_cache()
+{
+  const std::string file = fmt::format("{}.{}",gf_cache_file,me);
+  const std::vector<double> key = gf_cache_key();
+  const int nkey = key.size();
+
+  FILE *fp = fopen(file.c_str(),"wb");
+  int flag = (fp != nullptr);
+
+  if (flag) {
+    flag = (fwrite(GF_CACHE_MAGIC,sizeof(GF_CACHE_MAGIC),1,fp) == 1) &&
+      (fwrite(&nkey,sizeof(int),1,fp) == 1) &&
+      (fwrite(key.data(),sizeof(double),nkey,fp) == (size_t) nkey) &&
+      (fwrite(greensfn,sizeof(double),nfft,fp) == (size_t) nfft) &&
+      (fwrite(greensfn2,sizeof(double),nfft,fp) == (size_t) nfft);
+
+    if (flag && differentiation_flag == 1) {
+      double *ad_arrays[] = {sf_precoeff1, sf_precoeff2, sf_precoeff3,
+                             sf_precoeff4, sf_precoeff5, sf_precoeff6};
+      for (auto &array : ad_arrays)
+        if (flag) flag = (fwrite(array,sizeof(double),nfft,fp) == (size_t) nfft);
+      if (flag) flag = (fwrite(sf_coeff,sizeof(double),6,fp) == 6);
+    }
+    if (fclose(fp) != 0) flag = 0;
+  }
+
+  // remove incomplete files so they cannot be mistaken for a valid cache
+
+  if (!flag) remove(file.c_str());
+
+  int flag_all;
+  MPI_Allreduce(&flag,&flag_all,1,MPI_INT,MPI_MIN,world);
+  if (!flag_all && me == 0)
+    error->warning(FLERR,"Could not write PPPS Green's function cache files {}.*",
+                   gf_cache_file);
 }
 
 /* ----------------------------------------------------------------------
@@ -1990,10 +2403,6 @@ void PPPS::particle_map()
     nx = static_cast<int> ((x[i][0]-boxlo[0])*delxinv+shift) - OFFSET;
     ny = static_cast<int> ((x[i][1]-boxlo[1])*delyinv+shift) - OFFSET;
     nz = static_cast<int> ((x[i][2]-boxlo[2])*delzinv+shift) - OFFSET;
-    
-    //if(i<=10){
-    //  std::cout<<x[i][0]<<"   "<<boxlo[0]<<"    "<<delxinv<<"   "<<shift<<"   "<<OFFSET<<"   "<<(x[i][0]-boxlo[0])*delxinv<<"   "<<nx<<std::endl;
-    //}
 
     part2grid[i][0] = nx;
     part2grid[i][1] = ny;
@@ -2008,6 +2417,52 @@ void PPPS::particle_map()
   }
 
   if (flag) error->one(FLERR,"Out of range atoms - cannot compute PPPS");
+
+  if (sort_block) sort_particles();
+}
+
+/* ----------------------------------------------------------------------
+   counting sort of my particles by the tile of their central grid point
+   tiles are ordered like the grid points of the brick, z slowest
+   atoms of tile t are part_order[tile_start[t]] to part_order[tile_start[t+1]-1]
+------------------------------------------------------------------------- */
+
+void PPPS::sort_particles()
+{
+  const int nlocal = atom->nlocal;
+  const int ntiles = sort_nx*sort_ny*sort_nz;
+
+  if (nlocal > nsort_max) {
+    memory->destroy(part_order);
+    nsort_max = atom->nmax;
+    memory->create(part_order,nsort_max,"pppm:part_order");
+  }
+
+  // central grid pts lie in nlo_out-nlower to nhi_out-nupper, see particle_map()
+
+  const int xlo = nxlo_out - nlower;
+  const int ylo = nylo_out - nlower;
+  const int zlo = nzlo_out - nlower;
+
+  memset(tile_start,0,(ntiles+1)*sizeof(int));
+  for (int i = 0; i < nlocal; i++) {
+    const int t = (((part2grid[i][2]-zlo)/sort_block)*sort_ny +
+                   (part2grid[i][1]-ylo)/sort_block)*sort_nx +
+      (part2grid[i][0]-xlo)/sort_block;
+    tile_start[t+1]++;
+  }
+  for (int t = 0; t < ntiles; t++) tile_start[t+1] += tile_start[t];
+
+  // tile_start[t] is advanced to the end of tile t while filling, then shifted back
+
+  for (int i = 0; i < nlocal; i++) {
+    const int t = (((part2grid[i][2]-zlo)/sort_block)*sort_ny +
+                   (part2grid[i][1]-ylo)/sort_block)*sort_nx +
+      (part2grid[i][0]-xlo)/sort_block;
+    part_order[tile_start[t]++] = i;
+  }
+  for (int t = ntiles; t > 0; t--) tile_start[t] = tile_start[t-1];
+  tile_start[0] = 0;
 }
 
 /* ----------------------------------------------------------------------
@@ -2027,6 +2482,13 @@ void PPPS::make_rho()
   memset(&(density_brick[nzlo_out][nylo_out][nxlo_out]),0,
          ngrid*sizeof(FFT_SCALAR));
 
+  setup_rho_cache(atom->nlocal);
+
+  if (sort_block) {
+    make_rho_tiles();
+    return;
+  }
+
   // loop over my charges, add their contribution to nearby grid points
   // (nx,ny,nz) = global coords of grid pt to "lower left" of charge
   // (dx,dy,dz) = distance to "lower left" grid pt
@@ -2044,12 +2506,9 @@ void PPPS::make_rho()
     dx = nx+shiftone - (x[i][0]-boxlo[0])*delxinv;// - (x-nx)  so the sign of polynomials of spreading operator is opposite from the paper 
     dy = ny+shiftone - (x[i][1]-boxlo[1])*delyinv;
     dz = nz+shiftone - (x[i][2]-boxlo[2])*delzinv;
-    
-    //if(i<=10){
-    //   std::cout<<nx<<"   "<<shiftone<<"   "<<x[i][0]<<"   "<<boxlo[0]<<"    "<<delxinv<<"   "<<(x[i][0]-boxlo[0])*delxinv<<"   "<<std::endl<<dx<<std::endl;
-    //}
 
     compute_rho1d(dx,dy,dz);
+    if (i < nrho_cache) save_rho1d(i,rho1d);
 
     z0 = delvolinv * q[i];
     for (n = nlower; n <= nupper; n++) {
@@ -2067,6 +2526,94 @@ void PPPS::make_rho()
   }
 }
 
+/* ----------------------------------------------------------------------
+   size the spreading weight cache for this step
+   n = # of spread atoms, the cache is indexed by their position in the
+     spreading loop, i.e. the local index or the index in a list of atoms
+   only the first rho_cache_max of them are cached, the others
+     recompute their weights in fieldforce()
+------------------------------------------------------------------------- */
+
+void PPPS::setup_rho_cache(int n)
+{
+  nrho_cache = MIN(n,rho_cache_max);
+  if (nrho_cache > nrho_cache_alloc) {
+    memory->destroy(rho_cache);
+    nrho_cache_alloc = MIN(atom->nmax,rho_cache_max);
+    memory->create(rho_cache,(bigint)3*order*nrho_cache_alloc,"pppm:rho_cache");
+  }
+}
+
+/* ----------------------------------------------------------------------
+   same as make_rho() for particles sorted by sort_particles()
+   the atoms of each tile spread into the small tile_density block,
+     which is then added to density_brick in one pass
+------------------------------------------------------------------------- */
+
+void PPPS::make_rho_tiles()
+{
+  int l,m,n,nx,ny,nz;
+  FFT_SCALAR dx,dy,dz,x0,y0,z0;
+
+  double *q = atom->q;
+  double **x = atom->x;
+
+  const int nspan = sort_block + order - 1;
+  const int nspan3 = nspan*nspan*nspan;
+
+  for (int tz = 0; tz < sort_nz; tz++)
+    for (int ty = 0; ty < sort_ny; ty++)
+      for (int tx = 0; tx < sort_nx; tx++) {
+        const int t = (tz*sort_ny + ty)*sort_nx + tx;
+        if (tile_start[t] == tile_start[t+1]) continue;
+
+        // (ox,oy,oz) = global coords of tile_density[0], lowest stencil pt of the tile
+
+        const int ox = nxlo_out + tx*sort_block;
+        const int oy = nylo_out + ty*sort_block;
+        const int oz = nzlo_out + tz*sort_block;
+
+        memset(tile_density,0,nspan3*sizeof(FFT_SCALAR));
+
+        for (int j = tile_start[t]; j < tile_start[t+1]; j++) {
+          const int i = part_order[j];
+          nx = part2grid[i][0];
+          ny = part2grid[i][1];
+          nz = part2grid[i][2];
+          dx = nx+shiftone - (x[i][0]-boxlo[0])*delxinv;
+          dy = ny+shiftone - (x[i][1]-boxlo[1])*delyinv;
+          dz = nz+shiftone - (x[i][2]-boxlo[2])*delzinv;
+
+          compute_rho1d(dx,dy,dz);
+          if (i < nrho_cache) save_rho1d(i,rho1d);
+
+          z0 = delvolinv * q[i];
+          for (n = nlower; n <= nupper; n++) {
+            y0 = z0*rho1d[2][n];
+            const int jn = (nz+n-oz)*nspan;
+            for (m = nlower; m <= nupper; m++) {
+              x0 = y0*rho1d[1][m];
+              FFT_SCALAR *dens = tile_density + (jn+ny+m-oy)*nspan + nx-ox;
+              for (l = nlower; l <= nupper; l++)
+                dens[l] += x0*rho1d[0][l];
+            }
+          }
+        }
+
+        // tiles at the upper brick edges are clipped, their stencils never reach past it
+
+        const int mz = MIN(nspan,nzhi_out-oz+1);
+        const int my = MIN(nspan,nyhi_out-oy+1);
+        const int mx = MIN(nspan,nxhi_out-ox+1);
+        for (n = 0; n < mz; n++)
+          for (m = 0; m < my; m++) {
+            const FFT_SCALAR *dens = tile_density + (n*nspan+m)*nspan;
+            FFT_SCALAR *brick = &density_brick[oz+n][oy+m][ox];
+            for (l = 0; l < mx; l++) brick[l] += dens[l];
+          }
+      }
+}
+
 /* ----------------------------------------------------------------------
    remap density from 3d brick decomposition to FFT decomposition
 ------------------------------------------------------------------------- */
@@ -2088,6 +2635,27 @@ void PPPS::brick2fft()
   remap->perform(density_fft,density_fft,work1);
 }
 
+/* ----------------------------------------------------------------------
+   transform a real density in FFT decomposition (r -> k)
+   result is complex on my FFT grid, work may not alias density
+------------------------------------------------------------------------- */
+
+void PPPS::fft_density(FFT_SCALAR *density, FFT_SCALAR *work)
+{
+  if (r2c_flag) {
+    fft1->compute(density,work,FFT3d::FORWARD);
+    return;
+  }
+
+  int n = 0;
+  for (int i = 0; i < nfft; i++) {
+    work[n++] = density[i];
+    work[n++] = ZEROF;
+  }
+
+  fft1->compute(work,work,FFT3d::FORWARD);
+}
+
 /* ----------------------------------------------------------------------
    FFT-based Poisson solver
 ------------------------------------------------------------------------- */
@@ -2104,18 +2672,13 @@ void PPPS::poisson()
 
 void PPPS::poisson_ik()
 {
-  int i,j,k,n;
-  double eng;
+  int i,j,k,n,ix;
+  double eng,eng_virial,v[6],v2[6];
 
   // transform charge density (r -> k)
 
-  n = 0;
-  for (i = 0; i < nfft; i++) {
-    work1[n++] = density_fft[i];
-    work1[n++] = ZEROF;
-  }
-
-  fft1->compute(work1,work1,FFT3d::FORWARD);
+  fft_density(density_fft,work1);
+  phase_stamp(PHASE_FFT);
 
   // global energy and virial contribution
 
@@ -2123,21 +2686,32 @@ void PPPS::poisson_ik()
   double scaleinv = 1.0/ngridtotal;
   double s2 = scaleinv*scaleinv;
 
+  // ix = x index of FFT point i, for its weight in the half spectrum
+
   if (eflag_global || vflag_global) {
     if (vflag_global) {
       n = 0;
+      ix = nxlo_fft;
       for (i = 0; i < nfft; i++) {
-        eng = s2 * greensfn[i] * (work1[n]*work1[n] + work1[n+1]*work1[n+1]);
-        for (j = 0; j < 6; j++) virial[j] += eng*vg[i][j];
+        const double rho2 = s2 * kx_weight[ix] * (work1[n]*work1[n] + work1[n+1]*work1[n+1]);
+        eng = greensfn[i] * rho2;
+        eng_virial = greensfn2[i] * rho2;
+        if (!vg_store_flag) virial_coeff(i,v,v2);
+        const double *vgi = vg_store_flag ? vg[i] : v;
+        const double *vg2i = vg_store_flag ? vg2[i] : v2;
+        for (j = 0; j < 6; j++) virial[j] += eng*vgi[j] + eng_virial*vg2i[j];
         if (eflag_global) energy += eng;
         n += 2;
+        if (++ix > nxhi_fft) ix = nxlo_fft;
       }
     } else {
       n = 0;
+      ix = nxlo_fft;
       for (i = 0; i < nfft; i++) {
-        energy +=
-          s2 * greensfn[i] * (work1[n]*work1[n] + work1[n+1]*work1[n+1]);
+        energy += s2 * kx_weight[ix] * greensfn[i] *
+          (work1[n]*work1[n] + work1[n+1]*work1[n+1]);
         n += 2;
+        if (++ix > nxhi_fft) ix = nxlo_fft;
       }
     }
   }
@@ -2150,18 +2724,12 @@ void PPPS::poisson_ik()
     work1[n++] *= scaleinv * greensfn[i];
     work1[n++] *= scaleinv * greensfn[i];
   }
+  phase_stamp(PHASE_GREEN);
 
   // extra FFTs for per-atom energy/virial
 
   if (evflag_atom) poisson_peratom();
 
-  // triclinic system
-
-  if (triclinic) {
-    poisson_ik_triclinic();
-    return;
-  }
-
   // compute gradients of V(r) in each of 3 dims by transforming ik*V(k)
   // FFT leaves data in 3d brick decomposition
   // copy it into inner portion of vdx,vdy,vdz arrays
@@ -2184,7 +2752,7 @@ void PPPS::poisson_ik()
     for (j = nylo_in; j <= nyhi_in; j++)
       for (i = nxlo_in; i <= nxhi_in; i++) {
         vdx_brick[k][j][i] = work2[n];
-        n += 2;
+        n += fft2_stride;
       }
 
   // y direction gradient
@@ -2205,7 +2773,7 @@ void PPPS::poisson_ik()
     for (j = nylo_in; j <= nyhi_in; j++)
       for (i = nxlo_in; i <= nxhi_in; i++) {
         vdy_brick[k][j][i] = work2[n];
-        n += 2;
+        n += fft2_stride;
       }
 
   // z direction gradient
@@ -2226,77 +2794,7 @@ void PPPS::poisson_ik()
     for (j = nylo_in; j <= nyhi_in; j++)
       for (i = nxlo_in; i <= nxhi_in; i++) {
         vdz_brick[k][j][i] = work2[n];
-        n += 2;
-      }
-}
-
-/* ----------------------------------------------------------------------
-   FFT-based Poisson solver for ik for a triclinic system
-------------------------------------------------------------------------- */
-
-void PPPS::poisson_ik_triclinic()
-{
-  int i,j,k,n;
-
-  // compute gradients of V(r) in each of 3 dims by transforming ik*V(k)
-  // FFT leaves data in 3d brick decomposition
-  // copy it into inner portion of vdx,vdy,vdz arrays
-
-  // x direction gradient
-
-  n = 0;
-  for (i = 0; i < nfft; i++) {
-    work2[n] = -fkx[i]*work1[n+1];
-    work2[n+1] = fkx[i]*work1[n];
-    n += 2;
-  }
-
-  fft2->compute(work2,work2,FFT3d::BACKWARD);
-
-  n = 0;
-  for (k = nzlo_in; k <= nzhi_in; k++)
-    for (j = nylo_in; j <= nyhi_in; j++)
-      for (i = nxlo_in; i <= nxhi_in; i++) {
-        vdx_brick[k][j][i] = work2[n];
-        n += 2;
-      }
-
-  // y direction gradient
-
-  n = 0;
-  for (i = 0; i < nfft; i++) {
-    work2[n] = -fky[i]*work1[n+1];
-    work2[n+1] = fky[i]*work1[n];
-    n += 2;
-  }
-
-  fft2->compute(work2,work2,FFT3d::BACKWARD);
-
-  n = 0;
-  for (k = nzlo_in; k <= nzhi_in; k++)
-    for (j = nylo_in; j <= nyhi_in; j++)
-      for (i = nxlo_in; i <= nxhi_in; i++) {
-        vdy_brick[k][j][i] = work2[n];
-        n += 2;
-      }
-
-  // z direction gradient
-
-  n = 0;
-  for (i = 0; i < nfft; i++) {
-    work2[n] = -fkz[i]*work1[n+1];
-    work2[n+1] = fkz[i]*work1[n];
-    n += 2;
-  }
-
-  fft2->compute(work2,work2,FFT3d::BACKWARD);
-
-  n = 0;
-  for (k = nzlo_in; k <= nzhi_in; k++)
-    for (j = nylo_in; j <= nyhi_in; j++)
-      for (i = nxlo_in; i <= nxhi_in; i++) {
-        vdz_brick[k][j][i] = work2[n];
-        n += 2;
+        n += fft2_stride;
       }
 }
 
@@ -2306,18 +2804,13 @@ void PPPS::poisson_ik_triclinic()
 
 void PPPS::poisson_ad()
 {
-  int i,j,k,n;
-  double eng,eng_virial;
+  int i,j,k,n,ix;
+  double eng,eng_virial,v[6],v2[6];
 
   // transform charge density (r -> k)
 
-  n = 0;
-  for (i = 0; i < nfft; i++) {
-    work1[n++] = density_fft[i];
-    work1[n++] = ZEROF;
-  }
-
-  fft1->compute(work1,work1,FFT3d::FORWARD);
+  fft_density(density_fft,work1);
+  phase_stamp(PHASE_FFT);
 
   // global energy and virial contribution
 
@@ -2325,26 +2818,36 @@ void PPPS::poisson_ad()
   double scaleinv = 1.0/ngridtotal;
   double s2 = scaleinv*scaleinv;
 
+  // ix = x index of FFT point i, for its weight in the half spectrum
+
   if (eflag_global || vflag_global) {
     if (vflag_global) {
       n = 0;
+      ix = nxlo_fft;
       for (i = 0; i < nfft; i++) {
-        eng = s2 * greensfn[i] * (work1[n]*work1[n] + work1[n+1]*work1[n+1]);
-        eng_virial = s2 * greensfn2[i] * (work1[n]*work1[n] + work1[n+1]*work1[n+1]);
+        const double rho2 = s2 * kx_weight[ix] * (work1[n]*work1[n] + work1[n+1]*work1[n+1]);
+        eng = greensfn[i] * rho2;
+        eng_virial = greensfn2[i] * rho2;
+        if (!vg_store_flag) virial_coeff(i,v,v2);
+        const double *vgi = vg_store_flag ? vg[i] : v;
+        const double *vg2i = vg_store_flag ? vg2[i] : v2;
         for (j = 0; j < 6; j++) 
         { 
-          virial[j] += eng*vg[i][j]; // The first term
-          virial[j] += eng_virial*vg2[i][j]; // The second term
+          virial[j] += eng*vgi[j]; // The first term
+          virial[j] += eng_virial*vg2i[j]; // The second term
         }
         if (eflag_global) energy += eng;
         n += 2;
+        if (++ix > nxhi_fft) ix = nxlo_fft;
       }
     } else {
       n = 0;
+      ix = nxlo_fft;
       for (i = 0; i < nfft; i++) {
-        energy +=
-          s2 * greensfn[i] * (work1[n]*work1[n] + work1[n+1]*work1[n+1]);
+        energy += s2 * kx_weight[ix] * greensfn[i] *
+          (work1[n]*work1[n] + work1[n+1]*work1[n+1]);
         n += 2;
+        if (++ix > nxhi_fft) ix = nxlo_fft;
       }
     }
   }
@@ -2378,6 +2881,7 @@ void PPPS::poisson_ad()
     work1[n++] *= scaleinv * greensfn[i];
     work1[n++] *= scaleinv * greensfn[i];
   }
+  phase_stamp(PHASE_GREEN);
 
   // extra FFTs for per-atom energy/virial
 
@@ -2397,7 +2901,7 @@ void PPPS::poisson_ad()
     for (j = nylo_in; j <= nyhi_in; j++)
       for (i = nxlo_in; i <= nxhi_in; i++) {
         u_brick[k][j][i] = work2[n];
-        n += 2;
+        n += fft2_stride;
       }
 }
 
@@ -2408,6 +2912,7 @@ void PPPS::poisson_ad()
 void PPPS::poisson_peratom()
 {
   int i,j,k,n;
+  double v[6],v2[6];
 
   // energy
 
@@ -2426,7 +2931,7 @@ void PPPS::poisson_peratom()
       for (j = nylo_in; j <= nyhi_in; j++)
         for (i = nxlo_in; i <= nxhi_in; i++) {
           u_brick[k][j][i] = work2[n];
-          n += 2;
+          n += fft2_stride;
         }
   }
 
@@ -2436,8 +2941,10 @@ void PPPS::poisson_peratom()
 
   n = 0;
   for (i = 0; i < nfft; i++) {
-    work2[n] = work1[n]*vg[i][0];
-    work2[n+1] = work1[n+1]*vg[i][0];
+    if (!vg_store_flag) virial_coeff(i,v,v2);
+    const double vgi = vg_store_flag ? vg[i][0] : v[0];
+    work2[n] = work1[n]*vgi;
+    work2[n+1] = work1[n+1]*vgi;
     n += 2;
   }
 
@@ -2448,13 +2955,15 @@ void PPPS::poisson_peratom()
     for (j = nylo_in; j <= nyhi_in; j++)
       for (i = nxlo_in; i <= nxhi_in; i++) {
         v0_brick[k][j][i] = work2[n];
-        n += 2;
+        n += fft2_stride;
       }
 
   n = 0;
   for (i = 0; i < nfft; i++) {
-    work2[n] = work1[n]*vg[i][1];
-    work2[n+1] = work1[n+1]*vg[i][1];
+    if (!vg_store_flag) virial_coeff(i,v,v2);
+    const double vgi = vg_store_flag ? vg[i][1] : v[1];
+    work2[n] = work1[n]*vgi;
+    work2[n+1] = work1[n+1]*vgi;
     n += 2;
   }
 
@@ -2465,13 +2974,15 @@ void PPPS::poisson_peratom()
     for (j = nylo_in; j <= nyhi_in; j++)
       for (i = nxlo_in; i <= nxhi_in; i++) {
         v1_brick[k][j][i] = work2[n];
-        n += 2;
+        n += fft2_stride;
       }
 
   n = 0;
   for (i = 0; i < nfft; i++) {
-    work2[n] = work1[n]*vg[i][2];
-    work2[n+1] = work1[n+1]*vg[i][2];
+    if (!vg_store_flag) virial_coeff(i,v,v2);
+    const double vgi = vg_store_flag ? vg[i][2] : v[2];
+    work2[n] = work1[n]*vgi;
+    work2[n+1] = work1[n+1]*vgi;
     n += 2;
   }
 
@@ -2482,13 +2993,15 @@ void PPPS::poisson_peratom()
     for (j = nylo_in; j <= nyhi_in; j++)
       for (i = nxlo_in; i <= nxhi_in; i++) {
         v2_brick[k][j][i] = work2[n];
-        n += 2;
+        n += fft2_stride;
       }
 
   n = 0;
   for (i = 0; i < nfft; i++) {
-    work2[n] = work1[n]*vg[i][3];
-    work2[n+1] = work1[n+1]*vg[i][3];
+    if (!vg_store_flag) virial_coeff(i,v,v2);
+    const double vgi = vg_store_flag ? vg[i][3] : v[3];
+    work2[n] = work1[n]*vgi;
+    work2[n+1] = work1[n+1]*vgi;
     n += 2;
   }
 
@@ -2499,13 +3012,15 @@ void PPPS::poisson_peratom()
     for (j = nylo_in; j <= nyhi_in; j++)
       for (i = nxlo_in; i <= nxhi_in; i++) {
         v3_brick[k][j][i] = work2[n];
-        n += 2;
+        n += fft2_stride;
       }
 
   n = 0;
   for (i = 0; i < nfft; i++) {
-    work2[n] = work1[n]*vg[i][4];
-    work2[n+1] = work1[n+1]*vg[i][4];
+    if (!vg_store_flag) virial_coeff(i,v,v2);
+    const double vgi = vg_store_flag ? vg[i][4] : v[4];
+    work2[n] = work1[n]*vgi;
+    work2[n+1] = work1[n+1]*vgi;
     n += 2;
   }
 
@@ -2516,13 +3031,15 @@ void PPPS::poisson_peratom()
     for (j = nylo_in; j <= nyhi_in; j++)
       for (i = nxlo_in; i <= nxhi_in; i++) {
         v4_brick[k][j][i] = work2[n];
-        n += 2;
+        n += fft2_stride;
       }
 
   n = 0;
   for (i = 0; i < nfft; i++) {
-    work2[n] = work1[n]*vg[i][5];
-    work2[n+1] = work1[n+1]*vg[i][5];
+    if (!vg_store_flag) virial_coeff(i,v,v2);
+    const double vgi = vg_store_flag ? vg[i][5] : v[5];
+    work2[n] = work1[n]*vgi;
+    work2[n+1] = work1[n+1]*vgi;
     n += 2;
   }
 
@@ -2533,7 +3050,7 @@ void PPPS::poisson_peratom()
     for (j = nylo_in; j <= nyhi_in; j++)
       for (i = nxlo_in; i <= nxhi_in; i++) {
         v5_brick[k][j][i] = work2[n];
-        n += 2;
+        n += fft2_stride;
       }
 }
 
@@ -2569,7 +3086,8 @@ void PPPS::fieldforce_ik()
 
   int nlocal = atom->nlocal;
 
-  for (i = 0; i < nlocal; i++) {
+  for (int j = 0; j < nlocal; j++) {
+    i = sort_block ? part_order[j] : j;
     nx = part2grid[i][0];
     ny = part2grid[i][1];
     nz = part2grid[i][2];
@@ -2577,7 +3095,8 @@ void PPPS::fieldforce_ik()
     dy = ny+shiftone - (x[i][1]-boxlo[1])*delyinv;
     dz = nz+shiftone - (x[i][2]-boxlo[2])*delzinv;
 
-    compute_rho1d(dx,dy,dz);
+    if (i < nrho_cache) load_rho1d(i,rho1d);
+    else compute_rho1d(dx,dy,dz);
 
     ekx = eky = ekz = ZEROF;
     for (n = nlower; n <= nupper; n++) {
@@ -2639,7 +3158,8 @@ void PPPS::fieldforce_ad()
 
   int nlocal = atom->nlocal;
 
-  for (i = 0; i < nlocal; i++) {
+  for (int j = 0; j < nlocal; j++) {
+    i = sort_block ? part_order[j] : j;
     nx = part2grid[i][0];
     ny = part2grid[i][1];
     nz = part2grid[i][2];
@@ -2647,7 +3167,8 @@ void PPPS::fieldforce_ad()
     dy = ny+shiftone - (x[i][1]-boxlo[1])*delyinv;
     dz = nz+shiftone - (x[i][2]-boxlo[2])*delzinv;
 
-    compute_rho1d(dx,dy,dz);
+    if (i < nrho_cache) load_rho1d(i,rho1d);
+    else compute_rho1d(dx,dy,dz);
     compute_drho1d(dx,dy,dz);
 
     ekx = eky = ekz = ZEROF;
@@ -2691,9 +3212,6 @@ void PPPS::fieldforce_ad()
     sf *= 2*q[i]*q[i];
     //if (slabflag != 2) f[i][2] += qfactor*(ekz*q[i]);
     if (slabflag != 2) f[i][2] += qfactor*(ekz*q[i] - sf);
-
-    if(comm->me==0&&i<=1)
-      printf("The real force is %lf, the self force is %lf \n",ekz*q[i],sf);
   }
 }
 
@@ -2725,7 +3243,8 @@ void PPPS::fieldforce_peratom()
     dy = ny+shiftone - (x[i][1]-boxlo[1])*delyinv;
     dz = nz+shiftone - (x[i][2]-boxlo[2])*delzinv;
 
-    compute_rho1d(dx,dy,dz);
+    if (i < nrho_cache) load_rho1d(i,rho1d);
+    else compute_rho1d(dx,dy,dz);
 
     u = v0 = v1 = v2 = v3 = v4 = v5 = ZEROF;
     for (n = nlower; n <= nupper; n++) {
@@ -2958,29 +3477,10 @@ void PPPS::procs2grid2d(int nprocs, int nx, int ny, int *px, int *py)
 void PPPS::compute_rho1d(const FFT_SCALAR &dx, const FFT_SCALAR &dy,
                          const FFT_SCALAR &dz)
 {
-  int k,l;
-  FFT_SCALAR r1,r2,r3;
-  
-  // k: order of spreading points
-  // l: order of polynomials 
-  for (k = (1-order)/2; k <= order/2; k++) {
-    r1 = r2 = r3 = ZEROF;
-
-    ////for (l = order-1; l >= 0; l--) {
-    for (l = poly_order-1; l >=0; l--) {
-      r1 = rho_coeff[l][k] + r1*dx;
-      r2 = rho_coeff[l][k] + r2*dy;
-      r3 = rho_coeff[l][k] + r3*dz;
-    }
-    rho1d[0][k] = r1;
-    rho1d[1][k] = r2;
-    rho1d[2][k] = r3;
-  }
-  
-  // std::cout<<"Begin: dx. dy, dz "<<"   "<<dx<<"  "<<dy<<"   "<<dz<<std::endl;
-  // for (k = (1-order)/2; k <= order/2; k += 1) {
-  //   std::cout<<rho1d[0][k]<<"  "<<rho1d[1][k]<<"  "<<rho1d[2][k]<<"  "<<std::endl; // Coefficients for x^l terms
-  // }
+  if (rho_table_flag) lookup_rho1d(rho1d,rho_lookup,dx,dy,dz);
+  else if (rho_pieces > 1)
+    rho1d_pieces_kernel(rho1d,rho_coeff,poly_order,rho_pieces,(1-order)/2,order/2,dx,dy,dz);
+  else rho1d_kernel(rho1d,rho_coeff,(1-order)/2,order/2,dx,dy,dz);
 }
 
 /* ----------------------------------------------------------------------
@@ -2991,122 +3491,212 @@ void PPPS::compute_rho1d(const FFT_SCALAR &dx, const FFT_SCALAR &dy,
 void PPPS::compute_drho1d(const FFT_SCALAR &dx, const FFT_SCALAR &dy,
                           const FFT_SCALAR &dz)
 {
-  int k,l;
-  FFT_SCALAR r1,r2,r3;
-
-  for (k = (1-order)/2; k <= order/2; k++) {
-    r1 = r2 = r3 = ZEROF;
-
-    for (l = poly_order-2; l >= 0; l--) {
-      r1 = drho_coeff[l][k] + r1*dx;
-      r2 = drho_coeff[l][k] + r2*dy;
-      r3 = drho_coeff[l][k] + r3*dz;
-    } 
-    drho1d[0][k] = r1;
-    drho1d[1][k] = r2;
-    drho1d[2][k] = r3;
-  }
-}
-
-/* ----------------------------------------------------------------------
-   generate coeffients for the weight function of order n
-
-              (n-1)
-  Wn(x) =     Sum    wn(k,x) , Sum is over every other integer
-           k=-(n-1)
-  For k=-(n-1),-(n-1)+2, ....., (n-1)-2,n-1
-      k is odd integers if n is even and even integers if n is odd
-              ---
-             | n-1
-             | Sum a(l,j)*(x-k/2)**l   if abs(x-k/2) < 1/2
-  wn(k,x) = <  l=0
-             |
-             |  0                       otherwise
-              ---
-  a coeffients are packed into the array rho_coeff to eliminate zeros
-  rho_coeff(l,((k+mod(n+1,2))/2) = a(l,k)
-------------------------------------------------------------------------- */
-
-/*
-template <typename TYPE>
-TYPE **create2d_offset(TYPE **&array, int n1, int n2lo, int n2hi, const char *name)
-  {
-    // POSSIBLE future change
-    //if (n1 <= 0 || n2lo > n2hi) return nullptr;
-
-    int n2 = n2hi - n2lo + 1;
-    create(array, n1, n2, name);
-    for (int i = 0; i < n1; i++) array[i] -= n2lo;
-    return array;
-  }
-
-template <typename TYPE> TYPE **create(TYPE **&array, int n1, int n2, const char *name)
-  {
-    // POSSIBLE future change
-    //if (n1 <= 0 || n2 <= 0) return nullptr;
-
-    bigint nbytes = ((bigint) sizeof(TYPE)) * n1 * n2;
-    TYPE *data = (TYPE *) smalloc(nbytes, name);
-    nbytes = ((bigint) sizeof(TYPE *)) * n1;
-    array = (TYPE **) smalloc(nbytes, name);
-
-    bigint n = 0;
-    for (int i = 0; i < n1; i++) {
-      array[i] = &data[n];
-      n += n2;
-    }
-    return array;
-  }
-*/
+  if (rho_table_flag) lookup_rho1d(drho1d,drho_lookup,dx,dy,dz);
+  else if (rho_pieces > 1)
+    drho1d_pieces_kernel(drho1d,drho_coeff,poly_order,rho_pieces,(1-order)/2,order/2,dx,dy,dz);
+  else drho1d_kernel(drho1d,drho_coeff,(1-order)/2,order/2,dx,dy,dz);
+}
+
+/* ----------------------------------------------------------------------
+   PSWF splitting coefficients for accuracy_relative
+   c, Lambda_0 and the monomial coefficients of the real space force and
+   energy kernels and of the Fourier space kernel, all in scaled units
+   r/cutoff resp. k*cutoff/c, with degrees chosen for the requested accuracy
+   the force and energy kernels consist of num_of_poly_pieces polynomials
+     with num_of_force_poly resp. num_of_energy_poly coefficients each
+------------------------------------------------------------------------- */
+
+void PPPS::compute_split_coeff()
+{
+  const PSWFSplittingCoeffs &fit =
+    splitting_coeffs(accuracy_relative,POLY_FIT_RATIO*accuracy_relative,PSWFPoly::MAXPOLY,
+                     num_of_poly_pieces);
+  if (fit.err > accuracy_relative && me == 0)
+    error->warning(FLERR,"PSWF splitting polynomial error {:.8g} exceeds requested accuracy",
+                   fit.err);
+
+  select_c = fit.c;
+  Lambda_0 = fit.lambda;
+  self_coeff = fit.self;
+  num_of_force_poly = fit.force.size() / fit.pieces;
+  num_of_energy_poly = fit.energy.size() / fit.pieces;
+  num_of_Fourier_poly = fit.fourier.size();
+
+  memory->destroy(force_poly_coeff);
+  memory->destroy(energy_poly_coeff);
+  memory->destroy(Fourier_poly_coeff);
+  memory->create(force_poly_coeff,fit.force.size(),"pppm:force_poly_coeff");
+  memory->create(energy_poly_coeff,fit.energy.size(),"pppm:energy_poly_coeff");
+  memory->create(Fourier_poly_coeff,num_of_Fourier_poly,"pppm:Fourier_poly_coeff");
+  for (std::size_t i = 0; i < fit.force.size(); i++) force_poly_coeff[i] = fit.force[i];
+  for (std::size_t i = 0; i < fit.energy.size(); i++) energy_poly_coeff[i] = fit.energy[i];
+  for (int i = 0; i < num_of_Fourier_poly; i++) Fourier_poly_coeff[i] = fit.fourier[i];
+}
+
+/* ----------------------------------------------------------------------
+   PSWF spreading parameters for spreading_accuracy and the current order
+   sets c, Lambda_0 and the Fourier transform of the spreading function,
+   the number of terms per stencil point and the matching stencil kernels
+   rho_coeff itself is filled by compute_rho_coeff() once allocated
+------------------------------------------------------------------------- */
+
+void PPPS::compute_spread_coeff()
+{
+  const PSWFSpreadingCoeffs &fit =
+    spreading_coeffs(spreading_accuracy,order,POLY_FIT_RATIO*spreading_accuracy,
+                     PSWFPoly::MAXPOLY,rho_pieces);
+  if (fit.err > spreading_accuracy && me == 0)
+    error->warning(FLERR,"PSWF spreading polynomial error {:.8g} exceeds requested accuracy",
+                   fit.err);
+
+  spreading_select_c = fit.c;
+  spreading_Lambda_0 = fit.lambda;
+  poly_order = fit.nterms;
+  Fourier_spreading_order = fit.fourier.size();
+
+  memory->destroy(Fourier_spreading_coeff);
+  memory->create(Fourier_spreading_coeff,Fourier_spreading_order,
+                 "pppm:Fourier_spreading_coeff");
+  for (int i = 0; i < Fourier_spreading_order; i++)
+    Fourier_spreading_coeff[i] = fit.fourier[i];
+
+  // select the spreading kernels matching the polynomial degree
+
+  rho1d_kernel = PSWFPoly::select_stencil(poly_order);
+  drho1d_kernel = PSWFPoly::select_stencil(poly_order-1);
+  rho1d_pieces_kernel = PSWFPoly::select_pieces_stencil(poly_order);
+  drho1d_pieces_kernel = PSWFPoly::select_pieces_stencil(poly_order-1);
+  if (!rho1d_kernel || !drho1d_kernel)
+    error->all(FLERR,"Unsupported PSWF spreading polynomial order {}",poly_order);
+}
+
+/* ----------------------------------------------------------------------
+   check if the PSWF spreading fit for accuracy spread and stencil order ord
+     has stencil kernels, else compute_spread_coeff() would error out
+   used to skip unusable candidates when searching for the order
+------------------------------------------------------------------------- */
+
+int PPPS::spread_fit_supported(double spread, int ord)
+{
+  const PSWFSpreadingCoeffs &fit =
+    spreading_coeffs(spread,ord,POLY_FIT_RATIO*spread,PSWFPoly::MAXPOLY,rho_pieces);
+  return PSWFPoly::select_stencil(fit.nterms) && PSWFPoly::select_stencil(fit.nterms-1);
+}
+
+/* ----------------------------------------------------------------------
+   coefficients of the PSWF spreading function for each of the order
+   stencil points, a polynomial in the distance dx from the nearest grid
+   point, same packing as the B-spline coefficients of PPPM
+   rho_coeff[l][k] = coefficient of dx^l for stencil point k
+   with rho_pieces > 1, rho_coeff[s*poly_order + l][k] = coefficient of t^l
+     in piece s, with t the local variable of PSWFPoly::piece()
+------------------------------------------------------------------------- */
 
 void PPPS::compute_rho_coeff()
 {
-  int j,k,l,m;
-  FFT_SCALAR s;
-
-  FFT_SCALAR **a;
-  memory->create2d_offset(a,order,-order,order,"pppm:a");
-
-  for (k = -order; k <= order; k++)
-    for (l = 0; l < order; l++)
-      a[l][k] = 0.0;
-
-  a[0][0] = 1.0;
-  for (j = 1; j < order; j++) {
-    for (k = -j; k <= j; k += 2) {
-      s = 0.0;
-      for (l = 0; l < j; l++) {
-        a[l+1][k] = (a[l][k+1]-a[l][k-1]) / (l+1);
-#ifdef FFT_SINGLE
-        s += powf(0.5,(float) l+1) *
-          (a[l][k-1] + powf(-1.0,(float) l) * a[l][k+1]) / (l+1);
-#else
-        s += pow(0.5,(double) l+1) *
-          (a[l][k-1] + pow(-1.0,(double) l) * a[l][k+1]) / (l+1);
-#endif
-      }
-      a[0][k] = s;
+  const PSWFSpreadingCoeffs &fit =
+    spreading_coeffs(spreading_accuracy,order,POLY_FIT_RATIO*spreading_accuracy,
+                     PSWFPoly::MAXPOLY,rho_pieces);
+
+  // dt/dx = rho_pieces scales the derivative of each piece
+
+  const int klo = (1-order)/2;
+  for (int s = 0; s < rho_pieces; s++) {
+    FFT_SCALAR **coeff = rho_coeff + s*poly_order;
+    FFT_SCALAR **dcoeff = drho_coeff + s*poly_order;
+    const double *real = fit.real.data() + s*poly_order*order;
+    for (int k = klo; k <= order/2; k++) {
+      for (int l = 0; l < poly_order; l++)
+        coeff[l][k] = real[l*order + k-klo];                // coefficients for x^l terms
+      for (int l = 1; l < poly_order; l++)
+        dcoeff[l-1][k] = l*rho_pieces*coeff[l][k];         // coefficients for l x^l-1 terms
+      dcoeff[poly_order-1][k] = 0.0;
     }
   }
 
-  m = (1-order)/2;
-  for (k = -(order-1); k < order; k += 2) {
-    for (l = 0; l < order; l++)
-      rho_coeff[l][m] = a[l][k]; // Coefficients for x^l terms
-    for (l = 1; l < order; l++)
-      drho_coeff[l-1][m] = l*a[l][k]; // Coefficients for l x^l-1 terms
-    m++;
+  compute_rho_table();
+}
+
+/* ----------------------------------------------------------------------
+   tabulate the spreading weights of all stencil points on [-1,1]
+   the number of rows is doubled until linear interpolation reproduces
+     the polynomials at the interval midpoints to RHO_TABLE_RATIO
+     times the spreading accuracy, relative to their largest value
+   drho_lookup is only needed for ad differentiation
+------------------------------------------------------------------------- */
+
+void PPPS::compute_rho_table()
+{
+  memory->destroy(rho_lookup);
+  memory->destroy(drho_lookup);
+  rho_points = 0;
+  rho_scale = rho_table_error = 0.0;
+  if (!rho_table_flag) return;
+
+  const int klo = (1-order)/2;
+  const int khi = order/2;
+  const int ntable = (differentiation_flag == 1) ? 2 : 1;
+  FFT_SCALAR **coeff[2] = {rho_coeff, drho_coeff};
+
+  auto weight = [&](int t, int k, double x) {
+    FFT_SCALAR **c = coeff[t];
+    if (rho_pieces > 1) {
+      FFT_SCALAR u;
+      c += PSWFPoly::piece(rho_pieces,x,u)*poly_order;
+      x = u;
+    }
+    double r = 0.0;
+    for (int l = poly_order-1; l >= 0; l--) r = c[l][k] + r*x;
+    return r;
+  };
+
+  // relative midpoint error for a given number of intervals
+
+  auto table_error = [&](int nint) {
+    const double h = 2.0/nint;
+    double err = 0.0;
+    for (int t = 0; t < ntable; t++) {
+      double wmax = 0.0, emax = 0.0;
+      for (int k = klo; k <= khi; k++) {
+        double wlo = weight(t,k,-1.0);
+        for (int i = 0; i < nint; i++) {
+          const double whi = weight(t,k,-1.0 + (i+1)*h);
+          const double wmid = weight(t,k,-1.0 + (i+0.5)*h);
+          emax = MAX(emax,fabs(wmid - 0.5*(wlo + whi)));
+          wmax = MAX(wmax,fabs(wmid));
+          wlo = whi;
+        }
+      }
+      if (wmax > 0.0) err = MAX(err,emax/wmax);
+    }
+    return err;
+  };
+
+  const double tol = RHO_TABLE_RATIO*spreading_accuracy;
+  int nint = RHO_TABLE_MIN;
+  rho_table_error = table_error(nint);
+  while (rho_table_error > tol && nint < RHO_TABLE_MAX) {
+    nint *= 2;
+    rho_table_error = table_error(nint);
   }
-  
-  std::cout<<" order = "<<order<<std::endl;
-  std::cout<<"Begin: Coefficients rho_coeff";
-  for (k = (1-order)/2; k <= order/2; k += 1) {
-    std::cout<<std::endl;
-    for (l = 0; l < order; l++)
-      std::cout<<rho_coeff[l][k]<<"  "; // Coefficients for x^l terms
+  if (rho_table_error > tol && me == 0)
+    error->warning(FLERR,"PPPS spreading table error {:.8g} exceeds requested accuracy",
+                   rho_table_error);
+
+  // one row beyond x = 1 so interpolation never reads past the end
+
+  rho_points = nint + 2;
+  rho_scale = 0.5*nint;
+  memory->create(rho_lookup,rho_points,order,"pppm:rho_lookup");
+  if (ntable == 2) memory->create(drho_lookup,rho_points,order,"pppm:drho_lookup");
+
+  for (int i = 0; i < rho_points; i++) {
+    const double x = -1.0 + i/rho_scale;
+    for (int k = klo; k <= khi; k++) {
+      rho_lookup[i][k-klo] = weight(0,k,x);
+      if (ntable == 2) drho_lookup[i][k-klo] = weight(1,k,x);
+    }
   }
-
-  memory->destroy2d_offset(a,-order);
 }
 
 /* ----------------------------------------------------------------------
@@ -3234,6 +3824,22 @@ int PPPS::timing_3d(int n, double &time3d)
   return 4;
 }
 
+/* ----------------------------------------------------------------------
+   wall times of the phases of compute() since the start of the run
+   the Green's convolution includes the global energy and virial sums,
+     the backward FFTs include the per-atom energy/virial FFTs
+------------------------------------------------------------------------- */
+
+int PPPS::timing_phases(const char *const *&names, const double *&times)
+{
+  static const char *const phase_names[NPHASE] = {
+    "Map", "Rho", "RevComm", "Remap", "FFT", "Green", "IFFT", "FwdComm", "Field"};
+
+  names = phase_names;
+  times = phase_time;
+  return NPHASE;
+}
+
 /* ----------------------------------------------------------------------
    memory usage of local arrays
 ------------------------------------------------------------------------- */
@@ -3250,9 +3856,10 @@ double PPPS::memory_usage()
     bytes += (double)4 * nbrick * sizeof(FFT_SCALAR);
   }
 
-  if (triclinic) bytes += (double)3 * nfft_both * sizeof(double);
-  bytes += (double)6 * nfft_both * sizeof(double);
+  if (vg) bytes += (double)6 * nfft_both * sizeof(double);
+  if (vg2) bytes += (double)6 * nfft_both * sizeof(double);
   bytes += (double)nfft_both * sizeof(double);
+  if (greensfn2) bytes += (double)nfft_both * sizeof(double);
   bytes += (double)nfft_both*5 * sizeof(FFT_SCALAR);
 
   if (peratom_allocate_flag)
@@ -3267,6 +3874,22 @@ double PPPS::memory_usage()
 
   bytes += (double)(ngc_buf1 + ngc_buf2) * npergrid * sizeof(FFT_SCALAR);
 
+  // spreading weight tables
+
+  if (rho_lookup) bytes += (double)rho_points * order * sizeof(FFT_SCALAR);
+  if (drho_lookup) bytes += (double)rho_points * order * sizeof(FFT_SCALAR);
+
+  // cached spreading weights and atom ordering by tiles
+
+  bytes += (double)nrho_cache_alloc * 3 * order * sizeof(FFT_SCALAR);
+
+  bytes += (double)nsort_max * sizeof(int);
+  if (sort_block) {
+    const int nspan = sort_block + order - 1;
+    bytes += (double)(sort_nx*sort_ny*sort_nz+1) * sizeof(int);
+    bytes += (double)nspan*nspan*nspan * sizeof(FFT_SCALAR);
+  }
+
   return bytes;
 }
 
@@ -3280,23 +3903,13 @@ double PPPS::memory_usage()
 
 void PPPS::compute_group_group(int groupbit_A, int groupbit_B, int AA_flag)
 {
-  if (slabflag && triclinic)
-    error->all(FLERR,"Cannot (yet) use K-space slab "
-               "correction with compute group/group for triclinic systems");
-
   if (differentiation_flag)
     error->all(FLERR,"Cannot (yet) use kspace_modify "
                "diff ad with compute group/group");
 
   if (!group_allocate_flag) allocate_groups();
 
-  // convert atoms from box to lamda coords
-
-  if (triclinic == 0) boxlo = domain->boxlo;
-  else {
-    boxlo = domain->boxlo_lamda;
-    domain->x2lamda(atom->nlocal);
-  }
+  boxlo = domain->boxlo;
 
   e2group = 0.0; //energy
   f2group[0] = 0.0; //force in x-direction
@@ -3366,10 +3979,6 @@ void PPPS::compute_group_group(int groupbit_A, int groupbit_B, int AA_flag)
   f2group[1] = qscale*volume*f2group_all[1];
   if (slabflag != 2) f2group[2] = qscale*volume*f2group_all[2];
 
-  // convert atoms back from lamda to box coords
-
-  if (triclinic) domain->lamda2x(atom->nlocal);
-
   if (slabflag == 1)
     slabcorr_groups(groupbit_A, groupbit_B, AA_flag);
 }
@@ -3493,23 +4102,11 @@ void PPPS::poisson_groups(int AA_flag)
 
   // group A
 
-  n = 0;
-  for (i = 0; i < nfft; i++) {
-    work_A[n++] = density_A_fft[i];
-    work_A[n++] = ZEROF;
-  }
-
-  fft1->compute(work_A,work_A,FFT3d::FORWARD);
+  fft_density(density_A_fft,work_A);
 
   // group B
 
-  n = 0;
-  for (i = 0; i < nfft; i++) {
-    work_B[n++] = density_B_fft[i];
-    work_B[n++] = ZEROF;
-  }
-
-  fft1->compute(work_B,work_B,FFT3d::FORWARD);
+  fft_density(density_B_fft,work_B);
 
   // group-group energy and force contribution,
   //  keep everything in reciprocal space so
@@ -3520,12 +4117,15 @@ void PPPS::poisson_groups(int AA_flag)
   double s2 = scaleinv*scaleinv;
 
   // energy
+  // ix = x index of FFT point i, for its weight in the half spectrum
 
   n = 0;
+  int ix = nxlo_fft;
   for (i = 0; i < nfft; i++) {
-    e2group += s2 * greensfn[i] *
+    e2group += s2 * kx_weight[ix] * greensfn[i] *
       (work_A[n]*work_B[n] + work_A[n+1]*work_B[n+1]);
     n += 2;
+    if (++ix > nxhi_fft) ix = nxlo_fft;
   }
 
   if (AA_flag) return;
@@ -3539,13 +4139,6 @@ void PPPS::poisson_groups(int AA_flag)
     work_A[n++] *= s2 * greensfn[i];
   }
 
-  // triclinic system
-
-  if (triclinic) {
-    poisson_groups_triclinic();
-    return;
-  }
-
   double partial_group;
 
   // force, x direction
@@ -3555,7 +4148,7 @@ void PPPS::poisson_groups(int AA_flag)
     for (j = nylo_fft; j <= nyhi_fft; j++)
       for (i = nxlo_fft; i <= nxhi_fft; i++) {
         partial_group = work_A[n]*work_B[n+1] - work_A[n+1]*work_B[n];
-        f2group[0] += fkx[i] * partial_group;
+        f2group[0] += kx_weight[i] * fkx[i] * partial_group;
         n += 2;
       }
 
@@ -3566,7 +4159,7 @@ void PPPS::poisson_groups(int AA_flag)
     for (j = nylo_fft; j <= nyhi_fft; j++)
       for (i = nxlo_fft; i <= nxhi_fft; i++) {
         partial_group = work_A[n]*work_B[n+1] - work_A[n+1]*work_B[n];
-        f2group[1] += fky[j] * partial_group;
+        f2group[1] += kx_weight[i] * fky[j] * partial_group;
         n += 2;
       }
 
@@ -3577,55 +4170,11 @@ void PPPS::poisson_groups(int AA_flag)
     for (j = nylo_fft; j <= nyhi_fft; j++)
       for (i = nxlo_fft; i <= nxhi_fft; i++) {
         partial_group = work_A[n]*work_B[n+1] - work_A[n+1]*work_B[n];
-        f2group[2] += fkz[k] * partial_group;
+        f2group[2] += kx_weight[i] * fkz[k] * partial_group;
         n += 2;
       }
 }
 
-/* ----------------------------------------------------------------------
-   FFT-based Poisson solver for group-group interactions
-   for a triclinic system
- ------------------------------------------------------------------------- */
-
-void PPPS::poisson_groups_triclinic()
-{
-  int i,n;
-
-  // reuse memory (already declared)
-
-  FFT_SCALAR *work_A = work1;
-  FFT_SCALAR *work_B = work2;
-
-  double partial_group;
-
-  // force, x direction
-
-  n = 0;
-  for (i = 0; i < nfft; i++) {
-    partial_group = work_A[n]*work_B[n+1] - work_A[n+1]*work_B[n];
-    f2group[0] += fkx[i] * partial_group;
-    n += 2;
-  }
-
-  // force, y direction
-
-  n = 0;
-  for (i = 0; i < nfft; i++) {
-    partial_group = work_A[n]*work_B[n+1] - work_A[n+1]*work_B[n];
-    f2group[1] += fky[i] * partial_group;
-    n += 2;
-  }
-
-  // force, z direction
-
-  n = 0;
-  for (i = 0; i < nfft; i++) {
-    partial_group = work_A[n]*work_B[n+1] - work_A[n+1]*work_B[n];
-    f2group[2] += fkz[i] * partial_group;
-    n += 2;
-  }
-}
-
 /* ----------------------------------------------------------------------
    slab-geometry correction term to dampen inter-slab interactions between
    periodically repeating slabs.  Yields good approximation to 2D Ewald if
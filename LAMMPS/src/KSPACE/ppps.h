@@ -23,6 +23,9 @@ KSpaceStyle(ppps,PPPS);
 #include "kspace.h"
 #include "math_const.h"
 #include "lmpfftsettings.h" // IWYU pragma: export
+#include "pswf_poly.h"
+
+#include <vector>
 using namespace LAMMPS_NS;
 using namespace MathConst;
 
@@ -39,16 +42,20 @@ class PPPS : public KSpace {
   void compute(int, int) override;
   int timing_1d(int, double &) override;
   int timing_3d(int, double &) override;
+  int timing_phases(const char *const *&, const double *&) override;
   double memory_usage() override;
-  int build_table(double, double);
+  int modify_param(int, char **) override;
 
   void compute_group_group(int, int, int) override;
+  int tune_mesh(double, int, double, int *);
+  void set_accuracy(double, double);
 
  protected:
   int me, nprocs;
   int nfactors;
   int *factors;
   double cutoff;
+  double self_coeff;    // self energy prefactor, exact slope of the PSWF energy kernel at 0
   double volume;
   double delxinv, delyinv, delzinv, delvolinv;
   double h_x, h_y, h_z;
@@ -69,15 +76,77 @@ class PPPS : public KSpace {
   FFT_SCALAR ***v3_brick, ***v4_brick, ***v5_brick;
   double *greensfn, *greensfn2;
   double **vg, **vg2;
+  int vg_store_flag;     // 1 to store vg/vg2, 0 to compute them in each virial sum
   double *fkx, *fky, *fkz;
   FFT_SCALAR *density_fft;
   FFT_SCALAR *work1, *work2;
 
+  // real-to-complex FFTs, n xyz lo/hi fft then only cover the
+  //   non-negative x frequencies of the Hermitian spectrum
+
+  int r2c_flag;          // 1 if fft1/fft2 transform real data to/from the half spectrum
+  int nfft_real;         // real FFT points in x-pencil decomposition on this proc
+  int fft2_stride;       // stride of real values in fft2 output, 1 for c2r, 2 otherwise
+  double *kx_weight;     // multiplicity of x frequencies in sums over my FFT grid
+
   double *gf_b;
   FFT_SCALAR **rho1d, **rho_coeff, **drho1d, **drho_coeff; // coefficients for the table of spreading function
+  PSWFPoly::stencil_t rho1d_kernel, drho1d_kernel;  // unrolled stencil kernels for poly_order
+
+  // piecewise spreading polynomials, rows s*poly_order..(s+1)*poly_order-1
+  //   of rho_coeff and drho_coeff hold piece s, see PSWFPoly::piece()
+
+  int rho_pieces;                                        // 1 for global polynomials
+  PSWFPoly::pieces_stencil_t rho1d_pieces_kernel, drho1d_pieces_kernel;
+
+  // tabulated spreading weights, linearly interpolated in the fractional offset
+
+  int rho_table_flag;                      // 1 to use rho_lookup/drho_lookup
+  int rho_points;                          // rows in the lookup tables
+  double rho_scale;                        // table rows per unit offset
+  double rho_table_error;                  // estimated relative interpolation error
+  FFT_SCALAR **rho_lookup, **drho_lookup;  // weights of all stencil points per row
+
+  // optional ordering of local atoms by tiles of their central grid points
+  //   atom arrays are not reordered, spreading and interpolation follow part_order
+
+  int sort_block;                   // tile edge in grid points, 0 = use atom order
+  int sort_nx, sort_ny, sort_nz;    // tiles along each axis of my brick
+  int nsort_max;                    // allocated length of part_order
+  int *part_order;                  // local atom indices ordered by tile
+  int *tile_start;                  // first part_order entry of each tile and end marker
+  FFT_SCALAR *tile_density;         // density spread by the atoms of a single tile
+
+  // spreading weights kept from make_rho() for the interpolation in fieldforce()
+
+  int rho_cache_max;        // most local atoms with cached weights, 0 = no cache
+  int nrho_cache;           // spread atoms 0 to nrho_cache-1 are cached this step
+  int nrho_cache_alloc;     // allocated atoms in rho_cache
+  FFT_SCALAR *rho_cache;    // 3*order weights per atom, x then y then z
+
   double *sf_precoeff1, *sf_precoeff2, *sf_precoeff3;
   double *sf_precoeff4, *sf_precoeff5, *sf_precoeff6;
   double sf_coeff[6];    // coefficients for calculating ad self-forces
+
+  // separable per-axis factors of the Green's function on my FFT sub-grid
+
+  int gf_nb[3];             // aliases summed on either side in the ik numerator
+  double *gf_denom1d[3];    // aliased sum of the squared spreading window
+  double *gf_w1d[3];        // squared spreading window of aliases -nb..nb
+  double *gf_alt1d[3];      // alternating aliased sum, only for staggered grids
+  int sf_precoeff_flag;  // 1 if sf_precoeff arrays match the current grid
+
+  // incremental Green's function update for changing boxes
+
+  double gf_update_tol;     // relative box change before a full rebuild, 0.0 = always rebuild
+  int gf_ref_flag;          // 1 if greensfn is valid for gf_prd_last
+  double gf_prd_ref[3];     // box lengths at the last full rebuild
+  double gf_prd_last[3];    // box lengths greensfn currently corresponds to
+  double gf_strain_coeff;   // estimated relative Green's function error per unit strain
+  double gf_error;          // max estimated relative error of greensfn since the last rebuild
+
+  char *gf_cache_file;    // per-rank Green's function cache file prefix, null if disabled
+  int gf_cache_flag;      // 1 if the next Green's function setup may use the cache
   double **acons;
 
   // FFTs and grid communication
@@ -99,6 +168,29 @@ class PPPS : public KSpace {
   int nmax;
 
   double *boxlo;
+
+  // automatic stencil order, see select_order()
+
+  int order_auto;        // last automatically selected order, 0 if order was set explicitly
+  int order_auto_max;    // largest order considered
+  double estimated_accuracy;    // estimated absolute RMS force error from final_accuracy()
+
+  // wall time of the phases of compute() since the start of the run
+
+  enum { PHASE_MAP, PHASE_RHO, PHASE_REVCOMM, PHASE_REMAP, PHASE_FFT,
+         PHASE_GREEN, PHASE_IFFT, PHASE_FWDCOMM, PHASE_FIELD, NPHASE };
+  double phase_time[NPHASE];
+  double phase_last;     // wall time at the end of the previous phase
+  int phase_flag;        // 1 if phases are timed in this compute() call
+
+  void phase_stamp(int which)
+  {
+    if (!phase_flag) return;
+    const double now = platform::walltime();
+    phase_time[which] += now - phase_last;
+    phase_last = now;
+  }
+
   // TIP4P settings
   int typeH, typeO;    // atom types of TIP4P water H and O atoms
   double qdist;        // distance from O site to negative charge
@@ -109,24 +201,40 @@ class PPPS : public KSpace {
   //void adjust_gewald();
   //virtual double newton_raphson_f();
   //double derivf();
-  //double final_accuracy();
+  double final_accuracy();
 
   virtual void allocate();
   virtual void allocate_peratom();
   virtual void deallocate();
   virtual void deallocate_peratom();
   int factorable(int);
-  //virtual double compute_df_kspace();
+  int compute_grid();
+  void select_order();
+  double estimated_cost();
+  virtual double compute_df_kspace();
   //virtual double estimate_ik_error(double, double, bigint);
   virtual double compute_qopt();
   virtual void compute_gf_denom();
   virtual void compute_gf_ik();
   virtual void compute_gf_ad();
+  void compute_gf_1d(int);
+  void compute_gf();
+  void setup_gf(const double *);
+  void virial_coeff(int, double *, double *) const;
+  void rescale_gf();
+  void sum_sf_coeff(const double *);
   void compute_sf_precoeff();
+  std::vector<double> gf_cache_key();
+  int read_gf_cache();
+  void write_gf_cache();
 
   virtual void particle_map();
+  void sort_particles();
   virtual void make_rho();
+  void make_rho_tiles();
+  void setup_rho_cache(int);
   virtual void brick2fft();
+  void fft_density(FFT_SCALAR *, FFT_SCALAR *);
 
   virtual void poisson();
   virtual void poisson_ik();
@@ -141,7 +249,11 @@ class PPPS : public KSpace {
   void procs2grid2d(int, int, int, int *, int *);
   void compute_rho1d(const FFT_SCALAR &, const FFT_SCALAR &, const FFT_SCALAR &);
   void compute_drho1d(const FFT_SCALAR &, const FFT_SCALAR &, const FFT_SCALAR &);
+  void compute_split_coeff();
+  void compute_spread_coeff();
+  int spread_fit_supported(double, int);
   void compute_rho_coeff();
+  void compute_rho_table();
   virtual void slabcorr();
 
   // grid communication
@@ -151,14 +263,6 @@ class PPPS : public KSpace {
   void pack_reverse_grid(int, void *, int, int *) override;
   void unpack_reverse_grid(int, void *, int, int *) override;
 
-  // triclinic
-
-  int triclinic;    // domain settings, orthog or triclinic
-  void setup_triclinic();
-  void compute_gf_ik_triclinic();
-  void poisson_ik_triclinic();
-  void poisson_groups_triclinic();
-
   // group-group interactions
 
   virtual void allocate_groups();
@@ -192,72 +296,52 @@ class PPPS : public KSpace {
     double s = sx * sy * sz;
     return s * s;
   };
-  
 
-  inline double gf_denom_psw(const double &kx, const double &ky, const double &kz, const double &hx, const double &hy, const double &hz) const
+  // interpolate the weights of all stencil points from a lookup table
+  // offsets lie in [-1,1], the table has one extra row past 1
+
+  inline void lookup_rho1d(FFT_SCALAR *const *r1d, FFT_SCALAR *const *lookup,
+                           const FFT_SCALAR &dx, const FFT_SCALAR &dy,
+                           const FFT_SCALAR &dz) const
   {
-    double qx, qy, qz;
-    int nx, ny, nz;
-    double wx, wy, wz;
-    double denominator = 0.00;
-    for (nx = -5; nx <= 5; nx++) {
-      qx = kx + 2 * MY_PI * nx / hx;
-      double ph_2_kx_c = order * hx / 2.0 * fabs(qx) / spreading_select_c;
-      wx = 0.00;
-      if(ph_2_kx_c <= 1.00){
-        double Fourier_spreading_appx = Fourier_spreading_coeff[0];
-        double Fourier_spreading_r = 1.0;
-        for(int i=1; i<Fourier_spreading_order; i++){
-          Fourier_spreading_r *= ph_2_kx_c;
-          Fourier_spreading_appx += Fourier_spreading_coeff[i] * Fourier_spreading_r;
-        }
-        wx = order / 2.0 * Fourier_spreading_appx;
-        wx = wx * wx;
-      }
-
-      for (ny = -5; ny <= 5; ny++) {
-        qy = ky + 2 * MY_PI * ny / hy;
-        double ph_2_ky_c = order * hy / 2.0 * fabs(qy) / spreading_select_c;
-        wy = 0.00;
-        if(ph_2_ky_c <= 1.00){
-          double Fourier_spreading_appx = Fourier_spreading_coeff[0];
-          double Fourier_spreading_r = 1.0;
-          for(int i=1; i<Fourier_spreading_order; i++){
-            Fourier_spreading_r *= ph_2_ky_c;
-            Fourier_spreading_appx += Fourier_spreading_coeff[i] * Fourier_spreading_r;
-          }
-          wy = order / 2.0 * Fourier_spreading_appx;
-          wy = wy * wy;
-        }
-
-        for (nz = -5; nz <= 5; nz++) {
-            qz = kz + 2 * MY_PI * nz / hz;
-            double ph_2_kz_c = order * hz / 2.0 * fabs(qz) / spreading_select_c;
-            wz = 0.00;
-            if(ph_2_kz_c <= 1.00){
-              double Fourier_spreading_appx = Fourier_spreading_coeff[0];
-              double Fourier_spreading_r = 1.0;
-              for(int i=1; i<Fourier_spreading_order; i++){
-                Fourier_spreading_r *= ph_2_kz_c;
-                Fourier_spreading_appx += Fourier_spreading_coeff[i] * Fourier_spreading_r;
-              }
-              wz = order / 2.0 * Fourier_spreading_appx;
-              wz = wz * wz;
-            }
-            
-            if(fabs(nx) == 5 && ny == 0 && nz == 0 && (wx * wy * wz)>=1e-8)
-              printf("   margin == %f   ", wx * wy * wz);
-            denominator = denominator + wx * wy * wz; // could be zero when the spreading accuracy is low
-        }
-      }
+    const FFT_SCALAR d[3] = {dx, dy, dz};
+    const int klo = (1 - order) / 2;
+    for (int a = 0; a < 3; a++) {
+      const FFT_SCALAR t = (d[a] + 1.0) * rho_scale;
+      const int i = static_cast<int>(t);
+      const FFT_SCALAR frac = t - i;
+      const FFT_SCALAR *lo = lookup[i];
+      const FFT_SCALAR *hi = lookup[i + 1];
+      FFT_SCALAR *r = r1d[a] + klo;
+      for (int k = 0; k < order; k++) r[k] = lo[k] + frac * (hi[k] - lo[k]);
     }
+  }
 
-    //if(denominator == 0.00){
-     // printf("This is not allowed!");
-    //}
-    return denominator * denominator;
-};
+  // copy the spreading weights of spread atom i to or from rho_cache
+
+  inline void save_rho1d(const int i, FFT_SCALAR *const *r1d)
+  {
+    FFT_SCALAR *c = rho_cache + (bigint) 3 * order * i - nlower;
+    for (int a = 0; a < 3; a++, c += order)
+      for (int k = nlower; k <= nupper; k++) c[k] = r1d[a][k];
+  }
 
+  inline void load_rho1d(const int i, FFT_SCALAR *const *r1d) const
+  {
+    const FFT_SCALAR *c = rho_cache + (bigint) 3 * order * i - nlower;
+    for (int a = 0; a < 3; a++, c += order)
+      for (int k = nlower; k <= nupper; k++) r1d[a][k] = c[k];
+  }
+
+  // squared PSWF spreading window in Fourier space, arg = order*h*|k|/(2c)
+
+  inline double gf_window(const double arg) const
+  {
+    if (arg > 1.0) return 0.0;
+    const double w =
+        0.5 * order * PSWFPoly::poly(Fourier_spreading_coeff, Fourier_spreading_order, arg);
+    return w * w;
+  }
 };
 
 }    // namespace LAMMPS_NS
@@ -0,0 +1,273 @@
+// clang-format off
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+/* ----------------------------------------------------------------------
+   staggered (interlaced) version of PPPS, modeled after PPPMStagger
+   the charges are spread on two grids shifted by half a grid spacing
+     along each axis, and the forces, energies and virials of both
+     grids are averaged, which cancels the leading aliasing errors
+   the Green's function denominator and the error estimate of PPPS
+     average the two grids when stagger_flag is set
+------------------------------------------------------------------------- */
+
+#include "ppps_stagger.h"
+
+#include "atom.h"
+#include "domain.h"
+#include "error.h"
+#include "grid3d.h"
+#include "math_const.h"
+#include "memory.h"
+#include "timer.h"
+#include "update.h"
+
+using namespace LAMMPS_NS;
+using namespace MathConst;
+
+/* ---------------------------------------------------------------------- */
+
+PPPSStagger::PPPSStagger(LAMMPS *lmp) : PPPS(lmp)
+{
+  stagger_flag = 1;
+  group_group_enable = 0;
+
+  nstagger = 2;
+  stagger = 0.0;
+}
+
+/* ----------------------------------------------------------------------
+   called once before run
+------------------------------------------------------------------------- */
+
+void PPPSStagger::init()
+{
+  // error check
+
+  if (domain->triclinic)
+    error->all(FLERR,"Cannot (yet) use kspace_style ppps/stagger "
+               "with triclinic systems");
+
+  PPPS::init();
+}
+
+/* ----------------------------------------------------------------------
+   compute the PPPS long-range force, energy, virial
+------------------------------------------------------------------------- */
+
+void PPPSStagger::compute(int eflag, int vflag)
+{
+  int i,j;
+
+  // set energy/virial flags
+  // invoke allocate_peratom() if needed for first time
+
+  ev_init(eflag,vflag);
+
+  if (evflag_atom && !peratom_allocate_flag) allocate_peratom();
+
+  // if atom count has changed, update qsum and qsqsum
+
+  if (atom->natoms != natoms_original) {
+    qsum_qsq();
+    natoms_original = atom->natoms;
+  }
+
+  // return if there are no charges
+
+  if (qsqsum == 0.0) return;
+
+  // time the phases with the normal Timer level, see PPPS::compute()
+
+  phase_flag = timer->has_normal();
+  if (update->ntimestep == update->firststep) {
+    for (i = 0; i < NPHASE; i++) phase_time[i] = 0.0;
+    phase_flag = 0;
+  }
+  if (phase_flag) phase_last = platform::walltime();
+
+  // extend size of per-atom arrays if necessary
+
+  if (atom->nmax > nmax) {
+    memory->destroy(part2grid);
+    nmax = atom->nmax;
+    memory->create(part2grid,nmax,3,"pppm:part2grid");
+  }
+
+  // each grid contributes 1/nstagger of the forces
+
+  const double scale_all = scale;
+  scale /= nstagger;
+
+  stagger = 0.0;
+  for (int n = 0; n < nstagger; n++) {
+
+    // shifting the atoms by +stagger grid spacings is the same as
+    //   shifting the origin the particle <-> grid mapping uses by -stagger
+
+    boxlo_stagger[0] = domain->boxlo[0] - stagger/delxinv;
+    boxlo_stagger[1] = domain->boxlo[1] - stagger/delyinv;
+    boxlo_stagger[2] = domain->boxlo[2] - stagger/delzinv;
+    boxlo = boxlo_stagger;
+
+    // the ad self force oscillates with the grid, its first harmonic
+    //   changes sign on a grid shifted by half a spacing
+
+    if (differentiation_flag == 1 && n % 2) {
+      sf_coeff[0] = -sf_coeff[0];
+      sf_coeff[2] = -sf_coeff[2];
+      sf_coeff[4] = -sf_coeff[4];
+    }
+
+    // find grid points for all my particles
+    // map my particle charge onto my local 3d density grid
+
+    particle_map();
+    phase_stamp(PHASE_MAP);
+    make_rho();
+    phase_stamp(PHASE_RHO);
+
+    // all procs communicate density values from their ghost cells
+    //   to fully sum contribution in their 3d bricks
+    // remap from 3d decomposition to FFT decomposition
+
+    gc->reverse_comm(Grid3d::KSPACE,this,REVERSE_RHO,1,sizeof(FFT_SCALAR),
+                     gc_buf1,gc_buf2,MPI_FFT_SCALAR);
+    phase_stamp(PHASE_REVCOMM);
+    brick2fft();
+    phase_stamp(PHASE_REMAP);
+
+    // compute potential gradient on my FFT grid and
+    //   portion of e_long on this proc's FFT grid
+    // return gradients (electric fields) in 3d brick decomposition
+    // also performs per-atom calculations via poisson_peratom()
+
+    poisson();
+    phase_stamp(PHASE_IFFT);
+
+    // all procs communicate E-field values
+    // to fill ghost cells surrounding their 3d bricks
+
+    if (differentiation_flag == 1)
+      gc->forward_comm(Grid3d::KSPACE,this,FORWARD_AD,1,sizeof(FFT_SCALAR),
+                       gc_buf1,gc_buf2,MPI_FFT_SCALAR);
+    else
+      gc->forward_comm(Grid3d::KSPACE,this,FORWARD_IK,3,sizeof(FFT_SCALAR),
+                       gc_buf1,gc_buf2,MPI_FFT_SCALAR);
+
+    // extra per-atom energy/virial communication
+
+    if (evflag_atom) {
+      if (differentiation_flag == 1 && vflag_atom)
+        gc->forward_comm(Grid3d::KSPACE,this,FORWARD_AD_PERATOM,6,sizeof(FFT_SCALAR),
+                         gc_buf1,gc_buf2,MPI_FFT_SCALAR);
+      else if (differentiation_flag == 0)
+        gc->forward_comm(Grid3d::KSPACE,this,FORWARD_IK_PERATOM,7,sizeof(FFT_SCALAR),
+                         gc_buf1,gc_buf2,MPI_FFT_SCALAR);
+    }
+    phase_stamp(PHASE_FWDCOMM);
+
+    // calculate the force on my particles
+
+    fieldforce();
+
+    // extra per-atom energy/virial communication
+
+    if (evflag_atom) fieldforce_peratom();
+    phase_stamp(PHASE_FIELD);
+
+    if (differentiation_flag == 1 && n % 2) {
+      sf_coeff[0] = -sf_coeff[0];
+      sf_coeff[2] = -sf_coeff[2];
+      sf_coeff[4] = -sf_coeff[4];
+    }
+
+    stagger += 1.0/nstagger;
+  }
+
+  scale = scale_all;
+  boxlo = domain->boxlo;
+
+  // sum global energy across procs and add in volume-dependent term
+
+  const double qscale = qqrd2e * scale;
+
+  if (eflag_global) {
+    double energy_all;
+    MPI_Allreduce(&energy,&energy_all,1,MPI_DOUBLE,MPI_SUM,world);
+    energy = energy_all;
+
+    energy *= 0.5*volume/nstagger;
+    energy -= (self_coeff/cutoff) * qsqsum / 2.0;
+    energy *= qscale;
+  }
+
+  // sum global virial across procs
+
+  if (vflag_global) {
+    double virial_all[6];
+    MPI_Allreduce(virial,virial_all,6,MPI_DOUBLE,MPI_SUM,world);
+    for (i = 0; i < 6; i++) virial[i] = 0.5*qscale*volume*virial_all[i]/nstagger;
+  }
+
+  // per-atom energy/virial
+  // energy includes self-energy correction
+
+  if (evflag_atom) {
+    double *q = atom->q;
+    int nlocal = atom->nlocal;
+
+    if (eflag_atom) {
+      for (i = 0; i < nlocal; i++) {
+        eatom[i] *= 0.5/nstagger;
+        eatom[i] -= (self_coeff/cutoff) * q[i]*q[i] / 2.0;
+        eatom[i] *= qscale;
+      }
+    }
+
+    if (vflag_atom) {
+      for (i = 0; i < nlocal; i++)
+        for (j = 0; j < 6; j++) vatom[i][j] *= 0.5*qscale/nstagger;
+    }
+  }
+
+  // 2d slab correction
+
+  if (slabflag == 1) slabcorr();
+}
+
+/* ----------------------------------------------------------------------
+   perform and time the 1d FFTs required for N timesteps
+------------------------------------------------------------------------- */
+
+int PPPSStagger::timing_1d(int n, double &time1d)
+{
+  PPPS::timing_1d(n,time1d);
+  time1d *= nstagger;
+
+  if (differentiation_flag) return 2;
+  return 4;
+}
+
+/* ----------------------------------------------------------------------
+   perform and time the 3d FFTs required for N timesteps
+------------------------------------------------------------------------- */
+
+int PPPSStagger::timing_3d(int n, double &time3d)
+{
+  PPPS::timing_3d(n,time3d);
+  time3d *= nstagger;
+
+  if (differentiation_flag) return 2;
+  return 4;
+}
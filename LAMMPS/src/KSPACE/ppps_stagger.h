@@ -0,0 +1,44 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef KSPACE_CLASS
+// clang-format off
+KSpaceStyle(ppps/stagger,PPPSStagger);
+// clang-format on
+#else
+
+#ifndef LMP_PPPS_STAGGER_H
+#define LMP_PPPS_STAGGER_H
+
+#include "ppps.h"
+
+namespace LAMMPS_NS {
+
+class PPPSStagger : public PPPS {
+ public:
+  PPPSStagger(class LAMMPS *);
+  void init() override;
+  void compute(int, int) override;
+  int timing_1d(int, double &) override;
+  int timing_3d(int, double &) override;
+
+ protected:
+  int nstagger;
+  double stagger;
+  double boxlo_stagger[3];    // box origin shifted by -stagger grid spacings
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
+#endif
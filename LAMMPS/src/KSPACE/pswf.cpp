@@ -8,6 +8,10 @@
 #include <iomanip>
 #include <iostream>
 #include <limits>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <tuple>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -314,43 +318,44 @@ static inline void gaussian_quadrature(int n, double* nodes, double* weights) {
     static std::vector<std::vector<double>> precomp_nodes(1000);
     static std::vector<std::vector<double>> precomp_weights(1000);
 
+    // the lock also covers the copy below, vectors may be filled concurrently
+    static std::mutex precomp_mutex;
+    std::lock_guard<std::mutex> lock(precomp_mutex);
+
     {  // Precompute
         assert(n < precomp_nodes.size() && n < precomp_weights.size());
         if (precomp_nodes[n].size() == 0 && precomp_weights[n].size() == 0) {
-#pragma omp critical(GAUSS_QUAD)
-            if (precomp_nodes[n].size() == 0 && precomp_weights[n].size() == 0) {
-                std::vector<double> nodes1(n);
-                std::vector<double> weights1(n);
-
-                if (true) {  // usr original code
-                    legerts(1, n, nodes1.data(), weights1.data());
-                } else {  // self implementation test code
-                    const double tolerance = 1e-16;
-                    const int max_iterations = 100;
-                    for (int i = 0; i < (n + 1) / 2; ++i) {
-                        double x = std::cos(my_pi * (i + 0.75) / (n + 0.5));
-                        double pn, pn_prime;
-
-                        for (int iter = 0; iter < max_iterations; ++iter) {
-                            legendre(n, x, pn, pn_prime);
-                            double delta_x = -pn / pn_prime;
-                            x += delta_x;
-
-                            if (std::abs(delta_x) < tolerance) {
-                                break;
-                            }
+            std::vector<double> nodes1(n);
+            std::vector<double> weights1(n);
+
+            if (true) {  // usr original code
+                legerts(1, n, nodes1.data(), weights1.data());
+            } else {  // self implementation test code
+                const double tolerance = 1e-16;
+                const int max_iterations = 100;
+                for (int i = 0; i < (n + 1) / 2; ++i) {
+                    double x = std::cos(my_pi * (i + 0.75) / (n + 0.5));
+                    double pn, pn_prime;
+
+                    for (int iter = 0; iter < max_iterations; ++iter) {
+                        legendre(n, x, pn, pn_prime);
+                        double delta_x = -pn / pn_prime;
+                        x += delta_x;
+
+                        if (std::abs(delta_x) < tolerance) {
+                            break;
                         }
-
-                        nodes1[i] = x;
-                        nodes1[n - 1 - i] = -x;
-                        weights1[i] = 2.0 / ((1.0 - x * x) * pn_prime * pn_prime);
-                        weights1[n - 1 - i] = weights1[i];
                     }
-                }
 
-                precomp_nodes[n].swap(nodes1);
-                precomp_weights[n].swap(weights1);
+                    nodes1[i] = x;
+                    nodes1[n - 1 - i] = -x;
+                    weights1[i] = 2.0 / ((1.0 - x * x) * pn_prime * pn_prime);
+                    weights1[n - 1 - i] = weights1[i];
+                }
             }
+
+            precomp_nodes[n].swap(nodes1);
+            precomp_weights[n].swap(weights1);
         }
     }
 
@@ -498,18 +503,75 @@ static inline void cheb_nodes_1d(int order, std::vector<double>& nodes, double a
     }
 }
 
+/*
+Chebyshev polynomials T_{order-j-1} of the variable mapped from [a,b] to [-1,1],
+same layout as monomial_basis_1d
+*/
+static inline void chebyshev_basis_1d(int order, const std::vector<double>& x, std::vector<double>& y,
+                                      double a, double b) {
+    int n = x.size();
+    if (y.size() != (size_t) order * n) y.resize((size_t) order * n);
+
+    for (Long i = 0; i < n; i++) {
+        double s = (2 * x[i] - a - b) / (b - a);
+        double t0 = 1.0, t1 = s;
+        for (int k = 0; k < order; k++) {
+            y[(order - k - 1) * n + i] = t0;
+            double t2 = 2 * s * t1 - t0;
+            t0 = t1;
+            t1 = t2;
+        }
+    }
+}
+
+/*
+monomial coefficients (in powers of x) of the Chebyshev polynomials T_k((2x-a-b)/(b-a)),
+T[k * order + m] is the coefficient of x^m in T_k
+*/
+static inline void chebyshev_to_monomial_1d(int order, std::vector<double>& T, double a, double b) {
+    double alpha = 2 / (b - a);
+    double beta = -(a + b) / (b - a);
+    T.assign(order * order, 0.0);
+    T[0] = 1.0;
+    if (order == 1) return;
+    T[order + 0] = beta;
+    T[order + 1] = alpha;
+    for (int k = 2; k < order; k++) {
+        for (int m = 0; m <= k; m++) {
+            double val = -T[(k - 2) * order + m];
+            if (m < k) val += 2 * beta * T[(k - 1) * order + m];
+            if (m > 0) val += 2 * alpha * T[(k - 1) * order + m - 1];
+            T[k * order + m] = val;
+        }
+    }
+}
+
+/*
+least squares fit in the well conditioned Chebyshev basis, then convert
+to monomial coefficients; a direct fit against the monomial Vandermonde
+matrix loses most of its accuracy beyond ~15 terms
+*/
 static inline void monomial_interp_1d(int order, int nnodes, std::vector<double>& fn_v, std::vector<double>& coeff,
                                       double a = 0, double b = 1) {
-    std::vector<double> x, p, Mp(order * nnodes);
+    std::vector<double> x, p, Mp(order * nnodes), T;
     // monomial_nodes_1d(nnodes, x, a, b);
     cheb_nodes_1d(nnodes, x, a, b);
-    monomial_basis_1d(order, x, p);
-    // TODO: check solve in lsq sense, i.e., mul order matters (us)(v^t x)
+    chebyshev_basis_1d(order, x, p, a, b);
     pseudo_inv(p.data(), order, nnodes, std::numeric_limits<double>::epsilon(), Mp.data());
     Long dof  = fn_v.size() / nnodes;
     assert(fn_v.size() == dof * nnodes);
+    std::vector<double> cheb(dof * order);
+    gemm(order, dof, nnodes, fn_v.data(), Mp.data(), cheb.data());
+
+    chebyshev_to_monomial_1d(order, T, a, b);
     if (coeff.size() != dof * order) coeff.resize(dof * order);
-    gemm(order, dof, nnodes, fn_v.data(), Mp.data(), coeff.data());
+    for (Long d = 0; d < dof; d++) {
+        for (int m = 0; m < order; m++) {
+            double val = 0.0;
+            for (int k = m; k < order; k++) val += cheb[d * order + order - k - 1] * T[k * order + m];
+            coeff[d * order + order - m - 1] = val;
+        }
+    }
 }
 // end of monomial utils
 
@@ -551,6 +613,7 @@ void prolc180_der3(double eps, double& der3) {
         if (eps < 1.0e-18) eps = 1e-18;
         double d = -log10(eps);
         int i = static_cast<int>(d * 10 + 0.1);
+        i = std::min(std::max(i, 1), static_cast<int>(der3s.size()));
         der3 = der3s[i - 1];
 }
 
@@ -586,6 +649,7 @@ static inline void prolc180(double eps, double& c) {
     if (eps < 1.0e-18) eps = 1e-18;
     double d = -log10(eps);
     int i = static_cast<int>(d * 10 + 0.1);
+    i = std::min(std::max(i, 1), static_cast<int>(cs.size()));
     c = cs[i - 1];
 }
 
@@ -992,35 +1056,31 @@ static inline void prol0eva(double x, const double* w, double& psi0, double& der
     derpsi0 = sqrt(2.0) * derpsi0;
 }
 
-static inline void prol0int0r(const double* w, double r, double& val) {
-    static int npts = 200;
-    static int itype = 1;
-    double derpsi0;
-    static std::vector<double> xs(npts, 0), ws(npts, 0), fvals(npts, 0);
-    static int need_init = 1;
-    std::vector<std::vector<double>> u;
-    std::vector<std::vector<double>> v;
+/*
+Gauss-Legendre nodes and weights on [-1,1] for int_0^r psi0(x) dx; they are
+built on first use, which C++11 guarantees to happen exactly once
+*/
+struct Prol0IntQuad {
+    static constexpr int npts = 200;
+    std::vector<double> xs, ws;
 
-    // since xs, ws, fval of size 200 are static
-    // only need to get nodes and weights once
-    if (need_init) {
-#pragma omp critical(PROL0INT0R)
-        if (need_init) {
-            legeexps(itype, npts, xs.data(), u, v, ws.data());
-            need_init = 0;
-        }
+    Prol0IntQuad() : xs(npts, 0), ws(npts, 0) {
+        std::vector<std::vector<double>> u;
+        std::vector<std::vector<double>> v;
+        legeexps(1, npts, xs.data(), u, v, ws.data());
     }
+};
 
-    // Scale the nodes and weights to [0, r]
-    double xs_r;
-    for (int i = 0; i < npts; ++i) {
-        xs_r = (xs[i] + 1) * r / 2;
-        prol0eva(xs_r, w, fvals[i], derpsi0);
-    }
+static inline void prol0int0r(const double* w, double r, double& val) {
+    static const Prol0IntQuad quad;
+    double fval, derpsi0;
 
+    // Scale the nodes and weights to [0, r]
     val = 0;
-    for (int i = 0; i < npts; ++i) {
-        val += ws[i] * r / 2 * fvals[i];
+    for (int i = 0; i < Prol0IntQuad::npts; ++i) {
+        double xs_r = (quad.xs[i] + 1) * r / 2;
+        prol0eva(xs_r, w, fval, derpsi0);
+        val += quad.ws[i] * r / 2 * fval;
     }
 }
 
@@ -1039,8 +1099,6 @@ struct Prolate0Fun {
     inline std::pair<double, double> eval_val_derivative(double x) const {
         double psi0, derpsi0;
         prol0eva(x, workarray.data(), psi0, derpsi0);
-        // prol0eva_(&x, workarray.data(), &psi0, &derpsi0);
-        // std::pair<double, double> psi0_derpsi0{psi0, derpsi0};
         return {psi0, derpsi0};
     }
 
@@ -1060,237 +1118,327 @@ struct Prolate0Fun {
     inline double int_eval(double r) const {
         double val;
         prol0int0r(workarray.data(), r, val);
-        // prol0int0r_(workarray.data(), &r, &val);
         return val;
     }
 
+    // values and, if der is not null, derivatives at n points
+    inline void eval(int n, const double* x, double* val, double* der) const {
+        double psi0, derpsi0;
+        for (int i = 0; i < n; i++) {
+            prol0eva(x[i], workarray.data(), psi0, derpsi0);
+            val[i] = psi0;
+            if (der) der[i] = derpsi0;
+        }
+    }
+
+    // int_0^r[i] prolate0(x) dx at n points
+    inline void int_eval(int n, const double* r, double* val) const {
+        for (int i = 0; i < n; i++) prol0int0r(workarray.data(), r[i], val[i]);
+    }
+
     double c;
     int lenw, keep, ltot;
     std::vector<double> workarray;
     double rlam20, rkhi;
 };
 
+/*
+shared registry of the prolate0c functions, one per c; lookup and
+initialization are serialized, evaluations through the returned reference
+can run concurrently since std::map never moves its elements
+*/
+static const Prolate0Fun& prolate0_fun(double c) {
+    static std::mutex registry_mutex;
+    static std::map<double, Prolate0Fun> registry;
+
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    auto it = registry.find(c);
+    if (it == registry.end()) {
+        #ifdef MYDEBUGPRINT
+        std::cout << "Creating new Prolate0Fun for c = " << c << std::endl;
+        #endif
+        it = registry.emplace(c, Prolate0Fun(c, 10000)).first;
+    }
+    return it->second;
+}
+
 /*
 evaluate prolate0c derivative at x, i.e., \psi_0^c(x)
 */
 double prolate0_eval_derivative(double c, double x) {
-    static std::unordered_map<double, Prolate0Fun> prolate0_funcs_cache;
-    if (prolate0_funcs_cache.find(c) == prolate0_funcs_cache.end()) {
-#pragma omp critical(PROLATE0_EVAL)
-        if (prolate0_funcs_cache.find(c) == prolate0_funcs_cache.end()) {
-            #ifdef MYDEBUGPRINT
-            std::cout << "Creating new eval Prolate0Fun derivative for c = " << c << std::endl;
-            #endif
-            prolate0_funcs_cache.emplace(c, Prolate0Fun(c, 10000));
-        }
-    }
-    return prolate0_funcs_cache[c].eval_derivative(x);
+    return prolate0_fun(c).eval_derivative(x);
 }
 
 /*
 evaluate prolate0c at x, i.e., \psi_0^c(x)
 */
 double prolate0_eval(double c, double x) {
-    static std::unordered_map<double, Prolate0Fun> prolate0_funcs_cache;
-    if (prolate0_funcs_cache.find(c) == prolate0_funcs_cache.end()) {
-#pragma omp critical(PROLATE0_EVAL)
-        if (prolate0_funcs_cache.find(c) == prolate0_funcs_cache.end()) {
-            #ifdef MYDEBUGPRINT
-            std::cout << "Creating new eval Prolate0Fun for c = " << c << std::endl;
-            #endif
-            prolate0_funcs_cache.emplace(c, Prolate0Fun(c, 10000));
-        }
-    }
-    return prolate0_funcs_cache[c].eval_val(x);
+    return prolate0_fun(c).eval_val(x);
 }
 
 /*
 evaluate prolate0c function integral of \int_0^r \psi_0^c(x) dx
 */
 double prolate0_int_eval(double c, double r) {
-    static std::unordered_map<double, Prolate0Fun> prolate0_funcs_cache;
-    if (prolate0_funcs_cache.find(c) == prolate0_funcs_cache.end()) {
-#pragma omp critical(PROLATE0_INT_EVAL)
-        if (prolate0_funcs_cache.find(c) == prolate0_funcs_cache.end()) {
-            #ifdef MYDEBUGPRINT
-            std::cout << "Creating new int_eval Prolate0Fun for c = " << c << std::endl;
-            #endif
-            prolate0_funcs_cache.emplace(c, Prolate0Fun(c, 10000));
-        }
-    }
-    return prolate0_funcs_cache[c].int_eval(r);
+    return prolate0_fun(c).int_eval(r);
+}
+
+void prolate0_eval(double c, int n, const double* x, double* val, double* der) {
+    prolate0_fun(c).eval(n, x, val, der);
+}
+
+void prolate0_int_eval(double c, int n, const double* r, double* val) {
+    prolate0_fun(c).int_eval(n, r, val);
 }
 // end of prolate functions
 
 // start of approximation functions
-void force_poly(double tol, int order, double &c, std::vector<double>& coeffs) {
-    prolc180(tol, c);
 
-    double c0 = prolate0_int_eval(c, 1.0);
-
-    auto f = [](double c0, double c, double x) {
-        double val = prolate0_int_eval(c, x) / c0 - x / c0 * prolate0_eval(c, x);
-        val = 1 - val;
-        return val;
-    };
+/*
+the fitted kernels at all points of x, with one registry lookup per call
+*/
+static inline std::vector<double> psi0_values(double c, const std::vector<double>& x) {
+    std::vector<double> psi(x.size());
+    prolate0_eval(c, x.size(), x.data(), psi.data());
+    return psi;
+}
 
-    std::vector<double> coeffs_tmp(order);
-    int nnodes = (int)order*1.75;
+static inline std::vector<double> force_kernel(double c0, double c, const std::vector<double>& x) {
+    std::vector<double> val(x.size()), psi = psi0_values(c, x);
+    prolate0_int_eval(c, x.size(), x.data(), val.data());
+    for (size_t i = 0; i < x.size(); i++) val[i] = 1 - (val[i] / c0 - x[i] / c0 * psi[i]);
+    return val;
+}
 
-    std::vector<double> nodes;
-    //monomial_nodes_1d(nnodes, nodes, 0, 1);
-    cheb_nodes_1d(nnodes, nodes, 0, 1);
-    std::vector<double> fn_v(nnodes);
-    for (int i = 0; i < nnodes; i++) {
-        fn_v[i] = f(c0, c, nodes[i]);
-    }
+static inline std::vector<double> energy_kernel(double c0, double c, const std::vector<double>& x) {
+    std::vector<double> val(x.size());
+    prolate0_int_eval(c, x.size(), x.data(), val.data());
+    for (size_t i = 0; i < x.size(); i++) val[i] = 1 - val[i] / c0;
+    return val;
+}
 
-    monomial_interp_1d(order, nnodes, fn_v, coeffs_tmp);
-    coeffs.resize(order, 0.0);
+static inline std::vector<double> fourier_kernel(double lambda, double c0, double c,
+                                                 const std::vector<double>& x) {
+    std::vector<double> val = psi0_values(c, x);
+    for (auto& v : val) v = lambda * v / c0;
+    return val;
+}
 
-    for (int i = 0; i < order; i++) {
-        coeffs[order - i - 1] = coeffs_tmp[i];
+/*
+Fourier scale of psi0, int_{-1}^{1} psi0(x) cos(c x/2) dx / psi0(1/2)
+*/
+static inline double fourier_lambda(double c) {
+    int quad_npts = 200;
+    std::vector<double> xs(quad_npts, 0), ws(quad_npts, 0);
+    gaussian_quadrature(quad_npts, xs.data(), ws.data());
+    std::vector<double> psi = psi0_values(c, xs);
+    double lambda = 0.0;
+    for (int i = 0; i < quad_npts; i++) {
+        lambda += ws[i] * psi[i] * std::cos(c * xs[i] * 0.5);
     }
+    return lambda / prolate0_eval(c, 0.5);
 }
 
-void energy_poly(double tol, int order, double &c, std::vector<double>& coeffs) {
-    prolc180(tol, c);
+/*
+uniform grid of [a,b] on which fit errors are measured
+*/
+static inline std::vector<double> fit_grid(double a = 0, double b = 1) {
+    const int npts = 256;
+    std::vector<double> x(npts + 1);
+    for (int k = 0; k <= npts; k++) x[k] = a + (b - a) * k / npts;
+    return x;
+}
 
-    double c0 = prolate0_int_eval(c, 1.0);
+/*
+maximum error of a monomial fit on the points x, accumulated into err
+together with the largest |f| into fmax; coeffs[j*P + i] is the x^j
+coefficient of function i, fx[i*nx + k] its value at x[k]
+*/
+static inline void fit_error(int P, int order, const double* coeffs, const std::vector<double>& x,
+                             const std::vector<double>& fx, double& err, double& fmax) {
+    const int nx = x.size();
+    for (int i = 0; i < P; i++) {
+        for (int k = 0; k < nx; k++) {
+            double val = coeffs[(order - 1) * P + i];
+            for (int j = order - 2; j >= 0; j--) val = val * x[k] + coeffs[j * P + i];
+            err = std::max(err, std::abs(val - fx[i * nx + k]));
+            fmax = std::max(fmax, std::abs(fx[i * nx + k]));
+        }
+    }
+}
 
-    auto f = [](double c0, double c, double x) {
-        double val = prolate0_int_eval(c, x) / c0;
-        val = 1 - val;
-        return val;
+/*
+fit the batch kernel f, which returns P values per point as fx[i*nx + k],
+on [a,b] with npieces polynomials of order monomial terms each; piece s
+covers [a + s*h, a + (s+1)*h], h = (b-a)/npieces, and is a polynomial in a
+local variable t in [a,b] mapped linearly onto it, so a single piece is the
+global fit; coeffs[(s*order + j)*P + i] is the t^j coefficient of function i
+in piece s; return the maximum fit error relative to max |f|
+*/
+template <typename F>
+static inline double fit_pieces(int P, int order, int npieces, double a, double b,
+                                std::vector<double>& coeffs, F f) {
+    const double h = (b - a) / npieces;
+    auto piece = [&](const std::vector<double>& t, int s) {
+        if (npieces == 1) return t;
+        std::vector<double> x(t.size());
+        for (size_t k = 0; k < t.size(); k++) x[k] = a + (s + (t[k] - a) / (b - a)) * h;
+        return x;
     };
 
-    std::vector<double> coeffs_tmp(order);
     int nnodes = (int)order*1.75;
-
-    std::vector<double> nodes;
-    //monomial_nodes_1d(nnodes, nodes, 0, 1);
-    cheb_nodes_1d(nnodes, nodes, 0, 1);
-    std::vector<double> fn_v(nnodes);
-    for (int i = 0; i < nnodes; i++) {
-        fn_v[i] = f(c0, c, nodes[i]);
+    std::vector<double> nodes, coeffs_tmp(P * order);
+    //monomial_nodes_1d(nnodes, nodes, a, b);
+    cheb_nodes_1d(nnodes, nodes, a, b);
+    std::vector<double> x = fit_grid(a, b);
+
+    coeffs.assign(npieces * order * P, 0.0);
+    double err = 0.0, fmax = 0.0;
+    for (int s = 0; s < npieces; s++) {
+        std::vector<double> fn_v = f(piece(nodes, s));
+        monomial_interp_1d(order, nnodes, fn_v, coeffs_tmp, a, b);
+
+        double* cs = coeffs.data() + s * order * P;
+        for (int i = 0; i < P; i++) {
+            for (int j = 0; j < order; j++) {
+                cs[j * P + i] = coeffs_tmp[i * order + order - j - 1];
+            }
+        }
+        fit_error(P, order, cs, x, f(piece(x, s)), err, fmax);
     }
+    return (fmax > 0.0) ? err / fmax : err;
+}
 
-    monomial_interp_1d(order, nnodes, fn_v, coeffs_tmp);
-    coeffs.resize(order, 0.0);
-
-    for (int i = 0; i < order; i++) {
-        coeffs[order - i - 1] = coeffs_tmp[i];
-    }
+/*
+fit the batch kernel f on [0,1] with order monomial terms, return the relative fit error
+*/
+template <typename F>
+static inline double fit_poly(int order, std::vector<double>& coeffs, F f, int npieces = 1) {
+    return fit_pieces(1, order, npieces, 0, 1, coeffs, f);
 }
 
-void fourier_poly(double tol, int order, double &c, double &lambda, std::vector<double>& coeffs) {
+double force_poly(double tol, int order, double &c, std::vector<double>& coeffs, int npieces) {
     prolc180(tol, c);
 
     double c0 = prolate0_int_eval(c, 1.0);
 
-    int quad_npts = 200;
-    std::vector<double> xs(quad_npts, 0), ws(quad_npts, 0);
-    gaussian_quadrature(quad_npts, xs.data(), ws.data());
-    lambda = 0.0;
-    for (int i = 0; i < quad_npts; i++) {
-        lambda += ws[i] * prolate0_eval(c, xs[i]) * std::cos(c * xs[i] * 0.5);
-    }
-    lambda /= prolate0_eval(c, 0.5);
-
-    auto f = [](double lambda, double c0, double c, double x) {
-        double val = lambda * prolate0_eval(c, x) / c0;
-        return val;
-    };
-
-    std::vector<double> coeffs_tmp(order);
-    int nnodes = (int)order*1.75;
+    return fit_poly(order, coeffs, [&](const std::vector<double>& x) { return force_kernel(c0, c, x); },
+                    npieces);
+}
 
-    std::vector<double> nodes;
-    //monomial_nodes_1d(nnodes, nodes, 0, 1);
-    cheb_nodes_1d(nnodes, nodes, 0, 1);
-    std::vector<double> fn_v(nnodes);
-    for (int i = 0; i < nnodes; i++) {
-        fn_v[i] = f(lambda, c0, c, nodes[i]);
-    }
+double energy_poly(double tol, int order, double &c, std::vector<double>& coeffs, int npieces) {
+    prolc180(tol, c);
 
-    monomial_interp_1d(order, nnodes, fn_v, coeffs_tmp);
-    coeffs.resize(order, 0.0);
+    double c0 = prolate0_int_eval(c, 1.0);
 
-    for (int i = 0; i < order; i++) {
-        coeffs[order - i - 1] = coeffs_tmp[i];
-    }
+    return fit_poly(order, coeffs, [&](const std::vector<double>& x) { return energy_kernel(c0, c, x); },
+                    npieces);
 }
 
-void spread_fourier_poly(double tol, int order, double &c, double &lambda, std::vector<double>& coeffs) {
+double fourier_poly(double tol, int order, double &c, double &lambda, std::vector<double>& coeffs) {
     prolc180(tol, c);
 
     double c0 = prolate0_int_eval(c, 1.0);
+    lambda = fourier_lambda(c);
 
-    int quad_npts = 200;
-    std::vector<double> xs(quad_npts, 0), ws(quad_npts, 0);
-    gaussian_quadrature(quad_npts, xs.data(), ws.data());
-    lambda = 0.0;
-    for (int i = 0; i < quad_npts; i++) {
-        lambda += ws[i] * prolate0_eval(c, xs[i]) * std::cos(c * xs[i] * 0.5);
-    }
-    lambda /= prolate0_eval(c, 0.5);
-
-    auto f = [](double lambda, double c0, double c, double x) {
-        double val = lambda * prolate0_eval(c, x);
-        return val;
-    };
-
-    std::vector<double> coeffs_tmp(order);
-    int nnodes = (int)order*1.75;
+    return fit_poly(order, coeffs, [&](const std::vector<double>& x) {
+        return fourier_kernel(lambda, c0, c, x);
+    });
+}
 
-    std::vector<double> nodes;
-    //monomial_nodes_1d(nnodes, nodes, 0, 1);
-    cheb_nodes_1d(nnodes, nodes, 0, 1);
-    std::vector<double> fn_v(nnodes);
-    for (int i = 0; i < nnodes; i++) {
-        fn_v[i] = f(lambda, c0, c, nodes[i]);
-    }
+double spread_fourier_poly(double tol, int order, double &c, double &lambda, std::vector<double>& coeffs) {
+    prolc180(tol, c);
 
-    monomial_interp_1d(order, nnodes, fn_v, coeffs_tmp);
-    coeffs.resize(order, 0.0);
+    lambda = fourier_lambda(c);
 
-    for (int i = 0; i < order; i++) {
-        coeffs[order - i - 1] = coeffs_tmp[i];
-    }
+    return fit_poly(order, coeffs, [&](const std::vector<double>& x) {
+        return fourier_kernel(lambda, 1.0, c, x);
+    });
 }
 
-void spread_real_poly(int P, double tol, int order, double& c, std::vector<double>& coeffs) {
+double spread_real_poly(int P, double tol, int order, double& c, std::vector<double>& coeffs,
+                        int npieces) {
     prolc180(tol, c);
 
-    std::vector<double> nodes;
-    int nnodes = (int)order*1.75;
-    //monomial_nodes_1d(nnodes, nodes, -0.5, 0.5);
-    cheb_nodes_1d(nnodes, nodes, -0.5, 0.5);
-
-    auto f = [](int P, int i, double c, double x) {
-        double arg = x - P / 2.0 + i + 0.5;
-        arg /= P / 2.0;
-        double val = prolate0_eval(c, arg);
-        return val;
+    // psi0 seen by the P stencil points at offsets x, f[iP*nx + k] for x[k]
+    auto f = [&](const std::vector<double>& x) {
+        const int nx = x.size();
+        std::vector<double> arg(P * nx);
+        for (int iP = 0; iP < P; iP++) {
+            for (int k = 0; k < nx; k++) {
+                arg[iP * nx + k] = x[k] - P / 2.0 + iP + 0.5;
+                arg[iP * nx + k] /= P / 2.0;
+            }
+        }
+        return psi0_values(c, arg);
     };
 
-    std::vector<double> fn_v(P * nnodes);
-    for (int iP = 0; iP < P; iP++) {
-        for (int i = 0; i < nnodes; i++) {
-            fn_v[iP * nnodes + i] = f(P, iP, c, nodes[i]);
+    return fit_pieces(P, order, npieces, -0.5, 0.5, coeffs, f);
+}
+
+/*
+fit with increasing number of terms until the relative fit error drops below
+fit_tol; if max_terms is reached first, keep the most accurate fit
+*/
+template <typename Fit>
+static inline double adaptive_fit(double fit_tol, int max_terms, std::vector<double>& coeffs, Fit fit) {
+    std::vector<double> trial;
+    double best = std::numeric_limits<double>::max();
+    for (int n = 2; n <= max_terms; n++) {
+        double err = fit(n, trial);
+        if (err < best) {
+            best = err;
+            coeffs.swap(trial);
         }
+        if (err <= fit_tol) break;
     }
+    return best;
+}
 
-    std::vector<double> coeffs_tmp(P * order);
-    monomial_interp_1d(order, nnodes, fn_v, coeffs_tmp, -0.5, 0.5);
+const PSWFSplittingCoeffs& splitting_coeffs(double tol, double fit_tol, int max_terms, int npieces) {
+    static std::mutex cache_mutex;
+    static std::map<std::pair<double, int>, PSWFSplittingCoeffs> cache;
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    auto key = std::make_pair(tol, npieces);
+    auto it = cache.find(key);
+    if (it != cache.end()) return it->second;
+
+    PSWFSplittingCoeffs s;
+    s.pieces = npieces;
+    double err_f = adaptive_fit(fit_tol, max_terms, s.force, [&](int n, std::vector<double>& v) {
+        return force_poly(tol, n, s.c, v, npieces);
+    });
+    double err_e = adaptive_fit(fit_tol, max_terms, s.energy, [&](int n, std::vector<double>& v) {
+        return energy_poly(tol, n, s.c, v, npieces);
+    });
+    double err_k = adaptive_fit(fit_tol, max_terms, s.fourier, [&](int n, std::vector<double>& v) {
+        return fourier_poly(tol, n, s.c, s.lambda, v);
+    });
+    s.err = std::max(err_f, std::max(err_e, err_k));
+    s.self = prolate0_eval(s.c, 0.0) / prolate0_int_eval(s.c, 1.0);
+    return cache.emplace(key, s).first->second;
+}
 
-    coeffs.resize(P * order, 0.0);
-    // copy coeffs_tmp to coeffs
-    for (int i = 0; i < P; i++) {
-        for (int j = 0; j < order; j++) {
-            coeffs[j*P + i] = coeffs_tmp[i*order + order - j - 1];
-        }
-    }
+const PSWFSpreadingCoeffs& spreading_coeffs(double tol, int P, double fit_tol, int max_terms,
+                                            int npieces) {
+    static std::mutex cache_mutex;
+    static std::map<std::tuple<double, int, int>, PSWFSpreadingCoeffs> cache;
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    auto key = std::make_tuple(tol, P, npieces);
+    auto it = cache.find(key);
+    if (it != cache.end()) return it->second;
+
+    PSWFSpreadingCoeffs s;
+    s.pieces = npieces;
+    double err_r = adaptive_fit(fit_tol, max_terms, s.real, [&](int n, std::vector<double>& v) {
+        return spread_real_poly(P, tol, n, s.c, v, npieces);
+    });
+    double err_k = adaptive_fit(fit_tol, max_terms, s.fourier, [&](int n, std::vector<double>& v) {
+        return spread_fourier_poly(tol, n, s.c, s.lambda, v);
+    });
+    s.nterms = s.real.size() / (P * npieces);
+    s.err = std::max(err_r, err_k);
+    return cache.emplace(key, s).first->second;
 }
 /*
 // test to generate coefficients
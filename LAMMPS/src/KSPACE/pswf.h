@@ -34,10 +34,54 @@ evaluate prolate0c function integral of \int_0^r \psi_0^c(x) dx
 */
 double prolate0_int_eval(double c, double r);
 
-// approximation functions
-void force_poly(double tol, int order, double &c, std::vector<double>& coeffs);
-void energy_poly(double tol, int order, double &c, std::vector<double>& coeffs);
-void fourier_poly(double tol, int order, double &c, double &lambda, std::vector<double>& coeffs);
-void spread_fourier_poly(double tol, int order, double &c, double &lambda, std::vector<double>& coeffs);
-void spread_real_poly(int P, double tol, int order, double& c, std::vector<double>& coeffs);
+/*
+batch versions for n points; the prolate0c function of each c is initialized
+once in a shared registry, and all prolate0 evaluations are thread-safe
+*/
+void prolate0_eval(double c, int n, const double* x, double* val, double* der = nullptr);
+void prolate0_int_eval(double c, int n, const double* r, double* val);
+
+// approximation functions, return the maximum fit error relative to max |f|
+// with npieces > 1 the real space kernels are fitted piecewise, see PSWFSplittingCoeffs
+double force_poly(double tol, int order, double &c, std::vector<double>& coeffs, int npieces = 1);
+double energy_poly(double tol, int order, double &c, std::vector<double>& coeffs, int npieces = 1);
+double fourier_poly(double tol, int order, double &c, double &lambda, std::vector<double>& coeffs);
+double spread_fourier_poly(double tol, int order, double &c, double &lambda, std::vector<double>& coeffs);
+double spread_real_poly(int P, double tol, int order, double& c, std::vector<double>& coeffs,
+                        int npieces = 1);
+
+/*
+coefficients with the number of terms chosen as the smallest one with a
+relative fit error below fit_tol (at most max_terms); results are cached
+per tolerance, number of pieces and, for spreading, per number of stencil
+points P, and the caches may be used from several threads
+
+the real space kernels may be split into npieces equal subintervals with
+one lower degree polynomial each; piece s of the splitting kernels covers
+x in [s,s+1]/npieces and is a polynomial in t = x*npieces - s, piece s of
+the spreading kernels covers dx + 1/2 in [s,s+1]/npieces and is a
+polynomial in t = (dx + 1/2)*npieces - s - 1/2; the Fourier space kernels
+are always global polynomials
+*/
+struct PSWFSplittingCoeffs {
+    double c, lambda, err;
+    double self;                 // -d/dx of the energy kernel at 0, for the self energy
+    int pieces;                  // number of pieces of the force and energy kernels
+    std::vector<double> force, energy;   // force[s*n + j] is the t^j coefficient of piece s
+    std::vector<double> fourier;
+};
+
+struct PSWFSpreadingCoeffs {
+    double c, lambda, err;
+    int nterms;                  // number of terms of each real space polynomial
+    int pieces;                  // number of pieces of the real space polynomials
+    std::vector<double> real;    // real[(s*nterms + j)*P + i] is the t^j coefficient of
+                                 //   stencil point i in piece s
+    std::vector<double> fourier;
+};
+
+const PSWFSplittingCoeffs& splitting_coeffs(double tol, double fit_tol, int max_terms,
+                                            int npieces = 1);
+const PSWFSpreadingCoeffs& spreading_coeffs(double tol, int P, double fit_tol, int max_terms,
+                                            int npieces = 1);
 #endif  // MATH_PSWF_H
@@ -0,0 +1,48 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef PAIR_CLASS
+// clang-format off
+PairStyle(lj/cut/tip4p/ps/omp,PairLJCutTIP4PPsOMP);
+// clang-format on
+#else
+
+#ifndef LMP_PAIR_LJ_CUT_TIP4P_PS_OMP_H
+#define LMP_PAIR_LJ_CUT_TIP4P_PS_OMP_H
+
+#include "pair_lj_cut_tip4p_ps.h"
+#include "thr_omp.h"
+
+namespace LAMMPS_NS {
+
+class PairLJCutTIP4PPsOMP : public PairLJCutTIP4PPs, public ThrOMP {
+
+ public:
+  PairLJCutTIP4PPsOMP(class LAMMPS *);
+  ~PairLJCutTIP4PPsOMP() override;
+
+  void compute(int, int) override;
+  double memory_usage() override;
+
+ private:
+  dbl3_t *newsite_thr;
+  int3_t *hneigh_thr;
+
+  template <int, int, int, int> void eval(int, int, ThrData *const);
+  void compute_newsite_thr(const dbl3_t &, const dbl3_t &, const dbl3_t &, dbl3_t &) const;
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
+#endif
@@ -38,6 +38,8 @@ action pair_lj_charmm_coul_long_opt.cpp pair_lj_charmm_coul_long.cpp
 action pair_lj_charmm_coul_long_opt.h pair_lj_charmm_coul_long.cpp
 action pair_lj_cut_coul_long_opt.cpp pair_lj_cut_coul_long.cpp
 action pair_lj_cut_coul_long_opt.h pair_lj_cut_coul_long.cpp
+action pair_lj_cut_coul_ps_opt.cpp pair_lj_cut_coul_ps.cpp
+action pair_lj_cut_coul_ps_opt.h pair_lj_cut_coul_ps.cpp
 action pair_lj_cut_opt.cpp
 action pair_lj_cut_opt.h
 action pair_lj_cut_tip4p_long_opt.cpp pair_lj_cut_tip4p_long.cpp
@@ -48,6 +48,9 @@ using namespace LAMMPS_NS;
 static void mpi_timings(const char *label, Timer *t, enum Timer::ttype tt,
                         MPI_Comm world, const int nprocs, const int nthreads,
                         const int me, double time_loop, FILE *scr, FILE *log);
+static void phase_timings(const char *label, double time, double time_kspace,
+                          MPI_Comm world, const int nprocs, const int me,
+                          FILE *scr, FILE *log);
 
 #ifdef LMP_OPENMP
 static void omp_times(FixOMP *fix, const char *label, enum Timer::ttype which,
@@ -355,6 +358,40 @@ void Finish::end(int flag)
         utils::logmesg(lmp,"Other   |            | {:<10.4g} |            |  "
                        "     |{:6.2f}\n",time,time/time_loop*100.0);
     }
+
+    // phases of the kspace solver, if it times them
+
+    const char *const *phase_names = nullptr;
+    const double *phase_time = nullptr;
+    int nphase = 0;
+    if (force->kspace) nphase = force->kspace->timing_phases(phase_names,phase_time);
+
+    if (nphase > 0) {
+      double time_kspace = timer->get_wall(Timer::KSPACE);
+      MPI_Allreduce(&time_kspace,&tmp,1,MPI_DOUBLE,MPI_SUM,world);
+      time_kspace = tmp/nprocs;
+
+      if (me == 0)
+        utils::logmesg(lmp,"\nKspace phase timing breakdown:\nPhase   |  min time "
+                       " |  avg time  |  max time  |%varavg|%kspace\n---------"
+                       "------------------------------------------------------\n");
+
+      double time_phases = 0.0;
+      for (i = 0; i < nphase; i++) {
+        phase_timings(phase_names[i],phase_time[i],time_kspace,world,nprocs,me,
+                      screen,logfile);
+        time_phases += phase_time[i];
+      }
+
+      time = timer->get_wall(Timer::KSPACE) - time_phases;
+      MPI_Allreduce(&time,&tmp,1,MPI_DOUBLE,MPI_SUM,world);
+      time = tmp/nprocs;
+      if (time < 0.0) time = 0.0;
+      if (me == 0)
+        utils::logmesg(lmp,"Other   |            | {:<10.4g} |            |  "
+                       "     |{:6.2f}\n",time,
+                       (time_kspace > 0.0) ? time/time_kspace*100.0 : 0.0);
+    }
   }
 
 #ifdef LMP_OPENMP
@@ -644,6 +681,37 @@ void mpi_timings(const char *label, Timer *t, enum Timer::ttype tt,
 
 /* ---------------------------------------------------------------------- */
 
+void phase_timings(const char *label, double time, double time_kspace,
+                   MPI_Comm world, const int nprocs, const int me,
+                   FILE *scr, FILE *log)
+{
+  double tmp, time_max, time_min, time_sq;
+
+  MPI_Allreduce(&time,&time_min,1,MPI_DOUBLE,MPI_MIN,world);
+  MPI_Allreduce(&time,&time_max,1,MPI_DOUBLE,MPI_MAX,world);
+  time_sq = time*time;
+  MPI_Allreduce(&time,&tmp,1,MPI_DOUBLE,MPI_SUM,world);
+  time = tmp/nprocs;
+  MPI_Allreduce(&time_sq,&tmp,1,MPI_DOUBLE,MPI_SUM,world);
+  time_sq = tmp/nprocs;
+
+  // % variance from the average as measure of load imbalance
+  if ((time > 0.001) && ((time_sq/time - time) > 1.0e-10))
+    time_sq = sqrt(time_sq/time - time)*100.0;
+  else
+    time_sq = 0.0;
+
+  if (me == 0) {
+    tmp = (time_kspace > 0.0) ? time/time_kspace*100.0 : 0.0;
+    std::string mesg = fmt::format("{:<8s}| {:<10.5g} | {:<10.5g} | {:<10.5g} |{:6.1f} |"
+                                   "{:6.2f}\n",label,time_min,time,time_max,time_sq,tmp);
+    if (scr) fputs(mesg.c_str(),scr);
+    if (log) fputs(mesg.c_str(),log);
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
 #ifdef LMP_OPENMP
 void omp_times(FixOMP *fix, const char *label, enum Timer::ttype which,
                       const int nthreads,FILE *scr, FILE *log)
@@ -87,6 +87,7 @@ KSpace::KSpace(LAMMPS *lmp) : Pointers(lmp)
   mixflag = 0;
 
   splittol = 1.0e-6;
+  num_of_poly_pieces = 1;
 
   maxeatom = maxvatom = 0;
   eatom = nullptr;
@@ -115,6 +115,7 @@ class KSpace : protected Pointers {
 
   double *force_poly_coeff, *energy_poly_coeff, *Fourier_poly_coeff; 
   int num_of_force_poly, num_of_energy_poly, num_of_Fourier_poly;
+  int num_of_poly_pieces;  // pieces of the force and energy polynomials, see PSWFPoly::piecewise()
   double select_c; // select the c value
   double Lambda_0; // select the Lambda_0 value
   
@@ -184,6 +185,11 @@ class KSpace : protected Pointers {
   virtual int timing_1d(int, double &) { return 0; }
   virtual int timing_3d(int, double &) { return 0; }
 
+  // wall times of the phases of compute() during the current run
+  // returns # of phases and sets names and times, 0 if not timed
+
+  virtual int timing_phases(const char *const *&, const double *&) { return 0; }
+
   virtual int modify_param(int, char **) { return 0; }
   virtual double memory_usage() { return 0.0; }
 
@@ -29,6 +29,7 @@
 #include "math_special.h"
 #include "memory.h"
 #include "neighbor.h"
+#include "pswf_poly.h"
 #include "suffix.h"
 #include "update.h"
 
@@ -359,7 +360,7 @@ void Pair::init_list(int /*which*/, NeighList *ptr)
 void Pair::init_tables(double cut_coul, double *cut_respa)
 {
   int masklo,maskhi;
-  double r,grij,expm2,derfc,egamma,fgamma,rsw;
+  double r,grij,expm2,derfc,egamma,fgamma,fpswf,epswf,rsw;
   double qqrd2e = force->qqrd2e;
 
   if (force->kspace == nullptr)
@@ -370,11 +371,7 @@ void Pair::init_tables(double cut_coul, double *cut_respa)
   int num_of_force_poly = force->kspace->num_of_force_poly;
   double *energy_poly_coeff = force->kspace->energy_poly_coeff;
   int num_of_energy_poly = force->kspace->num_of_energy_poly;
-  
-  //printf("num_of_force_poly: %d\n", num_of_force_poly);
-  //printf("num_of_energy_poly: %d\n", num_of_energy_poly);
-  //printf("force_poly_coeff: %f\n", force_poly_coeff[0]);
-  //printf("energy_poly_coeff: %f\n", energy_poly_coeff[0]);
+  int num_of_poly_pieces = force->kspace->num_of_poly_pieces;
 
   double cut_coulsq = cut_coul * cut_coul;
  
@@ -427,6 +424,10 @@ void Pair::init_tables(double cut_coul, double *cut_respa)
       egamma = 1.0 - (r/cut_coul)*force->kspace->gamma(r/cut_coul);
       fgamma = 1.0 + (rsq_lookup.f/cut_coulsq)*
         force->kspace->dgamma(r/cut_coul);
+    } else if (psflag) {
+      fpswf = PSWFPoly::piecewise(force_poly_coeff,num_of_force_poly,num_of_poly_pieces,r/cut_coul);
+      epswf = PSWFPoly::piecewise(energy_poly_coeff,num_of_energy_poly,
+                                  num_of_poly_pieces,r/cut_coul);
     } else {
       grij = g_ewald * r;
       expm2 = exp(-grij*grij);
@@ -439,20 +440,8 @@ void Pair::init_tables(double cut_coul, double *cut_respa)
         ftable[i] = qqrd2e/r * fgamma;
         etable[i] = qqrd2e/r * egamma;
       } else if (psflag) {
-        double force_poly_appx = force_poly_coeff[0];
-        double force_poly_r = 1.0;
-        for(int ii=1; ii<num_of_force_poly; ii++){
-            force_poly_r *= r/cut_coul;
-            force_poly_appx += force_poly_coeff[ii] * force_poly_r;
-        }
-        ftable[i] = qqrd2e * force_poly_appx / r;
-        double energy_poly_appx = energy_poly_coeff[0];
-        double energy_poly_r = 1.0;
-        for(int ii=1; ii<num_of_energy_poly; ii++){
-            energy_poly_r *= r/cut_coul;
-            energy_poly_appx += energy_poly_coeff[ii] * energy_poly_r;
-        }
-        etable[i] = qqrd2e * energy_poly_appx / r;
+        ftable[i] = qqrd2e/r * fpswf;
+        etable[i] = qqrd2e/r * epswf;
       } else {
         ftable[i] = qqrd2e/r * (derfc + MY_ISPI4*grij*expm2);
         etable[i] = qqrd2e/r * derfc;
@@ -465,7 +454,11 @@ void Pair::init_tables(double cut_coul, double *cut_respa)
         ftable[i] = qqrd2e/r * (fgamma - 1.0);
         etable[i] = qqrd2e/r * egamma;
         vtable[i] = qqrd2e/r * fgamma;
-      } else { 
+      } else if (psflag) {
+        ftable[i] = qqrd2e/r * (fpswf - 1.0);
+        etable[i] = qqrd2e/r * epswf;
+        vtable[i] = qqrd2e/r * fpswf;
+      } else {
         ftable[i] = qqrd2e/r * (derfc + MY_ISPI4*grij*expm2 - 1.0);
         etable[i] = qqrd2e/r * derfc;
         vtable[i] = qqrd2e/r * (derfc + MY_ISPI4*grij*expm2);
@@ -477,6 +470,7 @@ void Pair::init_tables(double cut_coul, double *cut_respa)
           ctable[i] = qqrd2e/r * rsw*rsw*(3.0 - 2.0*rsw);
         } else {
           if (msmflag) ftable[i] = qqrd2e/r * fgamma;
+          else if (psflag) ftable[i] = qqrd2e/r * fpswf;
           else ftable[i] = qqrd2e/r * (derfc + MY_ISPI4*grij*expm2);
           ctable[i] = qqrd2e/r;
         }
@@ -539,6 +533,10 @@ void Pair::init_tables(double cut_coul, double *cut_respa)
       egamma = 1.0 - (r/cut_coul)*force->kspace->gamma(r/cut_coul);
       fgamma = 1.0 + (rsq_lookup.f/cut_coulsq)*
         force->kspace->dgamma(r/cut_coul);
+    } else if (psflag) {
+      fpswf = PSWFPoly::piecewise(force_poly_coeff,num_of_force_poly,num_of_poly_pieces,r/cut_coul);
+      epswf = PSWFPoly::piecewise(energy_poly_coeff,num_of_energy_poly,
+                                  num_of_poly_pieces,r/cut_coul);
     } else {
       grij = g_ewald * r;
       expm2 = exp(-grij*grij);
@@ -550,21 +548,9 @@ void Pair::init_tables(double cut_coul, double *cut_respa)
         f_tmp = qqrd2e/r * fgamma;
         e_tmp = qqrd2e/r * egamma;
       } else if (psflag) {
-        double force_poly_appx = force_poly_coeff[0];
-        double force_poly_r = 1.0;
-        for(int ii=1; ii<num_of_force_poly; ii++){
-            force_poly_r *= r/cut_coul;
-            force_poly_appx += force_poly_coeff[ii] * force_poly_r;
-        }
-        f_tmp = qqrd2e * force_poly_appx / r;
-        double energy_poly_appx = energy_poly_coeff[0];
-        double energy_poly_r = 1.0;
-        for(int ii=1; ii<num_of_energy_poly; ii++){
-            energy_poly_r *= r/cut_coul;
-            energy_poly_appx += energy_poly_coeff[ii] * energy_poly_r; 
-        }
-        e_tmp = qqrd2e * energy_poly_appx / r;
-        } else {
+        f_tmp = qqrd2e/r * fpswf;
+        e_tmp = qqrd2e/r * epswf;
+      } else {
         f_tmp = qqrd2e/r * (derfc + MY_ISPI4*grij*expm2);
         e_tmp = qqrd2e/r * derfc;
       }
@@ -575,6 +561,10 @@ void Pair::init_tables(double cut_coul, double *cut_respa)
         f_tmp = qqrd2e/r * (fgamma - 1.0);
         e_tmp = qqrd2e/r * egamma;
         v_tmp = qqrd2e/r * fgamma;
+      } else if (psflag) {
+        f_tmp = qqrd2e/r * (fpswf - 1.0);
+        e_tmp = qqrd2e/r * epswf;
+        v_tmp = qqrd2e/r * fpswf;
       } else {
         f_tmp = qqrd2e/r * (derfc + MY_ISPI4*grij*expm2 - 1.0);
         e_tmp = qqrd2e/r * derfc;
@@ -587,6 +577,7 @@ void Pair::init_tables(double cut_coul, double *cut_respa)
           c_tmp = qqrd2e/r * rsw*rsw*(3.0 - 2.0*rsw);
         } else {
           if (msmflag) f_tmp = qqrd2e/r * fgamma;
+          else if (psflag) f_tmp = qqrd2e/r * fpswf;
           else f_tmp = qqrd2e/r * (derfc + MY_ISPI4*grij*expm2);
           c_tmp = qqrd2e/r;
         }
@@ -0,0 +1,51 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "pswf_poly.h"
+
+using namespace LAMMPS_NS;
+using namespace PSWFPoly;
+
+// dispatch table indexed by the number of coefficients
+
+static const stencil_t stencil_kernels[MAXPOLY + 1] = {
+    nullptr,      &stencil<1>,  &stencil<2>,  &stencil<3>,  &stencil<4>,
+    &stencil<5>,  &stencil<6>,  &stencil<7>,  &stencil<8>,  &stencil<9>,
+    &stencil<10>, &stencil<11>, &stencil<12>, &stencil<13>, &stencil<14>,
+    &stencil<15>, &stencil<16>, &stencil<17>, &stencil<18>, &stencil<19>,
+    &stencil<20>, &stencil<21>, &stencil<22>, &stencil<23>, &stencil<24>};
+
+/* ---------------------------------------------------------------------- */
+
+stencil_t PSWFPoly::select_stencil(int n)
+{
+  if ((n < 1) || (n > MAXPOLY)) return nullptr;
+  return stencil_kernels[n];
+}
+
+/* ---------------------------------------------------------------------- */
+
+static const pieces_stencil_t pieces_stencil_kernels[MAXPOLY + 1] = {
+    nullptr,
+    &stencil_pieces<1>,  &stencil_pieces<2>,  &stencil_pieces<3>,  &stencil_pieces<4>,
+    &stencil_pieces<5>,  &stencil_pieces<6>,  &stencil_pieces<7>,  &stencil_pieces<8>,
+    &stencil_pieces<9>,  &stencil_pieces<10>, &stencil_pieces<11>, &stencil_pieces<12>,
+    &stencil_pieces<13>, &stencil_pieces<14>, &stencil_pieces<15>, &stencil_pieces<16>,
+    &stencil_pieces<17>, &stencil_pieces<18>, &stencil_pieces<19>, &stencil_pieces<20>,
+    &stencil_pieces<21>, &stencil_pieces<22>, &stencil_pieces<23>, &stencil_pieces<24>};
+
+pieces_stencil_t PSWFPoly::select_pieces_stencil(int n)
+{
+  if ((n < 1) || (n > MAXPOLY)) return nullptr;
+  return pieces_stencil_kernels[n];
+}
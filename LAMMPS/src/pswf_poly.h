@@ -0,0 +1,207 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifndef LMP_PSWF_POLY_H
+#define LMP_PSWF_POLY_H
+
+#include "lmpfftsettings.h"
+
+namespace LAMMPS_NS {
+
+namespace PSWFPoly {
+
+  // largest number of coefficients with a compiled kernel
+
+  static constexpr int MAXPOLY = 24;
+
+  /*! Largest power of two strictly below N (N >= 2), used to split Estrin trees */
+
+  template <int N> struct EstrinSplit {
+    static constexpr int value = (N <= 2) ? 1 : 2 * EstrinSplit<(N + 1) / 2>::value;
+  };
+
+  template <> struct EstrinSplit<1> {
+    static constexpr int value = 1;
+  };
+
+  /*! x^H for H a power of two by repeated squaring */
+
+  template <int H> struct PowerOfTwo {
+    static inline double eval(const double x)
+    {
+      const double y = PowerOfTwo<H / 2>::eval(x);
+      return y * y;
+    }
+  };
+
+  template <> struct PowerOfTwo<1> {
+    static inline double eval(const double x) { return x; }
+  };
+
+  /*! Unrolled Estrin scheme for c[0] + c[1]*x + ... + c[N-1]*x^(N-1)
+   *
+   *  The recursion is resolved at compile time and splits the polynomial
+   *  into a low and a high half, p = lo(x) + x^H * hi(x), so the dependency
+   *  chain has logarithmic rather than linear depth in N.  This matters in
+   *  the pair loop, where successive evaluations do not overlap well. */
+
+  template <int N> struct Estrin {
+    static inline double eval(const double *c, const double x)
+    {
+      constexpr int H = EstrinSplit<N>::value;
+      return Estrin<H>::eval(c, x) + PowerOfTwo<H>::eval(x) * Estrin<N - H>::eval(c + H, x);
+    }
+  };
+
+  template <> struct Estrin<1> {
+    static inline double eval(const double *c, const double) { return c[0]; }
+  };
+
+  /*! Unrolled Horner scheme for column k of a 2d coefficient array coeff[power][k]
+   *
+   *  Used for spreading stencils, where the 3*order independent chains of
+   *  one particle already provide enough instruction level parallelism. */
+
+  template <int N> struct HornerColumn {
+    static inline FFT_SCALAR eval(FFT_SCALAR *const *c, const int k, const FFT_SCALAR x)
+    {
+      return c[0][k] + x * HornerColumn<N - 1>::eval(c + 1, k, x);
+    }
+  };
+
+  template <> struct HornerColumn<1> {
+    static inline FFT_SCALAR eval(FFT_SCALAR *const *c, const int k, const FFT_SCALAR)
+    {
+      return c[0][k];
+    }
+  };
+
+  /*! Evaluate a polynomial with 1 <= n <= MAXPOLY coefficients at x
+   *
+   *  The switch compiles to a jump table that is well predicted inside
+   *  a pair loop, and each case is inlined at the call site, so no function
+   *  call (and no register spill) is needed per evaluation. */
+
+  static inline double poly(const double *c, const int n, const double x)
+  {
+    switch (n) {
+      case 1: return Estrin<1>::eval(c, x);
+      case 2: return Estrin<2>::eval(c, x);
+      case 3: return Estrin<3>::eval(c, x);
+      case 4: return Estrin<4>::eval(c, x);
+      case 5: return Estrin<5>::eval(c, x);
+      case 6: return Estrin<6>::eval(c, x);
+      case 7: return Estrin<7>::eval(c, x);
+      case 8: return Estrin<8>::eval(c, x);
+      case 9: return Estrin<9>::eval(c, x);
+      case 10: return Estrin<10>::eval(c, x);
+      case 11: return Estrin<11>::eval(c, x);
+      case 12: return Estrin<12>::eval(c, x);
+      case 13: return Estrin<13>::eval(c, x);
+      case 14: return Estrin<14>::eval(c, x);
+      case 15: return Estrin<15>::eval(c, x);
+      case 16: return Estrin<16>::eval(c, x);
+      case 17: return Estrin<17>::eval(c, x);
+      case 18: return Estrin<18>::eval(c, x);
+      case 19: return Estrin<19>::eval(c, x);
+      case 20: return Estrin<20>::eval(c, x);
+      case 21: return Estrin<21>::eval(c, x);
+      case 22: return Estrin<22>::eval(c, x);
+      case 23: return Estrin<23>::eval(c, x);
+      case 24: return Estrin<24>::eval(c, x);
+    }
+    return 0.0;
+  }
+
+  /*! Evaluate a piecewise polynomial at x in [0,1]
+   *
+   *  Piece s covers [s,s+1]/npieces and is a polynomial with n coefficients
+   *  starting at c + s*n in the local variable t = x*npieces - s in [0,1].
+   *  A single piece is the global polynomial of poly(). */
+
+  static inline double piecewise(const double *c, const int n, const int npieces, const double x)
+  {
+    if (npieces == 1) return poly(c, n, x);
+    const double t = x * npieces;
+    int s = static_cast<int>(t);
+    if (s >= npieces) s = npieces - 1;
+    return poly(c + s * n, n, t - s);
+  }
+
+  /*! Evaluate the per-point polynomials of a spreading stencil
+   *
+   *  r1d[d][k] = sum_l coeff[l][k] * dx_d^l for k = klo..khi and the
+   *  three directions d, with N coefficients per stencil point. */
+
+  template <int N>
+  void stencil(FFT_SCALAR *const *r1d, FFT_SCALAR *const *coeff, int klo, int khi,
+               FFT_SCALAR dx, FFT_SCALAR dy, FFT_SCALAR dz)
+  {
+    for (int k = klo; k <= khi; k++) {
+      r1d[0][k] = HornerColumn<N>::eval(coeff, k, dx);
+      r1d[1][k] = HornerColumn<N>::eval(coeff, k, dy);
+      r1d[2][k] = HornerColumn<N>::eval(coeff, k, dz);
+    }
+  }
+
+  typedef void (*stencil_t)(FFT_SCALAR *const *, FFT_SCALAR *const *, int, int, FFT_SCALAR,
+                            FFT_SCALAR, FFT_SCALAR);
+
+  /*! Return the stencil kernel for n coefficients, or nullptr if n is outside 1..MAXPOLY */
+
+  stencil_t select_stencil(int n);
+
+  /*! Piece of a spreading offset dx in [-1/2,1/2] split into npieces
+   *
+   *  Returns s in 0..npieces-1, clamped so the outer pieces extrapolate,
+   *  and the local variable t = (dx + 1/2)*npieces - s - 1/2. */
+
+  static inline int piece(const int npieces, const FFT_SCALAR dx, FFT_SCALAR &t)
+  {
+    const FFT_SCALAR u = (dx + 0.5) * npieces;
+    int s = static_cast<int>(u);
+    s = (s < 0) ? 0 : ((s >= npieces) ? npieces - 1 : s);
+    t = u - s - 0.5;
+    return s;
+  }
+
+  /*! Evaluate a spreading stencil with piecewise polynomials
+   *
+   *  Like stencil(), but the rows of piece s start at coeff + s*stride,
+   *  and each direction picks its own piece. */
+
+  template <int N>
+  void stencil_pieces(FFT_SCALAR *const *r1d, FFT_SCALAR *const *coeff, int stride, int npieces,
+                      int klo, int khi, FFT_SCALAR dx, FFT_SCALAR dy, FFT_SCALAR dz)
+  {
+    FFT_SCALAR tx, ty, tz;
+    FFT_SCALAR *const *cx = coeff + piece(npieces, dx, tx) * stride;
+    FFT_SCALAR *const *cy = coeff + piece(npieces, dy, ty) * stride;
+    FFT_SCALAR *const *cz = coeff + piece(npieces, dz, tz) * stride;
+    for (int k = klo; k <= khi; k++) {
+      r1d[0][k] = HornerColumn<N>::eval(cx, k, tx);
+      r1d[1][k] = HornerColumn<N>::eval(cy, k, ty);
+      r1d[2][k] = HornerColumn<N>::eval(cz, k, tz);
+    }
+  }
+
+  typedef void (*pieces_stencil_t)(FFT_SCALAR *const *, FFT_SCALAR *const *, int, int, int, int,
+                                   FFT_SCALAR, FFT_SCALAR, FFT_SCALAR);
+
+  /*! Return the piecewise stencil kernel for n coefficients, or nullptr if n is outside 1..MAXPOLY */
+
+  pieces_stencil_t select_pieces_stencil(int n);
+}    // namespace PSWFPoly
+}    // namespace LAMMPS_NS
+
+#endif